@@ -5,11 +5,28 @@ import shutil
 from setuptools import setup, Extension
 from setuptools.command.build_ext import build_ext as _build_ext
 
+# The sort code uses pthreads on POSIX; Windows builds take the serial path.
+thread_libs = [] if platform.system() == "Windows" else ["pthread"]
+
+# Both libraries compile in the shared storage engine (../engine).
+engine_sources = [
+    "../engine/engine.c",
+    "../engine/engine_sort.c",
+    "../engine/engine_sound.c",
+    "../engine/engine_search.c",
+    "../engine/engine_view.c",
+    "../engine/engine_regex.c",
+    "../engine/engine_store.c",
+    "../engine/engine_array.c",
+    "../engine/engine_list.c",
+]
+
 # Define the C extension for Version 1
 ext_v1 = Extension(
     name="contact_v1_lib",
-    sources=["version1/contact_v1_lib.c"],
-    include_dirs=["version1"],
+    sources=["version1/contact_v1_lib.c"] + engine_sources,
+    include_dirs=["version1", "../engine"],
+    libraries=thread_libs,
     # This tells setuptools not to expect PyInit_contact_v1_lib,
     # which is crucial for building a generic DLL/SO for ctypes with MSVC.
     export_symbols=[], 
@@ -20,8 +37,9 @@ ext_v1 = Extension(
 # Define the C extension for Version 2
 ext_v2 = Extension(
     name="contact_v2_lib",
-    sources=["version2/contact_v2_lib.c"],
-    include_dirs=["version2"],
+    sources=["version2/contact_v2_lib.c"] + engine_sources,
+    include_dirs=["version2", "../engine"],
+    libraries=thread_libs,
     export_symbols=[],
     # extra_link_args = ["/DLL"] if platform.system() == "Windows" else []
 )
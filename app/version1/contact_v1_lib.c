@@ -1,8 +1,11 @@
 // contact_v1_lib.c
 #include "contact_v1_lib.h" // Use the API header we defined
+#include "engine.h"         // Shared storage engine (../../engine)
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
+#include <stddef.h>
 
 // Define the struct if not already in the header (it should be)
 // typedef struct {
@@ -12,9 +15,22 @@
 // } ContactRecord;
 
 // Internal static global variables for V1
-static ContactRecord *s_contacts_v1 = NULL;
+// A slot holds its record and the case-folded shadows of its name and email
+// (see Normalized Keys below).
+typedef struct {
+    ContactRecord rec;
+    char name_key[ENGINE_FIELD_BYTES];
+    char email_key[ENGINE_FIELD_BYTES];
+} ContactSlot;
+
+static ContactSlot *s_contacts_v1 = NULL;
 static int s_count_v1 = 0;
 static int s_capacity_v1 = 0; 
+// Deletes leave tombstones: slot i of [0, s_count_v1) is dead while bit i is set.
+// Bits past the allocated words read as live, so appends need no bookkeeping.
+static uint64_t *s_dead_bits_v1 = NULL;
+static int s_dead_words_v1 = 0;
+static int s_dead_v1 = 0; // Tombstones below s_count_v1
 static const char* DEFAULT_CSV_FILE_PATH_V1 = "../data/contacts.csv"; // Default if NULL passed
 
 // Helper to allocate string for Python to consume
@@ -46,61 +62,382 @@ API void lib_v1_free_contact_records(ContactRecord* records, int count) {
     }
 }
 
-// --- Validation Functions (Adapted from your contact1.c) ---
+// --- Validation Functions ---
+// The engine's rules, shared with every front end. Emails only need the
+// structural check here (a@b.co passes); the CLIs also want ".com".
 API int lib_v1_is_valid_name(const char name[]) {
-    if (name == NULL || name[0] == '\0') return 0; // Empty name is invalid
-    for (int i = 0; name[i] != '\0'; i++) {
-        if (!((name[i] >= 'a' && name[i] <= 'z') ||
-              (name[i] >= 'A' && name[i] <= 'Z') ||
-              (name[i] == ' '))) {
-            return 0; // Invalid character
+    return engine_valid_name(name);
+}
+
+API int lib_v1_is_valid_number(const char number[]) {
+    return engine_valid_phone(number);
+}
+
+API int lib_v1_is_valid_email(const char email[]) {
+    return engine_valid_email(email, ENGINE_EMAIL_SHAPE);
+}
+
+// --- Normalized Keys ---
+// Names and emails compare case-insensitively, as in the v2 library. Each slot
+// carries a folded copy of both (engine_fold_key), written whenever the field
+// is, so the email lookup, search, regex and sort stay plain strcmp and byte
+// scans. Phones are digits only and need no shadow.
+static void slot_fold_keys(int i) {
+    engine_fold_key(s_contacts_v1[i].name_key, s_contacts_v1[i].rec.name);
+    engine_fold_key(s_contacts_v1[i].email_key, s_contacts_v1[i].rec.email);
+}
+
+// Whether slot i was deleted (see Tombstone Deletes below).
+static int slot_dead(int i) {
+    return (i >> 6) < s_dead_words_v1 && ((s_dead_bits_v1[i >> 6] >> (i & 63)) & 1);
+}
+
+// --- Record IDs ---
+// Every record gets the next 64-bit id when it is loaded or added. The id lives
+// in the record and is never reused while the library is loaded. The engine's
+// id table maps each live id to its slot, and every path that moves records
+// rewrites it, so id lookups are O(1) whatever the book size. Deleted ids are
+// removed from the table, so it stays proportional to the live records.
+static EngineIds s_ids_v1;        // id -> slot (.idx)
+static uint64_t s_next_id_v1 = 1; // 0 is never an id
+
+// Gives the record in slot i the next id. Returns 0, or -1 if the table could not grow.
+static int id_assign(int i) {
+    EngineKey *e = engine_ids_insert(&s_ids_v1, s_next_id_v1);
+    if (!e) return -1;
+    e->idx = i;
+    s_contacts_v1[i].rec.id = s_next_id_v1++;
+    return 0;
+}
+
+// The record now in slot i was moved there.
+static void id_place(int i) { engine_ids_find(&s_ids_v1, s_contacts_v1[i].rec.id)->idx = i; }
+static void id_release(int i) { engine_ids_remove(&s_ids_v1, s_contacts_v1[i].rec.id); }
+
+// Slot of the record with this id, or -1.
+static int id_slot(uint64_t id) {
+    const EngineKey *e = engine_ids_find(&s_ids_v1, id);
+    return e ? e->idx : -1;
+}
+
+// Forgets every id issued so far; the next ones continue the sequence.
+static void id_reset(void) { engine_ids_free(&s_ids_v1); }
+
+// --- Duplicate-check Bloom Filter ---
+// Adds reject duplicate emails, and in a bulk import nearly every check is
+// negative, which without a built email view means a scan of every slot. A
+// blocked Bloom filter answers "definitely absent" from one cache line: a key
+// sets one bit in each of the eight words of a 64-byte block picked by its
+// hash. Only a "maybe" (a real duplicate, or about one absent key in 10^4)
+// goes on to the exact lookup. Deleted and overwritten emails keep their
+// bits, which only costs false positives. The filter is rebuilt from the live
+// records, sized for twice their number, on load, on compaction, and whenever
+// the keys filed since the last build reach that size. A filter that could not
+// be allocated answers "maybe" to everything until the next rebuild. The
+// filter itself is the engine's EngineBloom. Emails are filed case-folded, so
+// John@x.com and john@x.com hash alike.
+static EngineBloom s_bloom_v1;
+static size_t s_bloom_capacity_v1 = 0; // Keys the filter was sized for (0: not built)
+static size_t s_bloom_filed_v1 = 0;    // Keys filed, stale ones included
+
+static void bloom_add_email(const char *email) {
+    char key[ENGINE_FIELD_BYTES];
+    engine_fold_key(key, email);
+    engine_bloom_add(&s_bloom_v1, key);
+}
+
+static void bloom_drop(void) {
+    engine_bloom_free(&s_bloom_v1);
+    s_bloom_capacity_v1 = s_bloom_filed_v1 = 0;
+}
+
+// Refiles the email of every live record into a filter sized from their number.
+static void bloom_rebuild(void) {
+    bloom_drop();
+    size_t live = 0;
+    for (int i = 0; i < s_count_v1; i++) live += !slot_dead(i);
+    size_t keys = 2 * live;
+    if (keys < ENGINE_BLOOM_MIN_KEYS) keys = ENGINE_BLOOM_MIN_KEYS;
+    engine_bloom_init(&s_bloom_v1, keys); // On failure every lookup says "maybe"
+    s_bloom_capacity_v1 = keys;
+    for (int i = 0; i < s_count_v1; i++) {
+        if (!slot_dead(i)) bloom_add_email(s_contacts_v1[i].rec.email);
+    }
+    s_bloom_filed_v1 = live;
+}
+
+// Files the email of the live record in slot i after it was written.
+static void bloom_note(int i) {
+    if (s_bloom_filed_v1 >= s_bloom_capacity_v1) { bloom_rebuild(); return; }
+    bloom_add_email(s_contacts_v1[i].rec.email);
+    s_bloom_filed_v1++;
+}
+
+// --- Sorted Views ---
+// One engine sorted view (EngineView) per sort field, built the first time that
+// field is sorted and then kept current by add/edit/delete. Sorting the same
+// field again only replays the view (O(n)), with no comparisons at all. Equal
+// keys sit in id order in the view and come out of every sort in id order, so
+// a replay gives exactly what a fresh sort would. Tree nodes hold array
+// indices, and s_view_handles_v1[f][i] points back at record i's node, so an
+// update never has to search among equal keys.
+#define VIEW_FIELDS_V1 3
+
+typedef struct ViewNode {
+    EngineViewNode node; // First, so the engine's node pointers cast to ViewNode
+    int idx;             // Index into s_contacts_v1
+} ViewNode;
+
+#define VIEW_IDX(t) (((ViewNode*)(t))->idx)
+
+static const char *view_node_key(const EngineView *v, const EngineViewNode *x) {
+    return (const char*)&s_contacts_v1[((const ViewNode*)x)->idx] + v->field_off;
+}
+
+static EngineView s_views_v1[VIEW_FIELDS_V1] = {
+    { NULL, offsetof(ContactSlot, name_key), 0, view_node_key },
+    { NULL, offsetof(ContactSlot, rec.phone), 0, view_node_key },
+    { NULL, offsetof(ContactSlot, email_key), 0, view_node_key },
+};
+static EngineViewNode **s_view_handles_v1[VIEW_FIELDS_V1]; // s_capacity_v1 entries each while the view is built
+
+static const char *view_key(const EngineView *v, int idx) {
+    return (const char*)&s_contacts_v1[idx] + v->field_off;
+}
+
+static void view_drop(int f) {
+    if (!s_views_v1[f].built) return;
+    for (int i = 0; i < s_count_v1; i++) free(s_view_handles_v1[f][i]);
+    free(s_view_handles_v1[f]);
+    s_view_handles_v1[f] = NULL;
+    s_views_v1[f].root = NULL;
+    s_views_v1[f].built = 0;
+}
+
+static void view_drop_all(void) {
+    for (int f = 0; f < VIEW_FIELDS_V1; f++) view_drop(f);
+}
+
+// Builds view f for an array that is already in (key, id) order, O(n). On
+// allocation failure the view stays unbuilt.
+static void view_build(int f) {
+    EngineViewNode **handles = (EngineViewNode**)malloc(s_capacity_v1 * sizeof(EngineViewNode*));
+    if (!handles) return;
+    for (int i = 0; i < s_count_v1; i++) {
+        ViewNode *x = (ViewNode*)malloc(sizeof(ViewNode));
+        if (!x) {
+            for (int j = 0; j < i; j++) free(handles[j]);
+            free(handles);
+            return;
         }
+        x->idx = i;
+        x->node.id = s_contacts_v1[i].rec.id;
+        handles[i] = &x->node;
+    }
+    if (engine_view_build(&s_views_v1[f], handles, s_count_v1) != 0) {
+        for (int i = 0; i < s_count_v1; i++) free(handles[i]);
+        free(handles);
+        return;
     }
-    return 1; // Valid
+    s_view_handles_v1[f] = handles;
 }
 
-API int lib_v1_is_valid_number(const char number[]) {
-    if (number == NULL) return 0;
-    int length = strlen(number);
-    if (length != 10) {
-        return 0; // Not 10 digits
-    }
-    for (int i = 0; i < length; i++) {
-        if (number[i] < '0' || number[i] > '9') {
-            return 0; // Non-digit found
+// Record idx lands at its (key, id) position. A view that can't be kept
+// current is dropped and rebuilt on the next sort.
+static void view_insert(int f, int idx) {
+    if (!s_views_v1[f].built) return;
+    s_view_handles_v1[f][idx] = NULL; // A new slot's handle is uninitialized or stale
+    ViewNode *x = (ViewNode*)malloc(sizeof(ViewNode));
+    if (!x) { view_drop(f); return; }
+    x->idx = idx;
+    x->node.id = s_contacts_v1[idx].rec.id;
+    s_view_handles_v1[f][idx] = &x->node;
+    engine_view_insert(&s_views_v1[f], &x->node);
+}
+
+static void view_erase(int f, int idx) {
+    if (!s_views_v1[f].built) return;
+    engine_view_erase(&s_views_v1[f], s_view_handles_v1[f][idx]);
+    free(s_view_handles_v1[f][idx]);
+    s_view_handles_v1[f][idx] = NULL;
+}
+
+// Record `from` moved to slot `to` (compaction slides live records down). The
+// vacated slot is cleared, so view_drop never frees a handle twice.
+static void view_move(int f, int from, int to) {
+    if (!s_views_v1[f].built) return;
+    EngineViewNode *x = s_view_handles_v1[f][from];
+    s_view_handles_v1[f][to] = x;
+    s_view_handles_v1[f][from] = NULL;
+    VIEW_IDX(x) = to;
+}
+
+// Gives every built view's handle table room for new_capacity records.
+static void view_reserve(int new_capacity) {
+    for (int f = 0; f < VIEW_FIELDS_V1; f++) {
+        if (!s_views_v1[f].built) continue;
+        EngineViewNode **grown = (EngineViewNode**)realloc(s_view_handles_v1[f], new_capacity * sizeof(EngineViewNode*));
+        if (grown) s_view_handles_v1[f] = grown;
+        else view_drop(f);
+    }
+}
+
+// Reorders s_contacts_v1 so that slot i holds the record that was at from[i],
+// carrying every built view along. Returns 0, or -1 if memory is short
+// (nothing is changed).
+static int internal_apply_order(const int *from) {
+    ContactSlot *sorted = (ContactSlot*)malloc(s_capacity_v1 * sizeof(ContactSlot));
+    EngineViewNode **handles[VIEW_FIELDS_V1] = { NULL };
+    int ok = sorted != NULL;
+    for (int f = 0; f < VIEW_FIELDS_V1 && ok; f++) {
+        if (!s_views_v1[f].built) continue;
+        handles[f] = (EngineViewNode**)malloc(s_capacity_v1 * sizeof(EngineViewNode*));
+        ok = handles[f] != NULL;
+    }
+    if (!ok) {
+        free(sorted);
+        for (int f = 0; f < VIEW_FIELDS_V1; f++) free(handles[f]);
+        return -1;
+    }
+
+    for (int i = 0; i < s_count_v1; i++) sorted[i] = s_contacts_v1[from[i]];
+    free(s_contacts_v1);
+    s_contacts_v1 = sorted;
+    for (int i = 0; i < s_count_v1; i++) id_place(i);
+    for (int f = 0; f < VIEW_FIELDS_V1; f++) {
+        if (!handles[f]) continue;
+        for (int i = 0; i < s_count_v1; i++) {
+            handles[f][i] = s_view_handles_v1[f][from[i]];
+            VIEW_IDX(handles[f][i]) = i;
         }
+        free(s_view_handles_v1[f]);
+        s_view_handles_v1[f] = handles[f];
     }
-    return 1; // Valid (was 2 in your original, API expects 1 for true)
+    return 0;
 }
 
-API int lib_v1_is_valid_email(const char email[]) {
-    if (email == NULL) return 0;
-    const char *at_symbol = strchr(email, '@');
-    if (at_symbol == NULL || at_symbol == email) return 0; // No '@' or starts with '@'
+// --- Tombstone Deletes ---
+// A delete only sets the slot's dead bit and takes it out of the views, so it
+// no longer moves the tail of the array. Scans and copy-outs skip dead slots.
+// Once tombstones make up a quarter of the slots, one pass slides the live
+// records down over them. A pass over n live records comes at least n/4
+// deletes after the previous one, so the amortized cost per delete is O(1).
+// Dead records keep their bytes, so an array sorted by some field stays
+// sorted.
+#define COMPACT_RATIO_V1 4 // Compact once s_dead_v1 * COMPACT_RATIO_V1 >= s_count_v1
+
+static int internal_live_count(void) { return s_count_v1 - s_dead_v1; }
+
+// Marks slot i dead. Returns 0, or -1 if the bitmap could not grow.
+static int internal_bury(int i) {
+    if ((i >> 6) >= s_dead_words_v1) {
+        int words = (s_capacity_v1 + 63) >> 6;
+        uint64_t *grown = (uint64_t*)realloc(s_dead_bits_v1, words * sizeof(uint64_t));
+        if (!grown) return -1;
+        memset(grown + s_dead_words_v1, 0, (words - s_dead_words_v1) * sizeof(uint64_t));
+        s_dead_bits_v1 = grown;
+        s_dead_words_v1 = words;
+    }
+    s_dead_bits_v1[i >> 6] |= 1ull << (i & 63);
+    s_dead_v1++;
+    return 0;
+}
 
-    const char *dot_symbol = strrchr(at_symbol, '.'); // Last dot after '@'
-    // Dot must exist, not be immediately after '@', and have something after it.
-    if (dot_symbol == NULL || dot_symbol == at_symbol + 1 || dot_symbol[1] == '\0') return 0;
-    
-    // Example: Ensure domain part has at least one char before dot, and TLD has at least two chars
-    // e.g. a@b.co is valid, a@.com is not, a@b.c is not
-    if ((dot_symbol - (at_symbol + 1)) < 1) return 0; // No character between @ and last .
-    if (strlen(dot_symbol + 1) < 2) return 0;         // TLD too short
+static void internal_clear_tombstones(void) {
+    if (s_dead_bits_v1) memset(s_dead_bits_v1, 0, s_dead_words_v1 * sizeof(uint64_t));
+    s_dead_v1 = 0;
+}
 
-    // Further checks can be added (e.g., no consecutive dots, alphanumeric before/after @ and .)
-    return 1; // Simplified: Passes basic structural checks
+// --- Capacity ---
+// s_contacts_v1 grows to twice its capacity, or straight to what is asked when
+// that is more (a load gets an exact fit), so n adds copy O(n) records in total.
+// Once the live records fill only a quarter of it, it shrinks to twice their
+// count: half full, so the next grow or shrink is count/2 operations away. The
+// policy is the engine's (engine_grow_capacity/engine_shrink_capacity), as in
+// the v1 CLI.
+
+// Makes room for need records. Returns 0, or -1 if memory is short (nothing changes).
+static int internal_reserve(int need) {
+    if (need <= s_capacity_v1) return 0;
+    int cap = engine_grow_capacity(s_capacity_v1, need);
+    ContactSlot *grown = (ContactSlot*)realloc(s_contacts_v1, (size_t)cap * sizeof(ContactSlot));
+    if (!grown) return -1;
+    s_contacts_v1 = grown;
+    s_capacity_v1 = cap;
+    view_reserve(cap);
+    return 0;
 }
 
-// Internal helper functions to check for duplicates
-static int internal_check_email_exists(const char email[]) {
+// Gives memory back once the array is mostly empty. Only call it with no
+// tombstones pending; a failed realloc just keeps the larger block.
+static void internal_shrink(void) {
+    int cap = engine_shrink_capacity(s_capacity_v1, s_count_v1);
+    if (cap == s_capacity_v1) return;
+    ContactSlot *smaller = (ContactSlot*)realloc(s_contacts_v1, (size_t)cap * sizeof(ContactSlot));
+    if (!smaller) return;
+    s_contacts_v1 = smaller;
+    s_capacity_v1 = cap;
+    view_reserve(cap);
+}
+
+// Closes every gap left by deletes, in order, carrying the built views along.
+static void internal_compact(void) {
+    if (s_dead_v1 == 0) return;
+    int to = 0;
     for (int i = 0; i < s_count_v1; i++) {
-        if (strcmp(s_contacts_v1[i].email, email) == 0) {
-            return 1; // Found
+        if (slot_dead(i)) continue;
+        if (to != i) {
+            s_contacts_v1[to] = s_contacts_v1[i];
+            id_place(to);
+            for (int f = 0; f < VIEW_FIELDS_V1; f++) view_move(f, i, to);
+        }
+        to++;
+    }
+    s_count_v1 = to;
+    internal_clear_tombstones();
+    internal_shrink();
+    bloom_rebuild();
+}
+
+// Slot of the live record with this email, ignoring case, or -1; an exact
+// match wins over a case variant. Only runs when the Bloom filter says the
+// folded email may be filed, and then seeks the email view when it is built
+// instead of scanning the folded keys.
+static int internal_find_email(const char email[]) {
+    char key[ENGINE_FIELD_BYTES];
+    if (!engine_fold_key(key, email) || !engine_bloom_maybe(&s_bloom_v1, key)) return -1;
+    int folded = -1;
+    const EngineView *v = &s_views_v1[2];
+    if (v->built) {
+        for (EngineViewNode *t = engine_view_lower_bound(v, key); t; t = engine_view_next(t)) {
+            if (strcmp(view_key(v, VIEW_IDX(t)), key) != 0) break;
+            if (strcmp(s_contacts_v1[VIEW_IDX(t)].rec.email, email) == 0) return VIEW_IDX(t);
+            if (folded < 0) folded = VIEW_IDX(t);
         }
+        return folded;
     }
-    return 0; // Not found
+    for (int i = 0; i < s_count_v1; i++) {
+        if (slot_dead(i) || strcmp(s_contacts_v1[i].email_key, key) != 0) continue;
+        if (strcmp(s_contacts_v1[i].rec.email, email) == 0) return i;
+        if (folded < 0) folded = i;
+    }
+    return folded;
 }
 
+// Internal helper functions to check for duplicates
+static int internal_check_email_exists(const char email[]) {
+    return internal_find_email(email) >= 0;
+}
+
+// --- Regex Search ---
+// Patterns compile through the engine (engine_regex_compile, see engine.h for
+// the syntax) into a DFA matched with one table lookup per byte. Matching is
+// case-insensitive, like lib_v1_search_contacts: the pattern is compiled with
+// folding and run against the folded name and email keys. The pattern's longest
+// mandatory literal is used as a strstr prefilter. An anchored literal prefix (^abc...)
+// seeks the field's sorted view instead of scanning, when that view is built; the
+// hits are then put back in array order, so the results are the same either way.
+
 // --- Core API Functions ---
 
 API int lib_v1_initialize(const char* data_file_path) {
@@ -109,9 +446,7 @@ API int lib_v1_initialize(const char* data_file_path) {
     const char* file_to_open = data_file_path ? data_file_path : DEFAULT_CSV_FILE_PATH_V1;
     FILE* pF = fopen(file_to_open, "r");
     if (!pF) { // File doesn't exist or can't be opened
-        s_capacity_v1 = 10; // Default initial capacity
-        s_contacts_v1 = (ContactRecord*)malloc(s_capacity_v1 * sizeof(ContactRecord));
-        if (!s_contacts_v1) return -1; // Malloc failure
+        if (internal_reserve(ENGINE_CAPACITY_MIN) != 0) return -1; // Malloc failure
         s_count_v1 = 0;
         return 0; // Success (initialized empty)
     }
@@ -123,42 +458,55 @@ API int lib_v1_initialize(const char* data_file_path) {
     }
     rewind(pF);
 
-    s_capacity_v1 = lines > 0 ? (lines + 10) : 10; // Allocate for current lines + some buffer
-    s_contacts_v1 = (ContactRecord*)malloc(s_capacity_v1 * sizeof(ContactRecord));
-    if (!s_contacts_v1) {
+    if (internal_reserve(lines > ENGINE_CAPACITY_MIN ? lines : ENGINE_CAPACITY_MIN) != 0) { // Exact fit for the file
         fclose(pF);
         return -2; // Malloc failure
     }
 
     s_count_v1 = 0; // Reset count before loading
-    // Skip header if present - assuming simple CSV without explicit header handling here
-    // If your CSV has a header, you might want to fgets once before the loop.
-    // For simplicity, this fscanf will try to parse from the first line.
-    // Adjust format string if your CSV is different (e.g. spaces around commas)
-    while (s_count_v1 < lines && s_count_v1 < s_capacity_v1 &&
-           fscanf(pF, "%49[^,],%49[^,],%49[^\n]\n",
-                  s_contacts_v1[s_count_v1].name,
-                  s_contacts_v1[s_count_v1].phone,
-                  s_contacts_v1[s_count_v1].email) == 3) {
-        s_contacts_v1[s_count_v1].name[49] = '\0'; // Ensure null termination
-        s_contacts_v1[s_count_v1].phone[49] = '\0';
-        s_contacts_v1[s_count_v1].email[49] = '\0';
+    // No header handling: a header line loads as a record, like any other line
+    // that splits into three fields. Lines that don't split are skipped.
+    EngineRecord r;
+    while (s_count_v1 < lines && fgets(buffer, sizeof(buffer), pF) != NULL) {
+        if (!engine_parse_csv_line(buffer, &r)) continue;
+        memcpy(s_contacts_v1[s_count_v1].rec.name, r.name, sizeof(r.name));
+        memcpy(s_contacts_v1[s_count_v1].rec.phone, r.phone, sizeof(r.phone));
+        memcpy(s_contacts_v1[s_count_v1].rec.email, r.email, sizeof(r.email));
+        slot_fold_keys(s_count_v1);
+        if (id_assign(s_count_v1) != 0) {
+            fclose(pF);
+            lib_v1_cleanup();
+            return -2; // Malloc failure
+        }
         s_count_v1++;
     }
     fclose(pF);
+    bloom_rebuild();
     return 0; // Success
 }
 
 API void lib_v1_cleanup() {
+    view_drop_all();
     if (s_contacts_v1) {
         free(s_contacts_v1);
         s_contacts_v1 = NULL;
     }
     s_count_v1 = 0;
     s_capacity_v1 = 0;
+    free(s_dead_bits_v1);
+    s_dead_bits_v1 = NULL;
+    s_dead_words_v1 = 0;
+    s_dead_v1 = 0;
+    id_reset();
+    bloom_drop();
 }
 
 API char* lib_v1_add_contact(const char* name, const char* phone, const char* email) {
+    return lib_v1_add_contact_id(name, phone, email, NULL);
+}
+
+API char* lib_v1_add_contact_id(const char* name, const char* phone, const char* email, uint64_t* out_id) {
+    if (out_id) *out_id = 0;
     if (!lib_v1_is_valid_name(name)) return allocate_and_copy_string("Error: Invalid name format.");
     if (!lib_v1_is_valid_number(phone)) return allocate_and_copy_string("Error: Invalid phone number (must be 10 digits).");
     if (!lib_v1_is_valid_email(email)) return allocate_and_copy_string("Error: Invalid email format.");
@@ -166,18 +514,17 @@ API char* lib_v1_add_contact(const char* name, const char* phone, const char* em
     if (internal_check_email_exists(email)) return allocate_and_copy_string("Error: Email already exists.");
     // Add other uniqueness checks if needed (e.g., for phone or name)
 
-    if (s_count_v1 >= s_capacity_v1) {
-        int new_capacity = s_capacity_v1 > 0 ? s_capacity_v1 * 2 : 10;
-        ContactRecord* temp = (ContactRecord*)realloc(s_contacts_v1, new_capacity * sizeof(ContactRecord));
-        if (!temp) return allocate_and_copy_string("Error: Memory reallocation failed.");
-        s_contacts_v1 = temp;
-        s_capacity_v1 = new_capacity;
-    }
+    if (internal_reserve(s_count_v1 + 1) != 0) return allocate_and_copy_string("Error: Memory reallocation failed.");
 
-    strncpy(s_contacts_v1[s_count_v1].name, name, 49); s_contacts_v1[s_count_v1].name[49] = '\0';
-    strncpy(s_contacts_v1[s_count_v1].phone, phone, 49); s_contacts_v1[s_count_v1].phone[49] = '\0';
-    strncpy(s_contacts_v1[s_count_v1].email, email, 49); s_contacts_v1[s_count_v1].email[49] = '\0';
+    strncpy(s_contacts_v1[s_count_v1].rec.name, name, 49); s_contacts_v1[s_count_v1].rec.name[49] = '\0';
+    strncpy(s_contacts_v1[s_count_v1].rec.phone, phone, 49); s_contacts_v1[s_count_v1].rec.phone[49] = '\0';
+    strncpy(s_contacts_v1[s_count_v1].rec.email, email, 49); s_contacts_v1[s_count_v1].rec.email[49] = '\0';
+    slot_fold_keys(s_count_v1);
+    if (id_assign(s_count_v1) != 0) return allocate_and_copy_string("Error: Memory reallocation failed.");
+    if (out_id) *out_id = s_contacts_v1[s_count_v1].rec.id;
     s_count_v1++;
+    for (int f = 0; f < VIEW_FIELDS_V1; f++) view_insert(f, s_count_v1 - 1);
+    bloom_note(s_count_v1 - 1);
 
     return allocate_and_copy_string("Contact added successfully.");
 }
@@ -185,14 +532,18 @@ API char* lib_v1_add_contact(const char* name, const char* phone, const char* em
 API ContactRecord* lib_v1_get_all_contacts(int* out_count) {
     if (!out_count) return NULL;
     *out_count = 0;
-    if (s_count_v1 == 0 || s_contacts_v1 == NULL) return NULL;
+    int live = internal_live_count();
+    if (live == 0 || s_contacts_v1 == NULL) return NULL;
 
-    ContactRecord* records_copy = (ContactRecord*)malloc(s_count_v1 * sizeof(ContactRecord));
+    ContactRecord* records_copy = (ContactRecord*)malloc(live * sizeof(ContactRecord));
     if (!records_copy) return NULL; // Malloc failure
 
-    memcpy(records_copy, s_contacts_v1, s_count_v1 * sizeof(ContactRecord));
+    int n = 0;
+    for (int i = 0; i < s_count_v1; i++) {
+        if (!slot_dead(i)) records_copy[n++] = s_contacts_v1[i].rec;
+    }
     
-    *out_count = s_count_v1;
+    *out_count = live;
     return records_copy;
 }
 
@@ -202,27 +553,30 @@ API ContactRecord* lib_v1_search_contacts(const char* query, int search_type, in
         return NULL;
     }
     *out_count = 0;
-    if (s_count_v1 == 0) return NULL;
+    if (internal_live_count() == 0) return NULL;
+    char key[ENGINE_FIELD_BYTES];
+    if (!engine_fold_key(key, query)) return NULL; // Longer than any field
 
-    ContactRecord* matches = (ContactRecord*)malloc(s_count_v1 * sizeof(ContactRecord)); // Max possible matches
+    ContactRecord* matches = (ContactRecord*)malloc(internal_live_count() * sizeof(ContactRecord)); // Max possible matches
     if (!matches) return NULL;
 
     int current_match_count = 0;
     for (int i = 0; i < s_count_v1; i++) {
+        if (slot_dead(i)) continue;
         int found = 0;
         switch (search_type) {
-            case 1: // Name
-                if (strstr(s_contacts_v1[i].name, query)) found = 1;
+            case 1: // Name, ignoring case
+                if (strstr(s_contacts_v1[i].name_key, key)) found = 1;
                 break;
             case 2: // Phone
-                if (strstr(s_contacts_v1[i].phone, query)) found = 1;
+                if (strstr(s_contacts_v1[i].rec.phone, key)) found = 1;
                 break;
-            case 3: // Email
-                if (strstr(s_contacts_v1[i].email, query)) found = 1;
+            case 3: // Email, ignoring case
+                if (strstr(s_contacts_v1[i].email_key, key)) found = 1;
                 break;
         }
         if (found) {
-            memcpy(&matches[current_match_count++], &s_contacts_v1[i], sizeof(ContactRecord));
+            matches[current_match_count++] = s_contacts_v1[i].rec;
         }
     }
 
@@ -231,7 +585,7 @@ API ContactRecord* lib_v1_search_contacts(const char* query, int search_type, in
         return NULL;
     }
 
-    // Optional: Realloc to actual size if significantly smaller than s_count_v1
+    // Optional: Realloc to actual size if significantly smaller than the live count
     ContactRecord* final_matches = (ContactRecord*)realloc(matches, current_match_count * sizeof(ContactRecord));
      if (!final_matches && current_match_count > 0) { // realloc failed but matches had content
         *out_count = current_match_count; // return original matches buffer
@@ -244,92 +598,343 @@ API ContactRecord* lib_v1_search_contacts(const char* query, int search_type, in
 }
 
 
-API char* lib_v1_edit_contact(const char* old_email_id, const char* new_name, const char* new_phone, const char* new_email) {
-    if (!lib_v1_is_valid_name(new_name)) return allocate_and_copy_string("Error: Invalid new name format.");
-    if (!lib_v1_is_valid_number(new_phone)) return allocate_and_copy_string("Error: Invalid new phone number.");
-    if (!lib_v1_is_valid_email(new_email)) return allocate_and_copy_string("Error: Invalid new email format.");
+API ContactRecord* lib_v1_search_contacts_regex(const char* pattern, int search_type, int* out_count, char** out_error) {
+    if (out_error) *out_error = NULL;
+    if (!out_count) return NULL;
+    *out_count = 0;
+    if (!pattern || search_type < 1 || search_type > VIEW_FIELDS_V1) return NULL;
+    const char *error;
+    EngineRegex *re = engine_regex_compile(pattern, 1, &error);
+    if (!re) {
+        if (out_error) *out_error = allocate_and_copy_string(error);
+        return NULL;
+    }
 
-    int found_idx = -1;
-    for (int i = 0; i < s_count_v1; i++) {
-        if (strcmp(s_contacts_v1[i].email, old_email_id) == 0) {
-            found_idx = i;
-            break;
+    const EngineView *v = &s_views_v1[search_type - 1];
+    int live = internal_live_count();
+    ContactRecord* matches = live ? (ContactRecord*)malloc(live * sizeof(ContactRecord)) : NULL;
+    int current_match_count = 0;
+    if (matches && re->prefix[0] && v->built) { // Only the keys starting with the anchored prefix
+        EngineKey *hits = (EngineKey*)malloc(live * sizeof(EngineKey));
+        EngineKey *tmp = (EngineKey*)malloc(live * sizeof(EngineKey));
+        if (hits && tmp) {
+            size_t prefix_len = strlen(re->prefix);
+            int n = 0;
+            for (EngineViewNode *t = engine_view_lower_bound(v, re->prefix); t; t = engine_view_next(t)) {
+                const char *field = view_key(v, VIEW_IDX(t));
+                if (strncmp(field, re->prefix, prefix_len) != 0) break;
+                if (engine_regex_match(re, field)) hits[n++].key = (uint64_t)VIEW_IDX(t);
+            }
+            EngineKey *order = engine_radix_sort_keys(hits, tmp, n, 32); // Back in array order
+            for (int i = 0; i < n; i++) matches[current_match_count++] = s_contacts_v1[order[i].key].rec;
+        }
+        free(hits); free(tmp);
+    } else if (matches) {
+        for (int i = 0; i < s_count_v1; i++) {
+            if (slot_dead(i)) continue;
+            const char *field = view_key(v, i);
+            if ((!re->literal[0] || strstr(field, re->literal)) && engine_regex_match(re, field))
+                matches[current_match_count++] = s_contacts_v1[i].rec;
         }
     }
+    engine_regex_free(re);
 
-    if (found_idx == -1) return allocate_and_copy_string("Error: Contact to edit not found (by old email).");
+    if (current_match_count == 0) {
+        free(matches);
+        return NULL;
+    }
+    ContactRecord* final_matches = (ContactRecord*)realloc(matches, current_match_count * sizeof(ContactRecord));
+    *out_count = current_match_count;
+    return final_matches ? final_matches : matches;
+}
 
-    // Check if new email already exists (if it's different from the old one and belongs to another contact)
-    if (strcmp(old_email_id, new_email) != 0 && internal_check_email_exists(new_email)) {
+
+// Writes validated fields into the live record in slot found_idx.
+static char* internal_edit(int found_idx, const char* new_name, const char* new_phone, const char* new_email) {
+    ContactSlot *target = &s_contacts_v1[found_idx];
+    // Check if new email already exists for another contact (a case change of its own email is fine)
+    int owner = internal_find_email(new_email);
+    if (owner >= 0 && owner != found_idx) {
         return allocate_and_copy_string("Error: New email already exists for another contact.");
     }
     // Add similar checks for new_name and new_phone if they need to be unique and changed
 
-    strncpy(s_contacts_v1[found_idx].name, new_name, 49); s_contacts_v1[found_idx].name[49] = '\0';
-    strncpy(s_contacts_v1[found_idx].phone, new_phone, 49); s_contacts_v1[found_idx].phone[49] = '\0';
-    strncpy(s_contacts_v1[found_idx].email, new_email, 49); s_contacts_v1[found_idx].email[49] = '\0';
+    char name_key[ENGINE_FIELD_BYTES], email_key[ENGINE_FIELD_BYTES];
+    engine_fold_key(name_key, new_name);
+    engine_fold_key(email_key, new_email);
+    int changed[VIEW_FIELDS_V1] = { strcmp(target->name_key, name_key) != 0, strcmp(target->rec.phone, new_phone) != 0,
+                                    strcmp(target->email_key, email_key) != 0 };
+    for (int f = 0; f < VIEW_FIELDS_V1; f++) if (changed[f]) view_erase(f, found_idx);
+    strncpy(s_contacts_v1[found_idx].rec.name, new_name, 49); s_contacts_v1[found_idx].rec.name[49] = '\0';
+    strncpy(s_contacts_v1[found_idx].rec.phone, new_phone, 49); s_contacts_v1[found_idx].rec.phone[49] = '\0';
+    strncpy(s_contacts_v1[found_idx].rec.email, new_email, 49); s_contacts_v1[found_idx].rec.email[49] = '\0';
+    slot_fold_keys(found_idx);
+    for (int f = 0; f < VIEW_FIELDS_V1; f++) if (changed[f]) view_insert(f, found_idx);
+    if (changed[2]) bloom_note(found_idx);
     
     return allocate_and_copy_string("Contact updated successfully.");
 }
 
-API int lib_v1_delete_contact_by_email(const char* email) {
-    int found_idx = -1;
-    for (int i = 0; i < s_count_v1; i++) {
-        if (strcmp(s_contacts_v1[i].email, email) == 0) {
-            found_idx = i;
-            break;
+API char* lib_v1_edit_contact(const char* old_email_id, const char* new_name, const char* new_phone, const char* new_email) {
+    if (!lib_v1_is_valid_name(new_name)) return allocate_and_copy_string("Error: Invalid new name format.");
+    if (!lib_v1_is_valid_number(new_phone)) return allocate_and_copy_string("Error: Invalid new phone number.");
+    if (!lib_v1_is_valid_email(new_email)) return allocate_and_copy_string("Error: Invalid new email format.");
+
+    int found_idx = internal_find_email(old_email_id);
+    if (found_idx == -1) return allocate_and_copy_string("Error: Contact to edit not found (by old email).");
+    return internal_edit(found_idx, new_name, new_phone, new_email);
+}
+
+API char* lib_v1_edit_contact_by_id(uint64_t id, const char* new_name, const char* new_phone, const char* new_email) {
+    if (!lib_v1_is_valid_name(new_name)) return allocate_and_copy_string("Error: Invalid new name format.");
+    if (!lib_v1_is_valid_number(new_phone)) return allocate_and_copy_string("Error: Invalid new phone number.");
+    if (!lib_v1_is_valid_email(new_email)) return allocate_and_copy_string("Error: Invalid new email format.");
+
+    int found_idx = id_slot(id);
+    if (found_idx == -1) return allocate_and_copy_string("Error: Contact to edit not found (by id).");
+    return internal_edit(found_idx, new_name, new_phone, new_email);
+}
+
+API int lib_v1_get_contact_by_id(uint64_t id, ContactRecord* out) {
+    int found_idx = id_slot(id);
+    if (found_idx == -1 || !out) return -1;
+    *out = s_contacts_v1[found_idx].rec;
+    return 0;
+}
+
+// Deletes the live record in slot found_idx.
+static int internal_delete(int found_idx) {
+    id_release(found_idx);
+    if (internal_bury(found_idx) != 0) { // The bitmap could not grow, so slots from found_idx on are all live: shift them down
+        for (int f = 0; f < VIEW_FIELDS_V1; f++) view_erase(f, found_idx);
+        for (int i = found_idx; i < s_count_v1 - 1; i++) {
+            s_contacts_v1[i] = s_contacts_v1[i + 1];
+            id_place(i);
+            for (int f = 0; f < VIEW_FIELDS_V1; f++) view_move(f, i + 1, i);
         }
+        s_count_v1--;
+        return 0;
     }
+    for (int f = 0; f < VIEW_FIELDS_V1; f++) view_erase(f, found_idx);
+    if (s_dead_v1 * COMPACT_RATIO_V1 >= s_count_v1) internal_compact();
+    return 0; // Success
+}
 
+API int lib_v1_delete_contact_by_email(const char* email) {
+    int found_idx = internal_find_email(email);
     if (found_idx == -1) return -1; // Not found
+    return internal_delete(found_idx);
+}
+
+API int lib_v1_delete_contact_by_id(uint64_t id) {
+    int found_idx = id_slot(id);
+    if (found_idx == -1) return -1; // Not found
+    return internal_delete(found_idx);
+}
 
-    // Shift elements
-    for (int i = found_idx; i < s_count_v1 - 1; i++) {
-        s_contacts_v1[i] = s_contacts_v1[i + 1];
+// Bulk writes by predicate: the pattern is compiled once and tested on every
+// live record in a single pass. Delete slides the survivors down in that same
+// pass, closing older tombstones too, so k victims cost O(n) in all.
+static EngineRegex *bulk_compile(const char* pattern, int search_type, char** out_error) {
+    if (out_error) *out_error = NULL;
+    if (!pattern || search_type < 1 || search_type > VIEW_FIELDS_V1) return NULL;
+    const char *error;
+    EngineRegex *re = engine_regex_compile(pattern, 1, &error);
+    if (!re && out_error) *out_error = allocate_and_copy_string(error);
+    return re;
+}
+
+static int bulk_match(const EngineRegex *re, const char *field) {
+    return (!re->literal[0] || strstr(field, re->literal)) && engine_regex_match(re, field);
+}
+
+API int lib_v1_delete_contacts_regex(const char* pattern, int search_type, char** out_error) {
+    EngineRegex *re = bulk_compile(pattern, search_type, out_error);
+    if (!re) return -1;
+    const EngineView *v = &s_views_v1[search_type - 1];
+    int to = 0, deleted = 0;
+    for (int i = 0; i < s_count_v1; i++) {
+        if (slot_dead(i)) continue;
+        if (bulk_match(re, view_key(v, i))) {
+            for (int f = 0; f < VIEW_FIELDS_V1; f++) view_erase(f, i);
+            id_release(i);
+            deleted++;
+            continue;
+        }
+        if (to != i) {
+            s_contacts_v1[to] = s_contacts_v1[i];
+            id_place(to);
+            for (int f = 0; f < VIEW_FIELDS_V1; f++) view_move(f, i, to);
+        }
+        to++;
     }
-    s_count_v1--;
-    // Optional: Clear the last (now unused) element if desired, though not strictly necessary
-    // memset(&s_contacts_v1[s_count_v1], 0, sizeof(ContactRecord));
-    return 0; // Success
+    s_count_v1 = to;
+    internal_clear_tombstones();
+    internal_shrink();
+    if (deleted) bloom_rebuild();
+    engine_regex_free(re);
+    return deleted;
+}
+
+API int lib_v1_update_contacts_regex(const char* pattern, int search_type, const char* new_name, const char* new_phone, char** out_error) {
+    if (out_error) *out_error = NULL;
+    if (!new_name && !new_phone) return -1;
+    if (new_name && !lib_v1_is_valid_name(new_name)) return -2;
+    if (new_phone && !lib_v1_is_valid_number(new_phone)) return -3;
+    EngineRegex *re = bulk_compile(pattern, search_type, out_error);
+    if (!re) return -1;
+    const EngineView *v = &s_views_v1[search_type - 1];
+    char name_key[ENGINE_FIELD_BYTES];
+    if (new_name) engine_fold_key(name_key, new_name);
+    int updated = 0;
+    for (int i = 0; i < s_count_v1; i++) {
+        if (slot_dead(i) || !bulk_match(re, view_key(v, i))) continue;
+        ContactRecord *target = &s_contacts_v1[i].rec;
+        int changed[VIEW_FIELDS_V1] = { new_name && strcmp(s_contacts_v1[i].name_key, name_key) != 0,
+                                        new_phone && strncmp(target->phone, new_phone, 49) != 0, 0 };
+        for (int f = 0; f < VIEW_FIELDS_V1; f++) if (changed[f]) view_erase(f, i);
+        if (new_name) { strncpy(target->name, new_name, 49); target->name[49] = '\0'; }
+        if (new_phone) { strncpy(target->phone, new_phone, 49); target->phone[49] = '\0'; }
+        slot_fold_keys(i);
+        for (int f = 0; f < VIEW_FIELDS_V1; f++) if (changed[f]) view_insert(f, i);
+        updated++;
+    }
+    engine_regex_free(re);
+    return updated;
 }
 
 API int lib_v1_delete_all_contacts() {
+    view_drop_all();
     s_count_v1 = 0;
-    // The allocated memory for s_contacts_v1 is kept for potential re-use or freed by lib_v1_cleanup.
-    // If you want to free immediately and realloc on next add:
-    // if(s_contacts_v1) free(s_contacts_v1); s_contacts_v1 = NULL; s_capacity_v1 = 0;
+    internal_clear_tombstones();
+    id_reset();
+    bloom_drop();
+    internal_shrink(); // Back to ENGINE_CAPACITY_MIN records
     return 0; // Success
 }
 
-// Bubble Sort implementations
-static void internal_bubble_sort(int sort_type) {
-    ContactRecord temp;
-    for (int i = 0; i < s_count_v1 - 1; i++) {
-        for (int j = 0; j < s_count_v1 - i - 1; j++) {
-            int comparison = 0;
-            if (sort_type == 1)      // Name
-                comparison = strcmp(s_contacts_v1[j].name, s_contacts_v1[j + 1].name);
-            else if (sort_type == 2) // Phone
-                comparison = strcmp(s_contacts_v1[j].phone, s_contacts_v1[j + 1].phone);
-            else if (sort_type == 3) // Email
-                comparison = strcmp(s_contacts_v1[j].email, s_contacts_v1[j + 1].email);
-            
-            if (comparison > 0) {
-                temp = s_contacts_v1[j];
-                s_contacts_v1[j] = s_contacts_v1[j + 1];
-                s_contacts_v1[j + 1] = temp;
-            }
+// --- Index Sort ---
+// Sorting moves 16-byte (prefix, index) keys instead of whole slots; the
+// records are permuted once at the end. The keys go in in id order, so equal
+// keys come out in id order, as in the sorted views, whatever order earlier
+// sorts left the array in.
+// Parallel sort settings, see lib_v1_set_sort_parallelism().
+static int s_sort_parallel_threshold_v1 = ENGINE_SORT_PARALLEL_THRESHOLD;
+static int s_sort_threads_v1 = 0; // 0 = one per online CPU
+
+// Live slots in id order (see engine_sort_ids), *n of them. Returns a malloc'd
+// array, or NULL if memory is short.
+static int *internal_id_order(int *n) {
+    int live = internal_live_count();
+    EngineKey *keys = (EngineKey*)malloc((live + 1) * sizeof(EngineKey));
+    EngineKey *tmp = (EngineKey*)malloc((live + 1) * sizeof(EngineKey));
+    int *slots = (int*)malloc((live + 1) * sizeof(int));
+    *n = 0;
+    if (keys && tmp && slots) {
+        for (int i = 0; i < s_count_v1; i++) {
+            if (slot_dead(i)) continue;
+            keys[*n].key = s_contacts_v1[i].rec.id;
+            keys[(*n)++].idx = i;
         }
+        EngineKey *order = engine_sort_ids(keys, tmp, *n);
+        for (int i = 0; i < *n; i++) slots[i] = order[i].idx;
+    } else {
+        free(slots);
+        slots = NULL;
+    }
+    free(keys); free(tmp);
+    return slots;
+}
+
+// Sorts through the engine's string sort (packed LSD radix for phones, else MSD
+// radix, on the work-stealing pool past the parallel threshold) and permutes
+// the records once. Call it on a dense array. Returns 0 on success, -1 on
+// allocation failure (contacts are left untouched).
+static int internal_index_sort(size_t field_off) {
+    int n = 0;
+    int *by_id = internal_id_order(&n);
+    const char **strs = (const char**)malloc(s_count_v1 * sizeof(const char*));
+    EngineKey *keys = (EngineKey*)malloc(s_count_v1 * sizeof(EngineKey));
+    EngineKey *tmp = (EngineKey*)malloc(s_count_v1 * sizeof(EngineKey));
+    int *from = (int*)malloc(s_count_v1 * sizeof(int));
+    int result = -1;
+    if (by_id && strs && keys && tmp && from) {
+        for (int i = 0; i < n; i++) strs[i] = (const char*)&s_contacts_v1[by_id[i]] + field_off;
+        int threads = engine_sort_threads(n, s_sort_parallel_threshold_v1, s_sort_threads_v1);
+        EngineKey *order = engine_sort_strings(keys, tmp, strs, n, threads);
+        for (int i = 0; i < n; i++) from[i] = by_id[order[i].idx];
+        result = internal_apply_order(from);
     }
+    free(by_id); free(strs); free(keys); free(tmp); free(from);
+    return result;
 }
 
 API int lib_v1_sort_contacts(int sort_type) {
     if (sort_type < 1 || sort_type > 3) return -1; // Invalid sort type
+    internal_compact(); // The sorts below work on a dense array
     if (s_count_v1 < 2) return 0; // No need to sort
-    internal_bubble_sort(sort_type);
+
+    int f = sort_type - 1;
+    if (s_views_v1[f].built) { // Already maintained: replay the view
+        int *from = (int*)malloc(s_count_v1 * sizeof(int));
+        if (!from) return -2;
+        int i = 0;
+        for (EngineViewNode *t = engine_view_first(&s_views_v1[f]); t; t = engine_view_next(t)) from[i++] = VIEW_IDX(t);
+        int result = internal_apply_order(from);
+        free(from);
+        return result == 0 ? 0 : -2;
+    }
+
+    if (internal_index_sort(s_views_v1[f].field_off) != 0) return -2; // Allocation failure
+    view_build(f);
     return 0; // Success
 }
 
+// --- Sorted Pages ---
+// A page of the order lib_v1_sort_contacts(field) would produce, without sorting
+// or moving any records. A built view is read directly (O(log n + limit));
+// otherwise engine_sort_page() orders just the page (O(n + limit log limit)).
+API ContactRecord* lib_v1_get_sorted_page(int field, int offset, int limit, int* out_count) {
+    if (!out_count) return NULL;
+    *out_count = 0;
+    int live = internal_live_count();
+    if (field < 1 || field > VIEW_FIELDS_V1 || offset < 0 || limit <= 0 || offset >= live) return NULL;
+    if (limit > live - offset) limit = live - offset;
+
+    ContactRecord* page = (ContactRecord*)malloc(limit * sizeof(ContactRecord));
+    if (!page) return NULL;
+
+    const EngineView *v = &s_views_v1[field - 1];
+    if (v->built) {
+        EngineViewNode *t = engine_view_select(v, offset);
+        for (int i = 0; i < limit; i++, t = engine_view_next(t)) page[i] = s_contacts_v1[VIEW_IDX(t)].rec;
+    } else {
+        int n = 0;
+        int *by_id = internal_id_order(&n); // Ties in id order, as lib_v1_sort_contacts gives them
+        const char **strs = (const char**)malloc(live * sizeof(const char*));
+        EngineKey *keys = (EngineKey*)malloc(live * sizeof(EngineKey));
+        if (!by_id || !strs || !keys || n < offset + limit) { // Or the live count is out of step
+            free(by_id); free(strs); free(keys); free(page);
+            return NULL;
+        }
+        for (int i = 0; i < n; i++) strs[i] = (const char*)&s_contacts_v1[by_id[i]] + v->field_off;
+        engine_sort_page(keys, strs, n, offset, limit);
+        for (int i = 0; i < limit; i++)
+            page[i] = ((const ContactSlot*)(strs[keys[offset + i].idx] - v->field_off))->rec;
+        free(by_id);
+        free(strs);
+        free(keys);
+    }
+
+    *out_count = limit;
+    return page;
+}
+
+API void lib_v1_set_sort_parallelism(int threshold, int threads) {
+    s_sort_parallel_threshold_v1 = threshold > 0 ? threshold : ENGINE_SORT_PARALLEL_THRESHOLD;
+    s_sort_threads_v1 = threads > 0 ? threads : 0;
+}
+
 API int lib_v1_save_contacts(const char* data_file_path) {
     const char* file_to_save = data_file_path ? data_file_path : DEFAULT_CSV_FILE_PATH_V1;
     FILE* pF = fopen(file_to_save, "w");
@@ -339,10 +944,11 @@ API int lib_v1_save_contacts(const char* data_file_path) {
     // fprintf(pF, "Name,Phone,Email\n"); 
 
     for (int i = 0; i < s_count_v1; i++) {
+        if (slot_dead(i)) continue;
         if (fprintf(pF, "%s,%s,%s\n",
-                    s_contacts_v1[i].name,
-                    s_contacts_v1[i].phone,
-                    s_contacts_v1[i].email) < 0) {
+                    s_contacts_v1[i].rec.name,
+                    s_contacts_v1[i].rec.phone,
+                    s_contacts_v1[i].rec.email) < 0) {
             fclose(pF);
             return -2; // Error writing to file
         }
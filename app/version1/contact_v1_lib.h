@@ -8,11 +8,14 @@
     #define API // For Linux/macOS SO
 #endif
 
+#include <stdint.h>
+
 // Structure to pass contact data between C and Python
 typedef struct {
     char name[50];
     char phone[50];
     char email[50];
+    uint64_t id; // Stable record id (see lib_v1_get_contact_by_id); never reused while the library is loaded
 } ContactRecord;
 
 // Initialization and Cleanup
@@ -22,17 +25,32 @@ API void lib_v1_cleanup();                            // Frees allocated memory
 // Core Operations (returning char* for status messages. Caller must free with lib_v1_free_string)
 API char* lib_v1_add_contact(const char* name, const char* phone, const char* email);
 API char* lib_v1_edit_contact(const char* old_email_id, const char* new_name, const char* new_phone, const char* new_email);
+API char* lib_v1_add_contact_id(const char* name, const char* phone, const char* email, uint64_t* out_id); // As add; *out_id gets the new record's id (0 on error)
+
+// By record id, O(1) whatever the book size: get returns 0 and fills *out, or -1 if there is no such record;
+// edit returns a status message like lib_v1_edit_contact; delete returns 0, or -1 if not found.
+API int lib_v1_get_contact_by_id(uint64_t id, ContactRecord* out);
+API char* lib_v1_edit_contact_by_id(uint64_t id, const char* new_name, const char* new_phone, const char* new_email);
+API int lib_v1_delete_contact_by_id(uint64_t id);
 
 // Data Retrieval (caller must free records with lib_v1_free_contact_records)
 API ContactRecord* lib_v1_get_all_contacts(int* out_count);
-API ContactRecord* lib_v1_search_contacts(const char* query, int search_type, int* out_count); // search_type: 1=name, 2=phone, 3=email
+API ContactRecord* lib_v1_search_contacts(const char* query, int search_type, int* out_count); // search_type: 1=name, 2=phone, 3=email; case-insensitive
+API ContactRecord* lib_v1_search_contacts_regex(const char* pattern, int search_type, int* out_count, char** out_error); // Case-insensitive. Bad pattern: NULL, *out_error set (free with lib_v1_free_string)
 
 // Deletion (returning int for status: 0 for success, specific error codes or -1 for failure)
 API int lib_v1_delete_contact_by_email(const char* email);
 API int lib_v1_delete_all_contacts();
+// Delete, or set name and/or phone (NULL: keep) on, every contact whose field (1=name, 2=phone, 3=email)
+// matches the regex, in one pass. Return the number affected; -1 bad arguments or pattern (*out_error
+// set as for lib_v1_search_contacts_regex), -2 invalid name, -3 invalid phone.
+API int lib_v1_delete_contacts_regex(const char* pattern, int search_type, char** out_error);
+API int lib_v1_update_contacts_regex(const char* pattern, int search_type, const char* new_name, const char* new_phone, char** out_error);
 
 // Sorting (returning int for status)
-API int lib_v1_sort_contacts(int sort_type); // sort_type: 1=name, 2=phone, 3=email
+API int lib_v1_sort_contacts(int sort_type); // sort_type: 1=name, 2=phone, 3=email; names and emails ignore case
+API ContactRecord* lib_v1_get_sorted_page(int field, int offset, int limit, int* out_count); // Rows [offset, offset+limit) in field order; free with lib_v1_free_contact_records
+API void lib_v1_set_sort_parallelism(int threshold, int threads); // Sorts of >= threshold records use `threads` workers (<= 0: defaults)
 
 // Persistence (returning int for status)
 API int lib_v1_save_contacts(const char* data_file_path);
@@ -1,10 +1,13 @@
 // contact_v2_lib.c
 #include "contact_v2_lib.h" // Your new API header
+#include "engine.h"         // Shared storage engine (../../engine)
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>   
 #include <stdbool.h> 
+#include <stdint.h>
+#include <stddef.h>
 
 // Internal static global variables for V2 (linked list)
 static Node *s_head_v2 = NULL;
@@ -43,47 +46,655 @@ API void lib_v2_free_contact_records(ContactRecord* records, int count) {
 }
 
 // --- Validation Functions ---
+// The engine's rules, shared with every front end. Emails only need the
+// structural check here (a@b.co passes); the CLIs also want ".com".
 API int lib_v2_is_valid_name(const char name[]) {
-    if (name == NULL || name[0] == '\0') return 0;
-    for (int i = 0; name[i] != '\0'; i++) {
-        if (!((name[i] >= 'a' && name[i] <= 'z') ||
-              (name[i] >= 'A' && name[i] <= 'Z') ||
-              (name[i] == ' '))) {
-            return 0;
+    return engine_valid_name(name);
+}
+
+API int lib_v2_is_valid_number(const char number[]) {
+    return engine_valid_phone(number);
+}
+
+API int lib_v2_is_valid_email(const char email[]) {
+    return engine_valid_email(email, ENGINE_EMAIL_SHAPE);
+}
+
+// --- Normalized Keys ---
+// Names and emails compare case-insensitively. Each Node carries a folded copy
+// of both (engine_fold_key), written whenever the field is, so comparisons stay
+// plain strcmp and byte scans. Phones are digits only and need no shadow.
+static void node_fold_keys_v2(Node *n) {
+    engine_fold_key(n->name_key, n->name);
+    engine_fold_key(n->email_key, n->email);
+}
+
+// Fills a node's fields, folded keys included, from a parsed CSV line.
+static void node_from_record_v2(Node *n, const EngineRecord *r) {
+    memcpy(n->name, r->name, sizeof(n->name));
+    memcpy(n->phone, r->phone, sizeof(n->phone));
+    memcpy(n->email, r->email, sizeof(n->email));
+    n->next = NULL;
+    node_fold_keys_v2(n);
+}
+
+static void copy_record_v2(ContactRecord *dst, const Node *src) {
+    memcpy(dst->name, src->name, sizeof(dst->name));
+    memcpy(dst->phone, src->phone, sizeof(dst->phone));
+    memcpy(dst->email, src->email, sizeof(dst->email));
+    dst->id = src->id;
+}
+
+// --- Email Index ---
+// A chained hash table from folded email to node, kept current by every write,
+// so duplicate checks, by-email lookups and upserts take one probe instead of
+// a list walk. Nodes chain through email_next, and the table doubles once it
+// holds as many nodes as buckets. If the table cannot be allocated at all,
+// lookups walk the list until a later insert manages to rebuild it.
+#define EMAIL_INDEX_MIN_BUCKETS_V2 1024
+
+static Node **s_email_buckets_v2 = NULL;
+static size_t s_email_mask_v2 = 0; // Bucket count - 1, while the table exists
+static size_t s_email_count_v2 = 0;
+static int s_email_stale_v2 = 0;   // The table is missing nodes; lookups walk the list
+
+static size_t email_hash_v2(const char *key) { // FNV-1a
+    uint64_t h = 1469598103934665603ull;
+    for (; *key; key++) { h ^= (unsigned char)*key; h *= 1099511628211ull; }
+    return (size_t)(h ^ (h >> 32));
+}
+
+static void email_file_v2(Node *n) {
+    Node **bucket = &s_email_buckets_v2[email_hash_v2(n->email_key) & s_email_mask_v2];
+    n->email_next = *bucket;
+    *bucket = n;
+    s_email_count_v2++;
+}
+
+// Rehashes into a table of `buckets` (a power of two). Returns 0, or -1 if memory is short.
+static int email_index_resize_v2(size_t buckets) {
+    Node **grown = (Node**)calloc(buckets, sizeof(Node*));
+    if (!grown) return -1;
+    for (size_t b = 0; s_email_buckets_v2 && b <= s_email_mask_v2; b++) {
+        for (Node *p = s_email_buckets_v2[b], *next; p; p = next) {
+            next = p->email_next;
+            Node **bucket = &grown[email_hash_v2(p->email_key) & (buckets - 1)];
+            p->email_next = *bucket;
+            *bucket = p;
         }
     }
-    return 1;
+    free(s_email_buckets_v2);
+    s_email_buckets_v2 = grown;
+    s_email_mask_v2 = buckets - 1;
+    return 0;
 }
 
-API int lib_v2_is_valid_number(const char number[]) {
-    if (number == NULL) return 0;
-    int length = strlen(number);
-    if (length != 10) return 0;
-    for (int i = 0; i < length; i++) {
-        if (number[i] < '0' || number[i] > '9') return 0;
+static void email_index_drop_v2(void) {
+    free(s_email_buckets_v2);
+    s_email_buckets_v2 = NULL;
+    s_email_mask_v2 = 0;
+    s_email_count_v2 = 0;
+    s_email_stale_v2 = 0;
+}
+
+// Files n, which is already on the list.
+static void email_index_insert_v2(Node *n) {
+    if (s_email_stale_v2) { // Refile the whole list, n included
+        size_t buckets = EMAIL_INDEX_MIN_BUCKETS_V2;
+        while (buckets < (size_t)s_count_v2) buckets *= 2;
+        email_index_drop_v2();
+        if (email_index_resize_v2(buckets) != 0) { s_email_stale_v2 = 1; return; }
+        for (Node *p = s_head_v2; p; p = p->next) email_file_v2(p);
+        return;
     }
-    return 1;
+    if (!s_email_buckets_v2 || s_email_count_v2 > s_email_mask_v2) {
+        size_t buckets = s_email_buckets_v2 ? 2 * (s_email_mask_v2 + 1) : EMAIL_INDEX_MIN_BUCKETS_V2;
+        if (email_index_resize_v2(buckets) != 0 && !s_email_buckets_v2) { s_email_stale_v2 = 1; return; }
+    }
+    email_file_v2(n);
 }
 
-API int lib_v2_is_valid_email(const char email[]) {
-    if (email == NULL) return 0;
-    const char *at_symbol = strchr(email, '@');
-    if (!at_symbol || at_symbol == email) return 0;
-    const char *dot_symbol = strrchr(at_symbol, '.');
-    if (!dot_symbol || dot_symbol == at_symbol + 1 || dot_symbol[1] == '\0') return 0;
-    if ((dot_symbol - (at_symbol + 1)) < 1) return 0; 
-    if (strlen(dot_symbol + 1) < 2) return 0;
-    return 1;
+static void email_index_erase_v2(Node *n) {
+    if (s_email_stale_v2 || !s_email_buckets_v2) return;
+    Node **link = &s_email_buckets_v2[email_hash_v2(n->email_key) & s_email_mask_v2];
+    while (*link && *link != n) link = &(*link)->email_next;
+    if (*link) { *link = n->email_next; s_email_count_v2--; }
+}
+
+// Node whose email folds to the same key, or NULL.
+static Node *internal_find_email_v2(const char email[]) {
+    char key[ENGINE_FIELD_BYTES];
+    if (!email || !engine_fold_key(key, email)) return NULL;
+    if (s_email_stale_v2 || !s_email_buckets_v2) {
+        for (Node *p = s_head_v2; p; p = p->next) {
+            if (strcmp(p->email_key, key) == 0) return p;
+        }
+        return NULL;
+    }
+    for (Node *p = s_email_buckets_v2[email_hash_v2(key) & s_email_mask_v2]; p; p = p->email_next) {
+        if (strcmp(p->email_key, key) == 0) return p;
+    }
+    return NULL;
 }
 
 // Internal helper functions to check for duplicates
 static int internal_check_email_exists_v2(const char email[]) {
+    return internal_find_email_v2(email) != NULL;
+}
+
+// --- Record IDs ---
+// Every node gets the next 64-bit id when it is loaded or added; ids are never
+// reused while the library is loaded. The engine's id table maps each live id
+// to its node, so an id lookup is O(1) whatever the book size, and with the
+// prev links the node also unlinks without a walk. Deleted ids are removed
+// from the table, so it stays proportional to the live nodes.
+static EngineIds s_ids_v2;        // id -> node (.ref)
+static uint64_t s_next_id_v2 = 1; // 0 is never an id
+
+// Gives n the next id. Returns 0, or -1 if the table could not grow.
+static int id_assign_v2(Node *n) {
+    EngineKey *e = engine_ids_insert(&s_ids_v2, s_next_id_v2);
+    if (!e) return -1;
+    e->ref = n;
+    n->id = s_next_id_v2++;
+    return 0;
+}
+
+static Node *id_find_v2(uint64_t id) {
+    const EngineKey *e = engine_ids_find(&s_ids_v2, id);
+    return e ? (Node*)e->ref : NULL;
+}
+
+static void id_release_v2(const Node *n) { engine_ids_remove(&s_ids_v2, n->id); }
+
+// Forgets every id issued so far; the next ones continue the sequence.
+static void id_reset_v2(void) { engine_ids_free(&s_ids_v2); }
+
+// Every node's list_rank ascends from head to tail. Pushes take one below the
+// head's, unlinks leave the rest ascending, and relinks renumber from
+// LIST_RANK_BASE_V2, far enough up that pushes never run out.
+#define LIST_RANK_BASE_V2 ((uint64_t)1 << 62)
+
+// Pushes n on the front of the list.
+static void list_push_v2(Node *n) {
+    n->list_rank = s_head_v2 ? s_head_v2->list_rank - 1 : LIST_RANK_BASE_V2;
+    n->prev = NULL;
+    n->next = s_head_v2;
+    if (s_head_v2) s_head_v2->prev = n;
+    s_head_v2 = n;
+}
+
+static void list_unlink_v2(Node *n) {
+    if (n->prev) n->prev->next = n->next; else s_head_v2 = n->next;
+    if (n->next) n->next->prev = n->prev;
+}
+
+// Sorts relink the list through next only; this restores prev and the ranks
+// afterwards.
+static void list_relink_prev_v2(void) {
+    Node *prev = NULL;
+    uint64_t rank = LIST_RANK_BASE_V2;
+    for (Node *p = s_head_v2; p; prev = p, p = p->next) {
+        p->prev = prev;
+        p->list_rank = rank++;
+    }
+}
+
+// --- Sorted Views ---
+// One engine sorted view (EngineView) per sort field, built the first time that
+// field is sorted and then kept current by add/edit/delete. Sorting the same
+// field again only relinks the list in view order (O(n)), with no comparisons
+// at all. Equal keys sit in id order in the view and come out of every sort in
+// id order, so a relink gives exactly what a fresh sort would. Each Node
+// remembers its tree node in every built view, so an update never has to
+// search among equal keys.
+#define VIEW_FIELDS_V2 3
+
+typedef struct ViewNode {
+    EngineViewNode node; // First, so the engine's node pointers cast to ViewNode
+    Node *rec;
+} ViewNode;
+
+#define VIEW_REC_V2(t) (((const ViewNode*)(t))->rec)
+
+static const char *view_node_key_v2(const EngineView *v, const EngineViewNode *x) {
+    return (const char*)VIEW_REC_V2(x) + v->field_off;
+}
+
+static EngineView s_views_v2[VIEW_FIELDS_V2] = {
+    { NULL, offsetof(Node, name_key), 0, view_node_key_v2 },
+    { NULL, offsetof(Node, phone), 0, view_node_key_v2 },
+    { NULL, offsetof(Node, email_key), 0, view_node_key_v2 },
+};
+
+static const char *view_key_v2(const EngineView *v, const Node *rec) {
+    return (const char*)rec + v->field_off;
+}
+
+static void view_drop_v2(int f) {
+    EngineView *v = &s_views_v2[f];
+    if (!v->built) return;
+    for (Node *p = s_head_v2; p; p = p->next) free(p->view[f]);
+    v->root = NULL;
+    v->built = 0;
+}
+
+static void view_drop_all_v2(void) {
+    for (int f = 0; f < VIEW_FIELDS_V2; f++) view_drop_v2(f);
+}
+
+// Builds view f from a list that is already in (key, id) order, O(n). On
+// allocation failure the view stays unbuilt.
+static void view_build_v2(int f) {
+    EngineViewNode **nodes = (EngineViewNode**)malloc((s_count_v2 + 1) * sizeof(EngineViewNode*));
+    if (!nodes) return;
+    int n = 0;
+    for (Node *rec = s_head_v2; rec; rec = rec->next) {
+        ViewNode *x = (ViewNode*)malloc(sizeof(ViewNode));
+        if (!x) {
+            for (Node *p = s_head_v2; p != rec; p = p->next) free(p->view[f]);
+            free(nodes);
+            return;
+        }
+        x->rec = rec;
+        x->node.id = rec->id;
+        rec->view[f] = x;
+        nodes[n++] = &x->node;
+    }
+    if (engine_view_build(&s_views_v2[f], nodes, n) != 0) {
+        for (Node *p = s_head_v2; p; p = p->next) free(p->view[f]);
+    }
+    free(nodes);
+}
+
+// rec lands at its (key, id) position. A view that can't be kept current is
+// dropped and rebuilt on the next sort.
+static void view_insert_v2(int f, Node *rec) {
+    if (!s_views_v2[f].built) return;
+    rec->view[f] = NULL; // A new node's is uninitialized, an edited one's already freed
+    ViewNode *x = (ViewNode*)malloc(sizeof(ViewNode));
+    if (!x) { view_drop_v2(f); return; }
+    x->rec = rec;
+    x->node.id = rec->id;
+    rec->view[f] = x;
+    engine_view_insert(&s_views_v2[f], &x->node);
+}
+
+static void view_erase_v2(int f, Node *rec) {
+    if (!s_views_v2[f].built) return;
+    engine_view_erase(&s_views_v2[f], &rec->view[f]->node);
+    free(rec->view[f]);
+    rec->view[f] = NULL;
+}
+
+// Relinks the list in the order of view f.
+static void view_relink_list_v2(int f) {
+    Node **tail = &s_head_v2, *prev = NULL;
+    uint64_t rank = LIST_RANK_BASE_V2;
+    for (EngineViewNode *t = engine_view_first(&s_views_v2[f]); t; t = engine_view_next(t)) {
+        Node *rec = VIEW_REC_V2(t);
+        *tail = rec;
+        rec->prev = prev;
+        rec->list_rank = rank++;
+        prev = rec;
+        tail = &rec->next;
+    }
+    *tail = NULL;
+}
+
+// --- Query Engine ---
+// Boolean field queries (see engine.h for the syntax) are compiled by the
+// engine against the folded shadow keys, so values match case-insensitively.
+// When a seek clause's field has a built sorted view, a query run visits only
+// the matching key range instead of the whole list, then puts the hits back in
+// list order, the order a scan returns.
+
+// --- Regex Search ---
+// Patterns compile through the engine (engine_regex_compile, see engine.h for
+// the syntax) into a DFA matched with one table lookup per byte. Matching is
+// case-insensitive, like every other v2 search: the pattern is compiled with
+// folding and run against the folded name and email keys. The pattern's
+// longest mandatory literal is used as a prefilter through the substring
+// kernel. An anchored literal prefix (^abc...) seeks the field's sorted view
+// instead of scanning, when that view is built; the hits are then put back in
+// list order, so the results are the same either way.
+
+// --- Fuzzy Name Search ---
+// Edit-distance search over names, through a BK-tree of the distinct name keys.
+// Edit distance is a metric, so below a node at distance d from the query only
+// children whose edge distance lies within d +- k can hold a match; the rest
+// are never visited. Distances use Myers' bit-parallel algorithm, where one
+// 64-bit word covers any 49-byte key. The tree is built on the first fuzzy
+// search and then kept current by add/edit/delete. A key whose last record goes
+// away stays behind as an empty node until cleanup, because a BK-tree node
+// cannot be unlinked without rebuilding its subtree.
+#define FUZZY_MAX_DISTANCE_V2 2
+
+typedef struct FuzzyNode_v2 {
+    char key[ENGINE_FIELD_BYTES];
+    Node **recs;                          // Records whose name_key is key
+    int nrecs, cap;
+    int dist;                             // Edit distance to the parent's key
+    struct FuzzyNode_v2 *child, *sibling; // Children, one per distinct dist
+} FuzzyNode_v2;
+
+static FuzzyNode_v2 *s_fuzzy_root_v2 = NULL;
+static int s_fuzzy_built_v2 = 0;
+
+typedef struct {
+    uint64_t peq[256]; // Bit i of peq[c] is set where the pattern has c at i
+    int len;
+} FuzzyPattern_v2;
+
+static void fuzzy_pattern_v2(FuzzyPattern_v2 *p, const char *s) {
+    memset(p->peq, 0, sizeof(p->peq));
+    p->len = (int)strlen(s);
+    for (int i = 0; i < p->len; i++) p->peq[(unsigned char)s[i]] |= 1ull << i;
+}
+
+// Levenshtein distance between the pattern and t (Myers / Hyyro).
+static int fuzzy_distance_v2(const FuzzyPattern_v2 *p, const char *t) {
+    if (p->len == 0) return (int)strlen(t);
+    uint64_t pv = ~0ull, mv = 0, last = 1ull << (p->len - 1);
+    int score = p->len;
+    for (; *t; t++) {
+        uint64_t eq = p->peq[(unsigned char)*t];
+        uint64_t xv = eq | mv;
+        uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        uint64_t ph = mv | ~(xh | pv);
+        uint64_t mh = pv & xh;
+        if (ph & last) score++;
+        else if (mh & last) score--;
+        ph = (ph << 1) | 1;
+        mh <<= 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+    }
+    return score;
+}
+
+static void fuzzy_drop_v2(void) {
+    FuzzyNode_v2 *pending = s_fuzzy_root_v2; // Freed through a worklist chained by sibling
+    while (pending) {
+        FuzzyNode_v2 *t = pending;
+        pending = t->sibling;
+        if (t->child) { // Splice the children in front of the worklist
+            FuzzyNode_v2 *c = t->child;
+            while (c->sibling) c = c->sibling;
+            c->sibling = pending;
+            pending = t->child;
+        }
+        free(t->recs);
+        free(t);
+    }
+    s_fuzzy_root_v2 = NULL;
+    s_fuzzy_built_v2 = 0;
+}
+
+// Files rec under its name key. Returns 0, or -1 if memory is short.
+static int fuzzy_add_v2(Node *rec) {
+    FuzzyPattern_v2 p;
+    fuzzy_pattern_v2(&p, rec->name_key);
+    FuzzyNode_v2 **link = &s_fuzzy_root_v2, *t;
+    int d = 0;
+    while ((t = *link) != NULL) {
+        d = fuzzy_distance_v2(&p, t->key);
+        if (d == 0) break;
+        for (link = &t->child; *link && (*link)->dist != d; link = &(*link)->sibling) {}
+    }
+    if (!t) {
+        t = (FuzzyNode_v2*)calloc(1, sizeof(FuzzyNode_v2));
+        if (!t) return -1;
+        strcpy(t->key, rec->name_key);
+        t->dist = d;
+        *link = t;
+    }
+    if (t->nrecs == t->cap) {
+        int cap = t->cap ? 2 * t->cap : 1;
+        Node **grown = (Node**)realloc(t->recs, cap * sizeof(Node*));
+        if (!grown) return -1;
+        t->recs = grown;
+        t->cap = cap;
+    }
+    t->recs[t->nrecs++] = rec;
+    return 0;
+}
+
+// add/edit hooks: a tree that can't be kept current is dropped and rebuilt on the next search.
+static void fuzzy_insert_v2(Node *rec) {
+    if (s_fuzzy_built_v2 && fuzzy_add_v2(rec) != 0) fuzzy_drop_v2();
+}
+
+static void fuzzy_erase_v2(Node *rec) {
+    if (!s_fuzzy_built_v2) return;
+    FuzzyPattern_v2 p;
+    fuzzy_pattern_v2(&p, rec->name_key);
+    for (FuzzyNode_v2 *t = s_fuzzy_root_v2; t; ) {
+        int d = fuzzy_distance_v2(&p, t->key);
+        if (d == 0) {
+            for (int i = 0; i < t->nrecs; i++)
+                if (t->recs[i] == rec) { t->recs[i] = t->recs[--t->nrecs]; return; }
+            return;
+        }
+        for (t = t->child; t && t->dist != d; t = t->sibling) {}
+    }
+}
+
+static int fuzzy_build_v2(void) {
     for (Node *p = s_head_v2; p; p = p->next) {
-        if (strcmp(p->email, email) == 0) return 1;
+        if (fuzzy_add_v2(p) != 0) { fuzzy_drop_v2(); return -1; }
     }
+    s_fuzzy_built_v2 = 1;
     return 0;
 }
 
+typedef struct {
+    int dist;
+    Node *rec;
+} FuzzyHit_v2;
+
+// Closest first; equal distances by name, then email (unique), so the order is total.
+static int fuzzy_hit_cmp_v2(const void *a, const void *b) {
+    const FuzzyHit_v2 *x = (const FuzzyHit_v2*)a, *y = (const FuzzyHit_v2*)b;
+    if (x->dist != y->dist) return x->dist - y->dist;
+    int c = strcmp(x->rec->name_key, y->rec->name_key);
+    return c ? c : strcmp(x->rec->email_key, y->rec->email_key);
+}
+
+// --- Parallel Search ---
+// Large scans split the list into contiguous segments, one per worker thread.
+// Each worker collects its hits into its own buffer, and the buffers are
+// concatenated in segment order, so results come back in list order exactly as
+// in the serial scan. Segments index a node array that is kept between searches
+// and dropped whenever the list gains, loses or reorders nodes. The threads
+// come from the engine's fork/join.
+#define PARALLEL_SEARCH_THRESHOLD_V2   (1 << 16) // Default; smaller lists are scanned on the calling thread
+#define PARALLEL_SEARCH_MIN_SEGMENT_V2 8192
+
+static int s_search_parallel_threshold_v2 = PARALLEL_SEARCH_THRESHOLD_V2;
+static int s_search_threads_v2 = 0; // 0 = one per online CPU
+static Node **s_scan_nodes_v2 = NULL; // List order snapshot for segmenting, or NULL
+static int s_scan_count_v2 = 0;
+
+static void scan_invalidate_v2(void) {
+    free(s_scan_nodes_v2);
+    s_scan_nodes_v2 = NULL;
+    s_scan_count_v2 = 0;
+}
+
+static Node **scan_nodes_v2(void) {
+    if (s_scan_nodes_v2) return s_scan_nodes_v2;
+    s_scan_nodes_v2 = (Node**)malloc(s_count_v2 * sizeof(Node*));
+    if (!s_scan_nodes_v2) return NULL;
+    int n = 0;
+    for (Node *p = s_head_v2; p && n < s_count_v2; p = p->next) s_scan_nodes_v2[n++] = p;
+    s_scan_count_v2 = n;
+    return s_scan_nodes_v2;
+}
+
+typedef struct {
+    Node **hits;
+    int hit_count, hit_cap;
+    int failed; // Out of memory while growing hits
+} SearchHits_v2;
+
+static int search_hits_push_v2(SearchHits_v2 *h, Node *p) {
+    if (h->hit_count == h->hit_cap) {
+        int new_cap = h->hit_cap ? h->hit_cap * 2 : 64;
+        Node **grown = (Node**)realloc(h->hits, new_cap * sizeof(Node*));
+        if (!grown) { h->failed = 1; return 0; }
+        h->hits = grown; h->hit_cap = new_cap;
+    }
+    h->hits[h->hit_count++] = p;
+    return 1;
+}
+
+// Puts hits collected from a sorted view back in list order. Returns 0, or -1
+// if memory ran out (hits are left as they were).
+static int search_hits_list_order_v2(SearchHits_v2 *h) {
+    EngineKey *keys = (EngineKey*)malloc((h->hit_count + 1) * sizeof(EngineKey));
+    EngineKey *tmp = (EngineKey*)malloc((h->hit_count + 1) * sizeof(EngineKey));
+    if (!keys || !tmp) { free(keys); free(tmp); return -1; }
+    for (int i = 0; i < h->hit_count; i++) {
+        keys[i].key = h->hits[i]->list_rank;
+        keys[i].ref = h->hits[i];
+    }
+    EngineKey *order = engine_radix_sort_keys(keys, tmp, h->hit_count, 64);
+    for (int i = 0; i < h->hit_count; i++) h->hits[i] = (Node*)order[i].ref;
+    free(keys); free(tmp);
+    return 0;
+}
+
+// What a scan matches: one field against a substring (for a regex, its
+// required literal) and optionally the regex, or a compiled query.
+typedef struct {
+    size_t field_off, query_len;
+    const char *query;
+    EngineFieldMatcher contains;
+    const EngineRegex *regex;
+    const ContactQuery_v2 *program; // Used instead of the fields above when set
+} SearchSpec_v2;
+
+static inline int search_match_v2(const SearchSpec_v2 *spec, const Node *p) {
+    if (spec->program) return engine_query_match(spec->program, p);
+    const char *field = (const char*)p + spec->field_off;
+    return spec->contains(field, spec->query, spec->query_len) && (!spec->regex || engine_regex_match(spec->regex, field));
+}
+
+typedef struct {
+    Node **nodes;
+    int lo, hi;
+    const SearchSpec_v2 *spec;
+    SearchHits_v2 out;
+} SearchSegment_v2;
+
+static void *search_segment_run_v2(void *arg) {
+    SearchSegment_v2 *seg = (SearchSegment_v2*)arg;
+    for (int i = seg->lo; i < seg->hi; i++) {
+        if (search_match_v2(seg->spec, seg->nodes[i]) && !search_hits_push_v2(&seg->out, seg->nodes[i])) break;
+    }
+    return NULL;
+}
+
+static int search_thread_count_v2(int n) {
+    return engine_thread_count(n, s_search_parallel_threshold_v2, s_search_threads_v2, PARALLEL_SEARCH_MIN_SEGMENT_V2);
+}
+
+// Collects matching nodes in list order. Returns 0, or -1 if memory ran out.
+static int search_collect_v2(const SearchSpec_v2 *spec, SearchHits_v2 *all) {
+    int threads = search_thread_count_v2(s_count_v2);
+    Node **nodes = threads > 1 ? scan_nodes_v2() : NULL;
+    if (!nodes) { // Serial scan straight down the list
+        for (Node *p = s_head_v2; p; p = p->next)
+            if (search_match_v2(spec, p) && !search_hits_push_v2(all, p)) return -1;
+        return 0;
+    }
+    SearchSegment_v2 segs[ENGINE_SORT_MAX_THREADS];
+    int n = s_scan_count_v2;
+    for (int t = 0; t < threads; t++) {
+        segs[t] = (SearchSegment_v2){ .nodes = nodes, .lo = (int)((long long)n * t / threads),
+                                      .hi = (int)((long long)n * (t + 1) / threads), .spec = spec };
+    }
+    engine_run_parallel(search_segment_run_v2, segs, sizeof(SearchSegment_v2), threads);
+
+    int total = 0, failed = 0;
+    for (int t = 0; t < threads; t++) { total += segs[t].out.hit_count; failed |= segs[t].out.failed; }
+    if (!failed && total > 0) {
+        all->hits = (Node**)malloc(total * sizeof(Node*));
+        if (!all->hits) failed = 1;
+    }
+    for (int t = 0; t < threads; t++) {
+        if (!failed && segs[t].out.hit_count > 0) {
+            memcpy(all->hits + all->hit_count, segs[t].out.hits, segs[t].out.hit_count * sizeof(Node*));
+            all->hit_count += segs[t].out.hit_count;
+        }
+        free(segs[t].out.hits);
+    }
+    all->hit_cap = all->hit_count;
+    return failed ? -1 : 0;
+}
+
+// --- Phonetic Index ---
+// "Sounds like" lookup on names through the engine's Soundex index (EngineSound),
+// kept current by every write. Each Node embeds its EngineSoundEntry.
+#define SEARCH_SOUNDS_LIKE_V2 4 // search_type for lib_v2_search_contacts
+
+static EngineSound s_sound_v2;
+
+#define SOUND_NODE_V2(e) ((Node*)((char*)(e) - offsetof(Node, sound)))
+
+// Indexes rec under the codes of its current name.
+static void sound_insert_v2(Node *rec) {
+    engine_sound_insert(&s_sound_v2, &rec->sound, rec->name);
+}
+
+static void sound_erase_v2(Node *rec) {
+    engine_sound_erase(&s_sound_v2, &rec->sound);
+}
+
+static void sound_drop_v2(void) {
+    engine_sound_free(&s_sound_v2);
+}
+
+static int sound_hit_cmp_v2(const void *a, const void *b) {
+    const Node *x = *(Node* const*)a, *y = *(Node* const*)b;
+    int c = strcmp(x->name_key, y->name_key);
+    return c ? c : strcmp(x->email_key, y->email_key);
+}
+
+// Records whose name has a word sounding like every word of query, in name order.
+static int sound_collect_v2(const char *query, SearchHits_v2 *found) {
+    if (s_sound_v2.stale) { // Catch up after a failed bucket growth
+        sound_drop_v2();
+        for (Node *p = s_head_v2; p; p = p->next) sound_insert_v2(p);
+        if (s_sound_v2.stale) return -1;
+    }
+    int count;
+    EngineSoundEntry **hits = engine_sound_find(&s_sound_v2, query, &count);
+    if (count < 0) return -1;
+    for (int i = 0; i < count; i++) {
+        if (!search_hits_push_v2(found, SOUND_NODE_V2(hits[i]))) { free(hits); return -1; }
+    }
+    free(hits);
+    if (found->hit_count > 1) qsort(found->hits, found->hit_count, sizeof(Node*), sound_hit_cmp_v2);
+    return 0;
+}
+
+// Copies the hits into a ContactRecord array and frees them.
+static ContactRecord *search_hits_to_records_v2(SearchHits_v2 *found, int *out_count) {
+    *out_count = 0;
+    ContactRecord *records = found->hit_count ? (ContactRecord*)malloc(found->hit_count * sizeof(ContactRecord)) : NULL;
+    if (records) {
+        for (int i = 0; i < found->hit_count; i++) {
+            copy_record_v2(&records[i], found->hits[i]);
+        }
+        *out_count = found->hit_count;
+    }
+    free(found->hits);
+    found->hits = NULL;
+    return records;
+}
+
 // --- Core API Functions ---
 API int lib_v2_initialize(const char* data_file_path) {
     lib_v2_cleanup(); 
@@ -101,7 +712,6 @@ API int lib_v2_initialize(const char* data_file_path) {
     }
 
     char line[256]; // Increased buffer slightly for safety
-    char name_buf[50], phone_buf[50], email_buf[50];
 
     // Skip header if present (simple one-line skip) - adjust if your CSV has no header
     if (fgets(line, sizeof(line), pF) == NULL) { // Check if file is empty or just header
@@ -110,46 +720,71 @@ API int lib_v2_initialize(const char* data_file_path) {
     }
     // A more robust header check would be to see if it matches "Name,Phone,Email"
 
+    EngineRecord r;
     while (fgets(line, sizeof(line), pF)) { // Start reading data lines
+        if (!engine_parse_csv_line(line, &r)) continue; // Not three fields
         Node *n = (Node*)malloc(sizeof(Node));
         if (!n) { 
             fclose(pF); lib_v2_cleanup(); return -2; 
         }
-        
-        // Initialize node fields to empty strings for safety before sscanf
-        n->name[0] = '\0'; n->phone[0] = '\0'; n->email[0] = '\0'; n->next = NULL;
-
-        if (sscanf(line, "%49[^,],%49[^,],%49[^\n]", n->name, n->phone, n->email) == 3) {
-            n->name[49] = '\0'; n->phone[49] = '\0'; n->email[49] = '\0';
-            n->next = s_head_v2;
-            s_head_v2 = n;
-            s_count_v2++;
-        } else {
-            free(n); 
+        node_from_record_v2(n, &r);
+        if (id_assign_v2(n) != 0) {
+            free(n); fclose(pF); lib_v2_cleanup(); return -2;
         }
+        sound_insert_v2(n);
+        list_push_v2(n);
+        s_count_v2++;
+        email_index_insert_v2(n);
     }
     fclose(pF);
     return 0; 
 }
 
 API void lib_v2_cleanup() {
+    view_drop_all_v2();
+    fuzzy_drop_v2();
+    sound_drop_v2();
+    email_index_drop_v2();
+    scan_invalidate_v2();
     Node *current = s_head_v2; Node *next_node;
     while (current != NULL) { next_node = current->next; free(current); current = next_node; }
     s_head_v2 = NULL; s_count_v2 = 0;
+    id_reset_v2();
+}
+
+// Links a node for validated fields whose email is not taken and files it in
+// every index; the caller invalidates the scan snapshot. NULL if memory is short.
+static Node *internal_insert_v2(const char* name, const char* phone, const char* email) {
+    Node *newNode = (Node*)malloc(sizeof(Node));
+    if (!newNode) return NULL;
+    strncpy(newNode->name, name, 49); newNode->name[49] = '\0';
+    strncpy(newNode->phone, phone, 49); newNode->phone[49] = '\0';
+    strncpy(newNode->email, email, 49); newNode->email[49] = '\0';
+    node_fold_keys_v2(newNode);
+    if (id_assign_v2(newNode) != 0) { free(newNode); return NULL; }
+    list_push_v2(newNode); s_count_v2++;
+    for (int f = 0; f < VIEW_FIELDS_V2; f++) view_insert_v2(f, newNode);
+    fuzzy_insert_v2(newNode);
+    sound_insert_v2(newNode);
+    email_index_insert_v2(newNode);
+    return newNode;
 }
 
 API char* lib_v2_add_contact(const char* name, const char* phone, const char* email) {
+    return lib_v2_add_contact_id(name, phone, email, NULL);
+}
+
+API char* lib_v2_add_contact_id(const char* name, const char* phone, const char* email, uint64_t* out_id) {
+    if (out_id) *out_id = 0;
     if (!lib_v2_is_valid_name(name)) return allocate_and_copy_string_v2("Error: Invalid name format.");
     if (!lib_v2_is_valid_number(phone)) return allocate_and_copy_string_v2("Error: Invalid phone number.");
     if (!lib_v2_is_valid_email(email)) return allocate_and_copy_string_v2("Error: Invalid email format.");
     if (internal_check_email_exists_v2(email)) return allocate_and_copy_string_v2("Error: Email already exists.");
 
-    Node *newNode = (Node*)malloc(sizeof(Node));
+    Node *newNode = internal_insert_v2(name, phone, email);
     if (!newNode) return allocate_and_copy_string_v2("Error: Memory allocation failed.");
-    strncpy(newNode->name, name, 49); newNode->name[49] = '\0';
-    strncpy(newNode->phone, phone, 49); newNode->phone[49] = '\0';
-    strncpy(newNode->email, email, 49); newNode->email[49] = '\0';
-    newNode->next = s_head_v2; s_head_v2 = newNode; s_count_v2++;
+    if (out_id) *out_id = newNode->id;
+    scan_invalidate_v2();
     return allocate_and_copy_string_v2("Contact added successfully (LinkedList).");
 }
 
@@ -161,9 +796,7 @@ API ContactRecord* lib_v2_get_all_contacts(int* out_count) {
     if (!records_array) return NULL;
     Node *current = s_head_v2; int i = 0;
     for (i = 0; i < s_count_v2 && current; i++, current = current->next) {
-        strncpy(records_array[i].name, current->name, 49); records_array[i].name[49] = '\0';
-        strncpy(records_array[i].phone, current->phone, 49); records_array[i].phone[49] = '\0';
-        strncpy(records_array[i].email, current->email, 49); records_array[i].email[49] = '\0';
+        copy_record_v2(&records_array[i], current);
     }
     // If loop terminated because !current but i < s_count_v2, then list is corrupted or count is wrong.
     if (i != s_count_v2) { 
@@ -186,34 +819,168 @@ API ContactRecord* lib_v2_search_contacts(const char* query, int search_type, in
     if (!out_count || !query) { if(out_count) *out_count = 0; return NULL; }
     *out_count = 0;
     if (s_count_v2 == 0 || !s_head_v2) return NULL;
-    int match_count = 0; Node *p_count = s_head_v2;
-    while(p_count){
-        int found = 0;
-        if (search_type == 1 && strstr(p_count->name, query)) found = 1;
-        else if (search_type == 2 && strstr(p_count->phone, query)) found = 1;
-        else if (search_type == 3 && strstr(p_count->email, query)) found = 1;
-        if (found) match_count++;
-        p_count = p_count->next;
-    }
-    if (match_count == 0) return NULL;
-    ContactRecord* matches = (ContactRecord*)malloc(match_count * sizeof(ContactRecord));
-    if (!matches) return NULL;
-    int current_match_idx = 0; Node *p_data = s_head_v2;
-    while(p_data && current_match_idx < match_count){
-        int found = 0;
-        if (search_type == 1 && strstr(p_data->name, query)) found = 1;
-        else if (search_type == 2 && strstr(p_data->phone, query)) found = 1;
-        else if (search_type == 3 && strstr(p_data->email, query)) found = 1;
-        if (found) {
-            strncpy(matches[current_match_idx].name, p_data->name, 49); matches[current_match_idx].name[49] = '\0';
-            strncpy(matches[current_match_idx].phone, p_data->phone, 49); matches[current_match_idx].phone[49] = '\0';
-            strncpy(matches[current_match_idx].email, p_data->email, 49); matches[current_match_idx].email[49] = '\0';
-            current_match_idx++;
+    if (search_type == SEARCH_SOUNDS_LIKE_V2) {
+        SearchHits_v2 found = { 0 };
+        if (sound_collect_v2(query, &found) != 0) { free(found.hits); return NULL; }
+        return search_hits_to_records_v2(&found, out_count);
+    }
+    if (search_type < 1 || search_type > VIEW_FIELDS_V2) return NULL;
+    static const size_t field_offs[VIEW_FIELDS_V2] = { offsetof(Node, name_key), offsetof(Node, phone), offsetof(Node, email_key) };
+    char key[ENGINE_FIELD_BYTES];
+    if (!engine_fold_key(key, query)) return NULL; // Longer than any field
+    SearchSpec_v2 spec = { .field_off = field_offs[search_type - 1], .query_len = strlen(key), .query = key };
+    spec.contains = engine_field_matcher(spec.query_len);
+    SearchHits_v2 found = { 0 };
+    if (search_collect_v2(&spec, &found) != 0) { free(found.hits); return NULL; }
+    return search_hits_to_records_v2(&found, out_count);
+}
+
+API ContactRecord* lib_v2_search_contacts_regex(const char* pattern, int search_type, int* out_count, char** out_error) {
+    if (out_error) *out_error = NULL;
+    if (!out_count) return NULL;
+    *out_count = 0;
+    if (!pattern || search_type < 1 || search_type > VIEW_FIELDS_V2) return NULL;
+    const char *error;
+    EngineRegex *re = engine_regex_compile(pattern, 1, &error);
+    if (!re) {
+        if (out_error) *out_error = allocate_and_copy_string_v2(error);
+        return NULL;
+    }
+
+    const EngineView *v = &s_views_v2[search_type - 1];
+    SearchSpec_v2 spec = { .field_off = v->field_off, .query_len = strlen(re->literal), .query = re->literal, .regex = re };
+    spec.contains = engine_field_matcher(spec.query_len);
+    SearchHits_v2 found = { 0 };
+    int failed = 0;
+    if (re->prefix[0] && v->built) { // Only the keys starting with the anchored prefix
+        size_t prefix_len = strlen(re->prefix);
+        for (EngineViewNode *t = engine_view_lower_bound(v, re->prefix); t && !failed; t = engine_view_next(t)) {
+            if (strncmp(view_key_v2(v, VIEW_REC_V2(t)), re->prefix, prefix_len) != 0) break;
+            failed = search_match_v2(&spec, VIEW_REC_V2(t)) && !search_hits_push_v2(&found, VIEW_REC_V2(t));
         }
-        p_data = p_data->next;
+        if (!failed) failed = search_hits_list_order_v2(&found) != 0;
+    } else if (s_head_v2) {
+        failed = search_collect_v2(&spec, &found) != 0;
     }
-    *out_count = current_match_idx;
-    return matches;
+    engine_regex_free(re);
+    if (failed) { free(found.hits); return NULL; }
+    return search_hits_to_records_v2(&found, out_count);
+}
+
+API ContactRecord* lib_v2_search_contacts_fuzzy(const char* name, int max_distance, int* out_count) {
+    if (!out_count) return NULL;
+    *out_count = 0;
+    char key[ENGINE_FIELD_BYTES];
+    if (!name || max_distance < 0 || max_distance > FUZZY_MAX_DISTANCE_V2 || !engine_fold_key(key, name)) return NULL;
+    if (!s_head_v2 || (!s_fuzzy_built_v2 && fuzzy_build_v2() != 0)) return NULL;
+
+    FuzzyPattern_v2 p;
+    fuzzy_pattern_v2(&p, key);
+    int hit_count = 0, hit_cap = 0, top = 0, stack_cap = 64, failed = 0;
+    FuzzyHit_v2 *hits = NULL;
+    FuzzyNode_v2 **stack = (FuzzyNode_v2**)malloc(stack_cap * sizeof(FuzzyNode_v2*));
+    if (!stack) return NULL;
+    stack[top++] = s_fuzzy_root_v2;
+    while (top > 0 && !failed) {
+        FuzzyNode_v2 *t = stack[--top];
+        int d = fuzzy_distance_v2(&p, t->key);
+        if (d <= max_distance && t->nrecs > 0) {
+            if (hit_count + t->nrecs > hit_cap) {
+                hit_cap = 2 * (hit_count + t->nrecs);
+                FuzzyHit_v2 *grown = (FuzzyHit_v2*)realloc(hits, hit_cap * sizeof(FuzzyHit_v2));
+                if (!grown) { failed = 1; break; }
+                hits = grown;
+            }
+            for (int i = 0; i < t->nrecs; i++) hits[hit_count++] = (FuzzyHit_v2){ d, t->recs[i] };
+        }
+        for (FuzzyNode_v2 *c = t->child; c; c = c->sibling) {
+            if (c->dist < d - max_distance || c->dist > d + max_distance) continue;
+            if (top == stack_cap) {
+                FuzzyNode_v2 **grown = (FuzzyNode_v2**)realloc(stack, 2 * stack_cap * sizeof(FuzzyNode_v2*));
+                if (!grown) { failed = 1; break; }
+                stack = grown;
+                stack_cap *= 2;
+            }
+            stack[top++] = c;
+        }
+    }
+    free(stack);
+    ContactRecord *records = !failed && hit_count ? (ContactRecord*)malloc(hit_count * sizeof(ContactRecord)) : NULL;
+    if (records) {
+        qsort(hits, hit_count, sizeof(FuzzyHit_v2), fuzzy_hit_cmp_v2);
+        for (int i = 0; i < hit_count; i++) {
+            copy_record_v2(&records[i], hits[i].rec);
+        }
+        *out_count = hit_count;
+    }
+    free(hits);
+    return records;
+}
+
+API ContactQuery_v2* lib_v2_query_compile(const char* text, char** out_error) {
+    if (out_error) *out_error = NULL;
+    size_t field_offs[VIEW_FIELDS_V2];
+    for (int f = 0; f < VIEW_FIELDS_V2; f++) field_offs[f] = s_views_v2[f].field_off;
+    char error[128];
+    ContactQuery_v2 *q = engine_query_compile(text, field_offs, 1, error, sizeof(error));
+    if (!q && out_error) *out_error = allocate_and_copy_string_v2(error);
+    return q;
+}
+
+API ContactRecord* lib_v2_query_run(const ContactQuery_v2* query, int* out_count) {
+    if (!out_count) return NULL;
+    *out_count = 0;
+    if (!query || s_count_v2 == 0 || !s_head_v2) return NULL;
+
+    const EngineQueryClause *seek = NULL;
+    for (int i = 0; i < query->nseeks && !seek; i++)
+        if (s_views_v2[query->clauses[query->seeks[i]].field - 1].built) seek = &query->clauses[query->seeks[i]];
+
+    SearchHits_v2 found = { 0 };
+    if (seek) { // Only the key range the seek clause allows
+        const EngineView *v = &s_views_v2[seek->field - 1];
+        for (EngineViewNode *t = engine_view_lower_bound(v, seek->value); t; t = engine_view_next(t)) {
+            const char *key = view_key_v2(v, VIEW_REC_V2(t));
+            if (seek->op == ENGINE_QUERY_EQUALS ? strcmp(key, seek->value) != 0 : strncmp(key, seek->value, seek->len) != 0) break;
+            if (engine_query_match(query, VIEW_REC_V2(t)) && !search_hits_push_v2(&found, VIEW_REC_V2(t))) { free(found.hits); return NULL; }
+        }
+        if (search_hits_list_order_v2(&found) != 0) { free(found.hits); return NULL; }
+    } else {
+        SearchSpec_v2 spec = { .program = query };
+        if (search_collect_v2(&spec, &found) != 0) { free(found.hits); return NULL; }
+    }
+    return search_hits_to_records_v2(&found, out_count);
+}
+
+API void lib_v2_query_free(ContactQuery_v2* query) {
+    engine_query_free(query);
+}
+
+// Writes validated fields into target, keeping every index in step. new_email
+// must not belong to another node.
+static void internal_write_v2(Node *target, const char* new_name, const char* new_phone, const char* new_email) {
+    char name_key[ENGINE_FIELD_BYTES], email_key[ENGINE_FIELD_BYTES];
+    engine_fold_key(name_key, new_name);
+    engine_fold_key(email_key, new_email);
+    int changed[VIEW_FIELDS_V2] = { strcmp(target->name_key, name_key) != 0, strcmp(target->phone, new_phone) != 0,
+                                    strcmp(target->email_key, email_key) != 0 };
+    for (int f = 0; f < VIEW_FIELDS_V2; f++) if (changed[f]) view_erase_v2(f, target);
+    if (changed[0]) { fuzzy_erase_v2(target); sound_erase_v2(target); }
+    if (changed[2]) email_index_erase_v2(target);
+    strncpy(target->name, new_name, 49); target->name[49] = '\0';
+    strncpy(target->phone, new_phone, 49); target->phone[49] = '\0';
+    strncpy(target->email, new_email, 49); target->email[49] = '\0';
+    node_fold_keys_v2(target);
+    for (int f = 0; f < VIEW_FIELDS_V2; f++) if (changed[f]) view_insert_v2(f, target);
+    if (changed[0]) { fuzzy_insert_v2(target); sound_insert_v2(target); }
+    if (changed[2]) email_index_insert_v2(target);
+}
+
+static char* internal_edit_v2(Node *target, const char* new_name, const char* new_phone, const char* new_email) {
+    Node *owner = internal_find_email_v2(new_email);
+    if (owner && owner != target) return allocate_and_copy_string_v2("Error: New email already exists.");
+    internal_write_v2(target, new_name, new_phone, new_email);
+    return allocate_and_copy_string_v2("Contact updated successfully (LinkedList).");
 }
 
 API char* lib_v2_edit_contact(const char* old_email_id, const char* new_name, const char* new_phone, const char* new_email) {
@@ -221,26 +988,123 @@ API char* lib_v2_edit_contact(const char* old_email_id, const char* new_name, co
     if (!lib_v2_is_valid_name(new_name)) return allocate_and_copy_string_v2("Error: Invalid new name.");
     if (!lib_v2_is_valid_number(new_phone)) return allocate_and_copy_string_v2("Error: Invalid new phone.");
     if (!lib_v2_is_valid_email(new_email)) return allocate_and_copy_string_v2("Error: Invalid new email.");
-    Node *target = NULL; Node *p_find = s_head_v2;
-    while(p_find){ if (strcmp(p_find->email, old_email_id) == 0) { target = p_find; break; } p_find = p_find->next; }
+    Node *target = internal_find_email_v2(old_email_id);
     if (!target) return allocate_and_copy_string_v2("Error: Contact to edit not found.");
-    if (strcmp(old_email_id, new_email) != 0) { // Email is being changed
-        Node *p_check = s_head_v2;
-        while(p_check){ if(p_check != target && strcmp(p_check->email, new_email) == 0) return allocate_and_copy_string_v2("Error: New email already exists."); p_check = p_check->next; }
-    }
-    strncpy(target->name, new_name, 49); target->name[49] = '\0';
-    strncpy(target->phone, new_phone, 49); target->phone[49] = '\0';
-    strncpy(target->email, new_email, 49); target->email[49] = '\0';
-    return allocate_and_copy_string_v2("Contact updated successfully (LinkedList).");
+    return internal_edit_v2(target, new_name, new_phone, new_email);
+}
+
+API char* lib_v2_edit_contact_by_id(uint64_t id, const char* new_name, const char* new_phone, const char* new_email) {
+    if (!lib_v2_is_valid_name(new_name)) return allocate_and_copy_string_v2("Error: Invalid new name.");
+    if (!lib_v2_is_valid_number(new_phone)) return allocate_and_copy_string_v2("Error: Invalid new phone.");
+    if (!lib_v2_is_valid_email(new_email)) return allocate_and_copy_string_v2("Error: Invalid new email.");
+    Node *target = id_find_v2(id);
+    if (!target) return allocate_and_copy_string_v2("Error: Contact to edit not found.");
+    return internal_edit_v2(target, new_name, new_phone, new_email);
+}
+
+API int lib_v2_get_contact_by_id(uint64_t id, ContactRecord* out) {
+    Node *target = id_find_v2(id);
+    if (!target || !out) return -1;
+    copy_record_v2(out, target);
+    return 0;
+}
+
+// Unlinks p from the list and every index and frees it; the caller invalidates the scan snapshot.
+static void internal_remove_v2(Node *p) {
+    for (int f = 0; f < VIEW_FIELDS_V2; f++) view_erase_v2(f, p);
+    fuzzy_erase_v2(p);
+    sound_erase_v2(p);
+    email_index_erase_v2(p);
+    id_release_v2(p);
+    list_unlink_v2(p);
+    free(p); s_count_v2--;
 }
 
 API int lib_v2_delete_contact_by_email(const char* email) {
     // ... (Implementation remains largely the same as the robust one provided before) ...
-    Node *current = s_head_v2, *prev = NULL;
-    if (current != NULL && strcmp(current->email, email) == 0) { s_head_v2 = current->next; free(current); s_count_v2--; return 0; }
-    while (current != NULL && strcmp(current->email, email) != 0) { prev = current; current = current->next; }
+    Node *current = internal_find_email_v2(email);
+    if (current == NULL) return -1; // Not found
+    internal_remove_v2(current);
+    scan_invalidate_v2();
+    return 0;
+}
+
+API int lib_v2_delete_contact_by_id(uint64_t id) {
+    Node *current = id_find_v2(id);
     if (current == NULL) return -1; // Not found
-    prev->next = current->next; free(current); s_count_v2--; return 0;
+    internal_remove_v2(current);
+    scan_invalidate_v2();
+    return 0;
+}
+
+// Bulk writes by predicate: one walk of the list evaluates the query on each
+// record and unlinks or rewrites the matches on the spot, so k victims cost one
+// pass instead of k lookups.
+API int lib_v2_delete_contacts_where(const ContactQuery_v2* query) {
+    if (!query) return -1;
+    int deleted = 0;
+    for (Node *p = s_head_v2, *next; p; p = next) {
+        next = p->next;
+        if (!engine_query_match(query, p)) continue;
+        internal_remove_v2(p);
+        deleted++;
+    }
+    if (deleted) scan_invalidate_v2();
+    return deleted;
+}
+
+API int lib_v2_update_contacts_where(const ContactQuery_v2* query, const char* new_name, const char* new_phone) {
+    if (!query || (!new_name && !new_phone)) return -1;
+    if (new_name && !lib_v2_is_valid_name(new_name)) return -2;
+    if (new_phone && !lib_v2_is_valid_number(new_phone)) return -3;
+    char name_key[ENGINE_FIELD_BYTES];
+    if (new_name) engine_fold_key(name_key, new_name);
+    int updated = 0;
+    for (Node *p = s_head_v2; p; p = p->next) {
+        if (!engine_query_match(query, p)) continue;
+        int changed[VIEW_FIELDS_V2] = { new_name && strcmp(p->name_key, name_key) != 0,
+                                        new_phone && strcmp(p->phone, new_phone) != 0, 0 };
+        for (int f = 0; f < VIEW_FIELDS_V2; f++) if (changed[f]) view_erase_v2(f, p);
+        if (changed[0]) { fuzzy_erase_v2(p); sound_erase_v2(p); }
+        if (new_name) { strncpy(p->name, new_name, 49); p->name[49] = '\0'; }
+        if (new_phone) { strncpy(p->phone, new_phone, 49); p->phone[49] = '\0'; }
+        node_fold_keys_v2(p);
+        for (int f = 0; f < VIEW_FIELDS_V2; f++) if (changed[f]) view_insert_v2(f, p);
+        if (changed[0]) { fuzzy_insert_v2(p); sound_insert_v2(p); }
+        updated++;
+    }
+    return updated;
+}
+
+// Upsert: each row costs one email index probe. A row equal to the stored
+// contact is counted and skipped, so it causes no index churn and no write.
+API int lib_v2_upsert_contacts(const ContactRecord* rows, int row_count, int* out_inserted, int* out_updated, int* out_unchanged) {
+    int inserted = 0, updated = 0, unchanged = 0, rejected = 0, status = 0;
+    if (!rows || row_count < 0) status = -1;
+    for (int i = 0; i < row_count && status == 0; i++) {
+        const ContactRecord *r = &rows[i];
+        if (!memchr(r->name, '\0', sizeof(r->name)) || !memchr(r->phone, '\0', sizeof(r->phone))
+            || !memchr(r->email, '\0', sizeof(r->email)) || !lib_v2_is_valid_name(r->name)
+            || !lib_v2_is_valid_number(r->phone) || !lib_v2_is_valid_email(r->email)) {
+            rejected++;
+            continue;
+        }
+        Node *p = internal_find_email_v2(r->email);
+        if (!p) {
+            if (internal_insert_v2(r->name, r->phone, r->email)) inserted++;
+            else status = -2;
+        } else if (strcmp(p->name, r->name) == 0 && strcmp(p->phone, r->phone) == 0 && strcmp(p->email, r->email) == 0) {
+            unchanged++;
+        } else {
+            internal_write_v2(p, r->name, r->phone, r->email);
+            updated++;
+        }
+    }
+    if (inserted) scan_invalidate_v2();
+    if (out_inserted) *out_inserted = inserted;
+    if (out_updated) *out_updated = updated;
+    if (out_unchanged) *out_unchanged = unchanged;
+    return status ? status : rejected;
 }
 
 API int lib_v2_delete_all_contacts() { lib_v2_cleanup(); return 0; }
@@ -253,127 +1117,458 @@ API int lib_v2_delete_all_contacts() { lib_v2_cleanup(); return 0; }
 //      lib_v2_search_contacts, lib_v2_edit_contact, lib_v2_delete_contact_by_email,
 //      lib_v2_delete_all_contacts - ALL OF THESE REMAIN THE SAME AS BEFORE) ...
 
-// --- Merge Sort Implementation (with iterative merge) ---
+// --- Field Sort ---
+// Names and emails sort on their folded keys, phones on the phone itself,
+// through the engine's list sort: packed LSD radix for phones, MSD radix on
+// cached prefixes for the rest, on the work-stealing pool past the parallel
+// threshold. The list is put in id order first, so equal keys come out in id
+// order, as in the sorted views, whatever order earlier sorts left it in.
 
-// Comparison functions (ensure they don't have early returns for NULL, as sortedMerge handles NULL lists)
-static int cmpName_v2(Node *a, Node *b)  { return strcmp(a->name,  b->name)  <= 0; }
-static int cmpPhone_v2(Node *a, Node *b) { return strcmp(a->phone, b->phone) <= 0; }
-static int cmpEmail_v2(Node *a, Node *b) { return strcmp(a->email, b->email) <= 0; }
+// Parallel sort settings, see lib_v2_set_sort_parallelism().
+static int s_sort_parallel_threshold_v2 = ENGINE_SORT_PARALLEL_THRESHOLD;
+static int s_sort_threads_v2 = 0; // 0 = one per online CPU
 
-// frontBackSplit_v2 remains the same as before
-static void frontBackSplit_v2(Node *source, Node **frontRef, Node **backRef) {
-    if (source == NULL || source->next == NULL) {
-        *frontRef = source; 
-        *backRef = NULL; 
-        return;
-    }
-    Node *slow = source; 
-    Node *fast = source->next; 
-    while (fast != NULL) {
-        fast = fast->next;
-        if (fast != NULL) {
-            slow = slow->next;
-            fast = fast->next;
+// The nodes in id order (see engine_sort_ids), *n of them. Returns a malloc'd
+// array, or NULL if memory is short.
+static Node **nodes_by_id_v2(int *n) {
+    EngineKey *keys = (EngineKey*)malloc((s_count_v2 + 1) * sizeof(EngineKey));
+    EngineKey *tmp = (EngineKey*)malloc((s_count_v2 + 1) * sizeof(EngineKey));
+    Node **nodes = (Node**)malloc((s_count_v2 + 1) * sizeof(Node*));
+    *n = 0;
+    if (keys && tmp && nodes) {
+        for (Node *p = s_head_v2; p && *n < s_count_v2; p = p->next) {
+            keys[*n].key = p->id;
+            keys[(*n)++].ref = p;
         }
+        EngineKey *order = engine_sort_ids(keys, tmp, *n);
+        for (int i = 0; i < *n; i++) nodes[i] = (Node*)order[i].ref;
+    } else {
+        free(nodes);
+        nodes = NULL;
     }
-    *frontRef = source;      
-    *backRef  = slow->next;  
-    slow->next = NULL;       
+    free(keys); free(tmp);
+    return nodes;
 }
 
-// NEW Iterative Sorted Merge function
-static Node *sortedMerge_v2_iterative(Node *a, Node *b, int (*cmp)(Node*,Node*)) {
-    if (!a) return b;
-    if (!b) return a;
+// Returns 0 on success, -1 on allocation failure (the list is left untouched).
+static int sort_list_field_v2(size_t field_off) {
+    int n = 0;
+    Node **by_id = nodes_by_id_v2(&n);
+    if (!by_id) return -1;
+    for (int i = 0; i < n; i++) by_id[i]->next = i + 1 < n ? by_id[i + 1] : NULL;
+    if (n > 0) s_head_v2 = by_id[0];
+    free(by_id);
+    int threads = engine_sort_threads(n, s_sort_parallel_threshold_v2, s_sort_threads_v2);
+    s_head_v2 = (Node*)engine_sort_list(s_head_v2, n, offsetof(Node, next), field_off, threads);
+    list_relink_prev_v2();
+    return 0;
+}
 
-    Node *result_head = NULL;
-    Node *current_tail = NULL;
+API int lib_v2_sort_contacts(int sort_type) {
+    if (s_count_v2 < 2 || !s_head_v2) return 0;
+    if (sort_type < 1 || sort_type > VIEW_FIELDS_V2) return -1;
+    scan_invalidate_v2(); // Every path below relinks the list
+    if (s_views_v2[sort_type - 1].built) {
+        view_relink_list_v2(sort_type - 1); // Already maintained, nothing to compare
+        return 0;
+    }
+    if (sort_list_field_v2(sort_type == 1 ? offsetof(Node, name_key)
+                         : sort_type == 2 ? offsetof(Node, phone)
+                         : offsetof(Node, email_key)) != 0) return -2; // Allocation failure
+    view_build_v2(sort_type - 1);
+    return 0;
+}
 
-    // Pick the initial head
-    if (cmp(a, b)) {
-        result_head = a;
-        a = a->next;
-    } else {
-        result_head = b;
-        b = b->next;
+// --- Multi-Key Sort ---
+// Stable sort on up to three distinct fields, each ascending or descending.
+// Every ordered field tuple gets its own kernel generated by
+// DEFINE_MULTI_SORT_V2, so the composite comparison is inlined into the merge
+// loop; the tuple is looked up once per sort, never per comparison. The first
+// two keys' 8-byte prefixes are cached next to the node pointer, as in the
+// radix sort, so most comparisons never touch the Node. The list is relinked in
+// the sorted order; the sorted views do not depend on list order and stay valid.
+#define MULTI_SORT_RUN_V2 16
+
+typedef struct {
+    uint64_t prefix;  // First key's leading bytes, see engine_key_prefix
+    uint64_t prefix2; // Second key's leading bytes (0 for a single key)
+    Node *node;
+} MultiKey_v2;
+
+typedef void (*MultiSortKernel_v2)(MultiKey_v2 *a, MultiKey_v2 *tmp, int n, const int *dir);
+
+// Member each field sorts on, and full-field comparisons; `none` pads shorter
+// tuples and folds away.
+#define MULTI_KEY_FIELD_name  name_key
+#define MULTI_KEY_FIELD_phone phone
+#define MULTI_KEY_FIELD_email email_key
+#define MULTI_KEY_CMP_name(a, b)  strcmp((a)->name_key, (b)->name_key)
+#define MULTI_KEY_CMP_phone(a, b) strcmp((a)->phone, (b)->phone)
+#define MULTI_KEY_CMP_email(a, b) strcmp((a)->email_key, (b)->email_key)
+#define MULTI_KEY_CMP_none(a, b)  0
+
+#define DEFINE_MULTI_SORT_V2(tag, F1, F2, F3)                                              \
+static inline int multi_cmp_##tag##_v2(const MultiKey_v2 *a, const MultiKey_v2 *b, const int *dir) { \
+    int c;                                                                                 \
+    if (a->prefix != b->prefix) c = a->prefix < b->prefix ? -1 : 1;                        \
+    else if ((a->prefix & 0xFF) == 0) c = 0; /* Both strings end inside the prefix */       \
+    else c = strcmp(a->node->MULTI_KEY_FIELD_##F1 + 8, b->node->MULTI_KEY_FIELD_##F1 + 8); \
+    if (c != 0) return dir[0] < 0 ? -c : c;                                                \
+    if (a->prefix2 != b->prefix2) c = a->prefix2 < b->prefix2 ? -1 : 1;                    \
+    else if ((a->prefix2 & 0xFF) == 0) c = 0;                                              \
+    else c = MULTI_KEY_CMP_##F2(a->node, b->node);                                         \
+    if (c != 0) return dir[1] < 0 ? -c : c;                                                \
+    if ((c = MULTI_KEY_CMP_##F3(a->node, b->node)) != 0) return dir[2] < 0 ? -c : c;       \
+    return 0;                                                                              \
+}                                                                                          \
+static void multi_sort_##tag##_v2(MultiKey_v2 *a, MultiKey_v2 *tmp, int n, const int *dir) { \
+    for (int lo = 0; lo < n; lo += MULTI_SORT_RUN_V2) { /* Insertion-sorted runs */        \
+        int hi = lo + MULTI_SORT_RUN_V2 < n ? lo + MULTI_SORT_RUN_V2 : n;                  \
+        for (int i = lo + 1; i < hi; i++) {                                                \
+            MultiKey_v2 k = a[i]; int j = i;                                               \
+            while (j > lo && multi_cmp_##tag##_v2(&a[j - 1], &k, dir) > 0) { a[j] = a[j - 1]; j--; } \
+            a[j] = k;                                                                      \
+        }                                                                                  \
+    }                                                                                      \
+    MultiKey_v2 *src = a, *dst = tmp;                                                      \
+    for (int w = MULTI_SORT_RUN_V2; w < n; w *= 2) { /* Bottom-up merges, ping-ponging */  \
+        for (int lo = 0; lo < n; lo += 2 * w) {                                            \
+            int mid = lo + w < n ? lo + w : n, hi = lo + 2 * w < n ? lo + 2 * w : n;       \
+            int i = lo, j = mid, k = lo;                                                   \
+            while (i < mid && j < hi)                                                      \
+                dst[k++] = multi_cmp_##tag##_v2(&src[j], &src[i], dir) < 0 ? src[j++] : src[i++]; \
+            while (i < mid) dst[k++] = src[i++];                                           \
+            while (j < hi) dst[k++] = src[j++];                                            \
+        }                                                                                  \
+        MultiKey_v2 *t = src; src = dst; dst = t;                                          \
+    }                                                                                      \
+    if (src != a) memcpy(a, src, n * sizeof(MultiKey_v2));                                 \
+}
+
+DEFINE_MULTI_SORT_V2(n, name, none, none)
+DEFINE_MULTI_SORT_V2(p, phone, none, none)
+DEFINE_MULTI_SORT_V2(e, email, none, none)
+DEFINE_MULTI_SORT_V2(np, name, phone, none)
+DEFINE_MULTI_SORT_V2(ne, name, email, none)
+DEFINE_MULTI_SORT_V2(pn, phone, name, none)
+DEFINE_MULTI_SORT_V2(pe, phone, email, none)
+DEFINE_MULTI_SORT_V2(en, email, name, none)
+DEFINE_MULTI_SORT_V2(ep, email, phone, none)
+DEFINE_MULTI_SORT_V2(npe, name, phone, email)
+DEFINE_MULTI_SORT_V2(nep, name, email, phone)
+DEFINE_MULTI_SORT_V2(pne, phone, name, email)
+DEFINE_MULTI_SORT_V2(pen, phone, email, name)
+DEFINE_MULTI_SORT_V2(enp, email, name, phone)
+DEFINE_MULTI_SORT_V2(epn, email, phone, name)
+
+// Indexed by field (1=name, 2=phone, 3=email; 0 = no further key).
+static const MultiSortKernel_v2 s_multi_kernels_v2[4][4][4] = {
+    [1][0][0] = multi_sort_n_v2,   [2][0][0] = multi_sort_p_v2,   [3][0][0] = multi_sort_e_v2,
+    [1][2][0] = multi_sort_np_v2,  [1][3][0] = multi_sort_ne_v2,  [2][1][0] = multi_sort_pn_v2,
+    [2][3][0] = multi_sort_pe_v2,  [3][1][0] = multi_sort_en_v2,  [3][2][0] = multi_sort_ep_v2,
+    [1][2][3] = multi_sort_npe_v2, [1][3][2] = multi_sort_nep_v2, [2][1][3] = multi_sort_pne_v2,
+    [2][3][1] = multi_sort_pen_v2, [3][1][2] = multi_sort_enp_v2, [3][2][1] = multi_sort_epn_v2,
+};
+
+static const size_t s_multi_field_offs_v2[VIEW_FIELDS_V2] = { offsetof(Node, name_key), offsetof(Node, phone), offsetof(Node, email_key) };
+
+// Splits a key list into fields and directions; 0 if it is not a valid tuple.
+static int multi_keys_parse_v2(const int *keys, int key_count, int field[3], int dir[3]) {
+    if (!keys || key_count < 1 || key_count > VIEW_FIELDS_V2) return 0;
+    for (int i = 0; i < 3; i++) { field[i] = 0; dir[i] = 1; }
+    for (int i = 0; i < key_count; i++) {
+        int f = keys[i] < 0 ? -keys[i] : keys[i];
+        if (f < 1 || f > VIEW_FIELDS_V2) return 0;
+        for (int j = 0; j < i; j++) if (field[j] == f) return 0; // Repeated key
+        field[i] = f;
+        dir[i] = keys[i] < 0 ? -1 : 1;
     }
-    current_tail = result_head;
+    return 1;
+}
 
-    // Iterate through the rest of the lists
-    while (a && b) {
-        if (cmp(a, b)) {
-            current_tail->next = a;
-            current_tail = a;
-            a = a->next;
-        } else {
-            current_tail->next = b;
-            current_tail = b;
-            b = b->next;
+static void multi_key_load_v2(MultiKey_v2 *k, Node *p, const int field[3]) {
+    k->prefix = engine_key_prefix((const char*)p + s_multi_field_offs_v2[field[0] - 1]);
+    k->prefix2 = field[1] ? engine_key_prefix((const char*)p + s_multi_field_offs_v2[field[1] - 1]) : 0;
+    k->node = p;
+}
+
+API int lib_v2_sort_contacts_by_keys(const int* keys, int key_count) {
+    int field[3], dir[3];
+    if (!multi_keys_parse_v2(keys, key_count, field, dir)) return -1;
+    if (s_count_v2 < 2 || !s_head_v2) return 0;
+    scan_invalidate_v2();
+
+    MultiKey_v2 *a = (MultiKey_v2*)malloc(s_count_v2 * sizeof(MultiKey_v2));
+    MultiKey_v2 *tmp = (MultiKey_v2*)malloc(s_count_v2 * sizeof(MultiKey_v2));
+    if (!a || !tmp) { free(a); free(tmp); return -1; }
+    int n = 0;
+    for (Node *p = s_head_v2; p && n < s_count_v2; p = p->next, n++) multi_key_load_v2(&a[n], p, field);
+    s_multi_kernels_v2[field[0]][field[1]][field[2]](a, tmp, n, dir);
+
+    for (int i = 0; i < n - 1; i++) a[i].node->next = a[i + 1].node;
+    a[n - 1].node->next = NULL;
+    s_head_v2 = a[0].node;
+    list_relink_prev_v2();
+    free(a); free(tmp);
+    return 0;
+}
+
+// --- External Sort ---
+// Sorts a contact CSV that may not fit in memory, without touching the loaded
+// list. Input is read in runs that fit the memory budget; each run is parsed
+// into Nodes, ordered with the multi-key kernel for the key tuple and spilled
+// to an anonymous temp file as fixed-size binary records. Runs are then k-way
+// merged through a loser tree (one comparison per tree level per record), with
+// run index as the tie-break so the whole sort is stable. If there are more
+// runs than the budget allows open buffers for, groups of runs are merged into
+// longer runs first. The first input line is skipped on load just as in
+// lib_v2_initialize, so it is copied to the output unchanged.
+#define EXT_SORT_DEFAULT_BUDGET_V2 ((size_t)64 << 20)
+#define EXT_SORT_DEFAULT_IO_V2     ((size_t)1 << 20)
+#define EXT_SORT_MIN_IO_V2         ((size_t)4 << 10)
+#define EXT_SORT_MIN_RUN_V2        1024
+#define EXT_SORT_MAX_FAN_IN_V2     256
+
+typedef struct {
+    FILE *f;
+    Node rec;
+    MultiKey_v2 key;
+    int done;
+} ExtRun_v2;
+
+typedef struct {
+    ExtRun_v2 *runs;
+    int k;
+    int *tree; // tree[0] = current winner, tree[1..k-1] = loser at each match
+    const int *field, *dir;
+} LoserTree_v2;
+
+// Composite comparison for the merge; the merge is bound by I/O, so it walks
+// the key tuple at run time instead of needing a kernel per tuple.
+static int ext_key_cmp_v2(const MultiKey_v2 *a, const MultiKey_v2 *b, const int *field, const int *dir) {
+    for (int i = 0; i < 3 && field[i]; i++) {
+        int c;
+        uint64_t pa = i == 0 ? a->prefix : a->prefix2, pb = i == 0 ? b->prefix : b->prefix2;
+        if (i < 2 && pa != pb) c = pa < pb ? -1 : 1;
+        else if (i < 2 && (pa & 0xFF) == 0) c = 0;
+        else c = strcmp((const char*)a->node + s_multi_field_offs_v2[field[i] - 1],
+                        (const char*)b->node + s_multi_field_offs_v2[field[i] - 1]);
+        if (c != 0) return dir[i] < 0 ? -c : c;
+    }
+    return 0;
+}
+
+// Whether run a's current record goes out before run b's; exhausted runs lose.
+static int loser_beats_v2(const LoserTree_v2 *lt, int a, int b) {
+    if (lt->runs[a].done) return 0;
+    if (lt->runs[b].done) return 1;
+    int c = ext_key_cmp_v2(&lt->runs[a].key, &lt->runs[b].key, lt->field, lt->dir);
+    return c < 0 || (c == 0 && a < b);
+}
+
+// Leaves sit at k..2k-1, so internal node t plays children 2t and 2t+1.
+static int loser_build_v2(LoserTree_v2 *lt) {
+    int k = lt->k;
+    int *win = (int*)malloc(2 * k * sizeof(int));
+    if (!win) return 0;
+    for (int i = 0; i < k; i++) win[k + i] = i;
+    for (int t = k - 1; t >= 1; t--) {
+        int a = win[2 * t], b = win[2 * t + 1];
+        if (loser_beats_v2(lt, a, b)) { win[t] = a; lt->tree[t] = b; }
+        else { win[t] = b; lt->tree[t] = a; }
+    }
+    lt->tree[0] = k > 1 ? win[1] : 0;
+    free(win);
+    return 1;
+}
+
+// Replays the winner's path after its run advanced to its next record.
+static void loser_replay_v2(LoserTree_v2 *lt) {
+    int w = lt->tree[0];
+    for (int t = (w + lt->k) / 2; t > 0; t /= 2) {
+        if (loser_beats_v2(lt, lt->tree[t], w)) { int l = lt->tree[t]; lt->tree[t] = w; w = l; }
+    }
+    lt->tree[0] = w;
+}
+
+#define EXT_RECORD_BYTES_V2 offsetof(ContactRecord, id) // Node starts with a ContactRecord's text fields; runs hold just those
+
+static void ext_run_advance_v2(ExtRun_v2 *r, const int *field) {
+    if (fread(&r->rec, EXT_RECORD_BYTES_V2, 1, r->f) != 1) { r->done = 1; return; }
+    node_fold_keys_v2(&r->rec);
+    multi_key_load_v2(&r->key, &r->rec, field);
+}
+
+static int ext_write_record_v2(FILE *out, const Node *rec, int as_csv) {
+    if (as_csv) return fprintf(out, "%s,%s,%s\n", rec->name, rec->phone, rec->email) >= 0;
+    return fwrite(rec, EXT_RECORD_BYTES_V2, 1, out) == 1;
+}
+
+// Merges the k run files into out; 0 on success, -2 out of memory, -4 I/O error.
+static int ext_merge_runs_v2(FILE **files, int k, FILE *out, int as_csv, const int *field, const int *dir) {
+    ExtRun_v2 *runs = (ExtRun_v2*)calloc(k, sizeof(ExtRun_v2));
+    int *tree = (int*)malloc(k * sizeof(int));
+    if (!runs || !tree) { free(runs); free(tree); return -2; }
+    for (int i = 0; i < k; i++) {
+        runs[i].f = files[i];
+        rewind(files[i]);
+        ext_run_advance_v2(&runs[i], field);
+    }
+    LoserTree_v2 lt = { .runs = runs, .k = k, .tree = tree, .field = field, .dir = dir };
+    int rc = loser_build_v2(&lt) ? 0 : -2;
+    while (rc == 0 && !runs[tree[0]].done) {
+        ExtRun_v2 *r = &runs[tree[0]];
+        if (!ext_write_record_v2(out, &r->rec, as_csv)) rc = -4;
+        ext_run_advance_v2(r, field);
+        loser_replay_v2(&lt);
+    }
+    for (int i = 0; rc == 0 && i < k; i++) if (ferror(files[i])) rc = -4;
+    free(runs); free(tree);
+    return rc;
+}
+
+static FILE *ext_open_buffered_v2(FILE *f, size_t io_size) {
+    if (f) setvbuf(f, NULL, _IOFBF, io_size);
+    return f;
+}
+
+API int lib_v2_sort_csv_external(const char* in_path, const char* out_path, const int* keys, int key_count,
+                                 size_t memory_budget, size_t io_buffer_size) {
+    int field[3], dir[3];
+    if (!in_path || !out_path || !multi_keys_parse_v2(keys, key_count, field, dir)) return -1;
+    if (memory_budget == 0) memory_budget = EXT_SORT_DEFAULT_BUDGET_V2;
+    if (io_buffer_size == 0) io_buffer_size = EXT_SORT_DEFAULT_IO_V2;
+    if (io_buffer_size < EXT_SORT_MIN_IO_V2) io_buffer_size = EXT_SORT_MIN_IO_V2;
+
+    // A run holds the parsed Nodes plus the key array and its merge scratch.
+    size_t per_record = sizeof(Node) + 2 * sizeof(MultiKey_v2);
+    size_t run_budget = memory_budget > 2 * io_buffer_size ? memory_budget - 2 * io_buffer_size : 0;
+    int run_cap = run_budget / per_record > INT32_MAX ? INT32_MAX : (int)(run_budget / per_record);
+    if (run_cap < EXT_SORT_MIN_RUN_V2) run_cap = EXT_SORT_MIN_RUN_V2;
+    int fan_in = (int)(memory_budget / io_buffer_size) - 1; // One buffer is the output's
+    if (fan_in > EXT_SORT_MAX_FAN_IN_V2) fan_in = EXT_SORT_MAX_FAN_IN_V2;
+    if (fan_in < 2) fan_in = 2;
+
+    FILE *in = ext_open_buffered_v2(fopen(in_path, "r"), io_buffer_size);
+    if (!in) return -3;
+    FILE *out = ext_open_buffered_v2(fopen(out_path, "w"), io_buffer_size);
+    if (!out) { fclose(in); return -4; }
+
+    Node *recs = (Node*)malloc(run_cap * sizeof(Node));
+    MultiKey_v2 *a = (MultiKey_v2*)malloc(run_cap * sizeof(MultiKey_v2));
+    MultiKey_v2 *tmp = (MultiKey_v2*)malloc(run_cap * sizeof(MultiKey_v2));
+    FILE **files = NULL;
+    int nfiles = 0, cap_files = 0, rc = 0;
+    if (!recs || !a || !tmp) rc = -2;
+
+    char line[256];
+    if (rc == 0 && fgets(line, sizeof(line), in) && fputs(line, out) < 0) rc = -4; // Header passes through
+
+    // Phase 1: sorted runs. A single run goes straight to the output as CSV.
+    int eof = 0;
+    while (rc == 0 && !eof) {
+        int n = 0;
+        EngineRecord parsed;
+        while (n < run_cap && fgets(line, sizeof(line), in)) {
+            if (engine_parse_csv_line(line, &parsed)) {
+                node_from_record_v2(&recs[n], &parsed);
+                multi_key_load_v2(&a[n], &recs[n], field);
+                n++;
+            }
+        }
+        eof = n < run_cap;
+        if (ferror(in)) { rc = -4; break; }
+        if (n == 0 && nfiles > 0) break;
+        s_multi_kernels_v2[field[0]][field[1]][field[2]](a, tmp, n, dir);
+
+        FILE *dst = out;
+        if (!(eof && nfiles == 0)) {
+            if (nfiles == cap_files) {
+                int new_cap = cap_files ? cap_files * 2 : 16;
+                FILE **grown = (FILE**)realloc(files, new_cap * sizeof(FILE*));
+                if (!grown) { rc = -2; break; }
+                files = grown; cap_files = new_cap;
+            }
+            dst = ext_open_buffered_v2(tmpfile(), io_buffer_size);
+            if (!dst) { rc = -4; break; }
+            files[nfiles++] = dst;
         }
+        for (int i = 0; i < n && rc == 0; i++) if (!ext_write_record_v2(dst, a[i].node, dst == out)) rc = -4;
     }
+    free(recs); free(a); free(tmp);
+    fclose(in);
 
-    // Append remaining nodes of a or b
-    if (a) {
-        current_tail->next = a;
-    } else if (b) {
-        current_tail->next = b;
+    // Phase 2: merge passes until one pass can take every remaining run.
+    while (rc == 0 && nfiles > fan_in) {
+        int merged = 0;
+        for (int lo = 0; rc == 0 && lo < nfiles; lo += fan_in) {
+            int k = nfiles - lo < fan_in ? nfiles - lo : fan_in;
+            FILE *run = ext_open_buffered_v2(tmpfile(), io_buffer_size);
+            if (!run) { rc = -4; break; }
+            rc = ext_merge_runs_v2(files + lo, k, run, 0, field, dir);
+            for (int i = 0; i < k; i++) { fclose(files[lo + i]); files[lo + i] = NULL; }
+            files[merged++] = run;
+        }
+        for (int i = merged; i < nfiles; i++) if (files[i]) fclose(files[i]);
+        nfiles = merged;
     }
-    // The last node's next will be NULL if both a and b are exhausted,
-    // or it will point to the rest of the appended list.
+    if (rc == 0 && nfiles > 0) rc = ext_merge_runs_v2(files, nfiles, out, 1, field, dir);
 
-    return result_head;
+    for (int i = 0; i < nfiles; i++) if (files[i]) fclose(files[i]);
+    free(files);
+    if (fclose(out) != 0 && rc == 0) rc = -4;
+    return rc;
 }
 
+// --- Sorted Pages ---
+// A page of the order lib_v2_sort_contacts(field) would produce, without sorting
+// or relinking the list. A built view is read directly (O(log n + limit));
+// otherwise the nodes' fields are gathered into an array in id order and
+// engine_sort_page() orders just the page (O(n + limit log limit)), ties in id
+// order as lib_v2_sort_contacts leaves them.
+API ContactRecord* lib_v2_get_sorted_page(int field, int offset, int limit, int* out_count) {
+    if (!out_count) return NULL;
+    *out_count = 0;
+    if (field < 1 || field > VIEW_FIELDS_V2 || offset < 0 || limit <= 0 || offset >= s_count_v2) return NULL;
+    if (limit > s_count_v2 - offset) limit = s_count_v2 - offset;
+
+    ContactRecord* page = (ContactRecord*)malloc(limit * sizeof(ContactRecord));
+    if (!page) return NULL;
+
+    const EngineView *v = &s_views_v2[field - 1];
+    if (v->built) {
+        EngineViewNode *t = engine_view_select(v, offset);
+        for (int i = 0; i < limit; i++, t = engine_view_next(t)) copy_record_v2(&page[i], VIEW_REC_V2(t));
+    } else {
+        int n = 0;
+        Node **by_id = nodes_by_id_v2(&n);
+        const char **strs = (const char**)malloc(s_count_v2 * sizeof(const char*));
+        EngineKey *keys = (EngineKey*)malloc(s_count_v2 * sizeof(EngineKey));
+        if (!by_id || !strs || !keys || offset >= n) {
+            free(by_id); free(strs); free(keys); free(page);
+            return NULL;
+        }
+        for (int i = 0; i < n; i++) strs[i] = (const char*)by_id[i] + v->field_off;
+        free(by_id);
+        if (limit > n - offset) limit = n - offset;
+        engine_sort_page(keys, strs, n, offset, limit);
+        for (int i = 0; i < limit; i++)
+            copy_record_v2(&page[i], (const Node*)(strs[keys[offset + i].idx] - v->field_off));
+        free(strs); free(keys);
+    }
+
+    *out_count = limit;
+    return page;
+}
 
-// mergeSort_v2 now calls the iterative merge
-static Node *mergeSort_v2(Node *h, int (*cmp)(Node*,Node*)) {
-    if (!h || !h->next) return h;
-    Node *a = NULL, *b = NULL; 
-    frontBackSplit_v2(h, &a, &b);
-    
-    a = mergeSort_v2(a, cmp);
-    b = mergeSort_v2(b, cmp);
-    
-    // Call the iterative merge function
-    return sortedMerge_v2_iterative(a, b, cmp); 
+API void lib_v2_set_sort_parallelism(int threshold, int threads) {
+    s_sort_parallel_threshold_v2 = threshold > 0 ? threshold : ENGINE_SORT_PARALLEL_THRESHOLD;
+    s_sort_threads_v2 = threads > 0 ? threads : 0;
 }
 
-// lib_v2_sort_contacts remains the same, it will use the updated mergeSort_v2
-API int lib_v2_sort_contacts(int sort_type) {
-    if (s_count_v2 < 2 || !s_head_v2) return 0; 
-
-    int (*compare_func)(Node*, Node*) = NULL;
-    if (sort_type == 1) compare_func = cmpName_v2;
-    else if (sort_type == 2) compare_func = cmpPhone_v2;
-    else if (sort_type == 3) compare_func = cmpEmail_v2;
-    else return -1; 
-    
-    s_head_v2 = mergeSort_v2(s_head_v2, compare_func);
-    
-    // IMPORTANT: After sorting, the number of nodes SHOULD be the same.
-    // If nodes are lost, s_count_v2 would be an overestimate.
-    // A robust solution would be to re-count the nodes after sort if loss is suspected,
-    // or ensure the sort is provably correct.
-    // For now, we assume sort preserves count if correct.
-    // If after this change, count is still wrong, then mergeSort_v2 or frontBackSplit_v2
-    // are still losing nodes.
-    
-    // To verify count after sort (for debugging, can be removed later):
-    /*
-    int actual_count_after_sort = 0;
-    Node* temp_counter = s_head_v2;
-    while(temp_counter) {
-        actual_count_after_sort++;
-        temp_counter = temp_counter->next;
-    }
-    if (s_count_v2 != actual_count_after_sort) {
-        // This indicates nodes were lost during sort!
-        // You could log this or handle it. For now, update the count.
-        // printf("Warning: Node count mismatch after sort. Original: %d, After sort: %d\n", s_count_v2, actual_count_after_sort);
-        s_count_v2 = actual_count_after_sort;
-    }
-    */
-    return 0; 
+API void lib_v2_set_search_parallelism(int threshold, int threads) {
+    s_search_parallel_threshold_v2 = threshold > 0 ? threshold : PARALLEL_SEARCH_THRESHOLD_V2;
+    s_search_threads_v2 = threads > 0 ? threads : 0;
 }
 
 // ... (lib_v2_save_contacts and other API functions remain the same as before) ...
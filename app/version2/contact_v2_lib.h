@@ -5,6 +5,8 @@
 #include <stdio.h> // For FILE if used in struct, or for general use
 #include <stdlib.h> // For malloc, free
 #include <string.h> // For strcpy, strcmp, etc.
+#include <stdint.h> // For uint64_t in Node
+#include "engine.h" // For EngineSoundEntry in Node and EngineQuery
 // Add any other standard headers your Node struct or API functions might need implicitly
 
 #ifdef _WIN32
@@ -19,7 +21,15 @@ typedef struct Node {
     char name[50];
     char phone[50];
     char email[50];
+    char name_key[50];  // Case-folded shadows of name and email, kept in step on every write;
+    char email_key[50]; // duplicate checks, lookups, search and sort compare these
     struct Node *next;
+    struct Node *prev;        // Kept in step with next so a record found by id unlinks in O(1)
+    uint64_t id;              // Stable record id, see lib_v2_get_contact_by_id
+    uint64_t list_rank;       // Ascends along the list, so view seeks can return hits in list order
+    struct Node *email_next;  // Next node in this node's email index bucket
+    struct ViewNode *view[3]; // This record's entry in each sorted view (name, phone, email), when built
+    EngineSoundEntry sound;   // Soundex codes of the first name words and their index slots, for search_type 4
 } Node;
 // >>>>> END CRUCIAL PART <<<<<
 
@@ -30,19 +40,54 @@ typedef struct {
     char name[50];
     char phone[50];
     char email[50];
+    uint64_t id; // Stable record id (see lib_v2_get_contact_by_id); never reused while the library is loaded
 } ContactRecord;
 
+typedef EngineQuery ContactQuery_v2; // Compiled query (the engine's), see lib_v2_query_compile
+
 // API Function Declarations
 API int lib_v2_initialize(const char* data_file_path);
 API void lib_v2_cleanup();
 // ... rest of the API function declarations ...
 API char* lib_v2_add_contact(const char* name, const char* phone, const char* email);
 API char* lib_v2_edit_contact(const char* old_email_id, const char* new_name, const char* new_phone, const char* new_email);
+API char* lib_v2_add_contact_id(const char* name, const char* phone, const char* email, uint64_t* out_id); // As add; *out_id gets the new record's id (0 on error)
+// By record id, O(1) whatever the book size: get returns 0 and fills *out, or -1 if there is no such record;
+// edit returns a status message like lib_v2_edit_contact; delete returns 0, or -1 if not found.
+API int lib_v2_get_contact_by_id(uint64_t id, ContactRecord* out);
+API char* lib_v2_edit_contact_by_id(uint64_t id, const char* new_name, const char* new_phone, const char* new_email);
+API int lib_v2_delete_contact_by_id(uint64_t id);
 API ContactRecord* lib_v2_get_all_contacts(int* out_count);
-API ContactRecord* lib_v2_search_contacts(const char* query, int search_type, int* out_count);
+API ContactRecord* lib_v2_search_contacts(const char* query, int search_type, int* out_count); // search_type: 1=name, 2=phone, 3=email, 4=name sounds like
+// Regex search over one field (1=name, 2=phone, 3=email), case-insensitive. Returns NULL with
+// *out_error set (free with lib_v2_free_string) if the pattern does not compile.
+API ContactRecord* lib_v2_search_contacts_regex(const char* pattern, int search_type, int* out_count, char** out_error);
+// Names within max_distance edits (0-2) of name, case-insensitive, closest first.
+API ContactRecord* lib_v2_search_contacts_fuzzy(const char* name, int max_distance, int* out_count);
+// Boolean queries, e.g. `name contains smith AND email suffix "@gmail.com"`. compile returns NULL on a
+// syntax error and, if out_error is given, a message to free with lib_v2_free_string.
+API ContactQuery_v2* lib_v2_query_compile(const char* text, char** out_error);
+API ContactRecord* lib_v2_query_run(const ContactQuery_v2* query, int* out_count); // Free with lib_v2_free_contact_records
+API void lib_v2_query_free(ContactQuery_v2* query);
 API int lib_v2_delete_contact_by_email(const char* email);
 API int lib_v2_delete_all_contacts();
+// Delete, or set name and/or phone (NULL: keep) on, every contact the query matches, in one pass.
+// Return the number affected; -1 bad arguments, -2 invalid name, -3 invalid phone.
+API int lib_v2_delete_contacts_where(const ContactQuery_v2* query);
+API int lib_v2_update_contacts_where(const ContactQuery_v2* query, const char* new_name, const char* new_phone);
+// Insert-or-update keyed on email (case-insensitive), one index probe per row; rows equal to the stored
+// contact are not written. Row ids are ignored. Any out_* may be NULL. Returns the number of rows rejected
+// for invalid fields; -1 bad arguments, -2 out of memory (rows before the failing one are applied).
+API int lib_v2_upsert_contacts(const ContactRecord* rows, int row_count, int* out_inserted, int* out_updated, int* out_unchanged);
 API int lib_v2_sort_contacts(int sort_type);
+API int lib_v2_sort_contacts_by_keys(const int* keys, int key_count); // Stable; keys are 1=name, 2=phone, 3=email, negated for descending
+// Sorts in_path into out_path in bounded memory (0 = default 64 MiB budget / 1 MiB I/O buffers); keys as above.
+// Returns 0, -1 bad arguments, -2 out of memory, -3 input not readable, -4 output or temp file I/O error.
+API int lib_v2_sort_csv_external(const char* in_path, const char* out_path, const int* keys, int key_count,
+                                 size_t memory_budget, size_t io_buffer_size);
+API ContactRecord* lib_v2_get_sorted_page(int field, int offset, int limit, int* out_count); // Rows [offset, offset+limit) in field order; free with lib_v2_free_contact_records
+API void lib_v2_set_sort_parallelism(int threshold, int threads); // Name/email sorts of >= threshold records use `threads` workers (<= 0: defaults)
+API void lib_v2_set_search_parallelism(int threshold, int threads); // Searches of >= threshold records scan on `threads` workers (<= 0: defaults)
 API int lib_v2_save_contacts(const char* data_file_path);
 API int lib_v2_is_valid_name(const char* name);
 API int lib_v2_is_valid_number(const char* number);
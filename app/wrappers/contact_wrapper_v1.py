@@ -7,7 +7,8 @@ import platform
 class ContactRecord(ctypes.Structure):
     _fields_ = [("name", ctypes.c_char * 50),
                 ("phone", ctypes.c_char * 50),
-                ("email", ctypes.c_char * 50)]
+                ("email", ctypes.c_char * 50),
+                ("id", ctypes.c_uint64)]
 
 # contact_wrapper_v1.py
 # ... (imports and ContactRecord class definition remain the same) ...
@@ -78,6 +79,22 @@ c_lib.lib_v1_add_contact.restype = ctypes.POINTER(ctypes.c_char) # Using POINTER
 c_lib.lib_v1_edit_contact.argtypes = [ctypes.c_char_p, ctypes.c_char_p, ctypes.c_char_p, ctypes.c_char_p]
 c_lib.lib_v1_edit_contact.restype = ctypes.POINTER(ctypes.c_char)
 
+# API char* lib_v1_add_contact_id(const char* name, const char* phone, const char* email, uint64_t* out_id);
+c_lib.lib_v1_add_contact_id.argtypes = [ctypes.c_char_p, ctypes.c_char_p, ctypes.c_char_p, ctypes.POINTER(ctypes.c_uint64)]
+c_lib.lib_v1_add_contact_id.restype = ctypes.POINTER(ctypes.c_char)
+
+# API int lib_v1_get_contact_by_id(uint64_t id, ContactRecord* out);
+c_lib.lib_v1_get_contact_by_id.argtypes = [ctypes.c_uint64, ctypes.POINTER(ContactRecord)]
+c_lib.lib_v1_get_contact_by_id.restype = ctypes.c_int
+
+# API char* lib_v1_edit_contact_by_id(uint64_t id, const char* new_name, const char* new_phone, const char* new_email);
+c_lib.lib_v1_edit_contact_by_id.argtypes = [ctypes.c_uint64, ctypes.c_char_p, ctypes.c_char_p, ctypes.c_char_p]
+c_lib.lib_v1_edit_contact_by_id.restype = ctypes.POINTER(ctypes.c_char)
+
+# API int lib_v1_delete_contact_by_id(uint64_t id);
+c_lib.lib_v1_delete_contact_by_id.argtypes = [ctypes.c_uint64]
+c_lib.lib_v1_delete_contact_by_id.restype = ctypes.c_int
+
 # API ContactRecord* lib_v1_get_all_contacts(int* out_count);
 c_lib.lib_v1_get_all_contacts.argtypes = [ctypes.POINTER(ctypes.c_int)]
 c_lib.lib_v1_get_all_contacts.restype = ctypes.POINTER(ContactRecord)
@@ -86,6 +103,10 @@ c_lib.lib_v1_get_all_contacts.restype = ctypes.POINTER(ContactRecord)
 c_lib.lib_v1_search_contacts.argtypes = [ctypes.c_char_p, ctypes.c_int, ctypes.POINTER(ctypes.c_int)]
 c_lib.lib_v1_search_contacts.restype = ctypes.POINTER(ContactRecord)
 
+# API ContactRecord* lib_v1_search_contacts_regex(const char* pattern, int search_type, int* out_count, char** out_error);
+c_lib.lib_v1_search_contacts_regex.argtypes = [ctypes.c_char_p, ctypes.c_int, ctypes.POINTER(ctypes.c_int), ctypes.POINTER(ctypes.POINTER(ctypes.c_char))]
+c_lib.lib_v1_search_contacts_regex.restype = ctypes.POINTER(ContactRecord)
+
 # API int lib_v1_delete_contact_by_email(const char* email);
 c_lib.lib_v1_delete_contact_by_email.argtypes = [ctypes.c_char_p]
 c_lib.lib_v1_delete_contact_by_email.restype = ctypes.c_int
@@ -94,10 +115,26 @@ c_lib.lib_v1_delete_contact_by_email.restype = ctypes.c_int
 c_lib.lib_v1_delete_all_contacts.argtypes = []
 c_lib.lib_v1_delete_all_contacts.restype = ctypes.c_int
 
+# API int lib_v1_delete_contacts_regex(const char* pattern, int search_type, char** out_error);
+c_lib.lib_v1_delete_contacts_regex.argtypes = [ctypes.c_char_p, ctypes.c_int, ctypes.POINTER(ctypes.POINTER(ctypes.c_char))]
+c_lib.lib_v1_delete_contacts_regex.restype = ctypes.c_int
+
+# API int lib_v1_update_contacts_regex(const char* pattern, int search_type, const char* new_name, const char* new_phone, char** out_error);
+c_lib.lib_v1_update_contacts_regex.argtypes = [ctypes.c_char_p, ctypes.c_int, ctypes.c_char_p, ctypes.c_char_p, ctypes.POINTER(ctypes.POINTER(ctypes.c_char))]
+c_lib.lib_v1_update_contacts_regex.restype = ctypes.c_int
+
 # API int lib_v1_sort_contacts(int sort_type);
 c_lib.lib_v1_sort_contacts.argtypes = [ctypes.c_int]
 c_lib.lib_v1_sort_contacts.restype = ctypes.c_int
 
+# API ContactRecord* lib_v1_get_sorted_page(int field, int offset, int limit, int* out_count);
+c_lib.lib_v1_get_sorted_page.argtypes = [ctypes.c_int, ctypes.c_int, ctypes.c_int, ctypes.POINTER(ctypes.c_int)]
+c_lib.lib_v1_get_sorted_page.restype = ctypes.POINTER(ContactRecord)
+
+# API void lib_v1_set_sort_parallelism(int threshold, int threads);
+c_lib.lib_v1_set_sort_parallelism.argtypes = [ctypes.c_int, ctypes.c_int]
+c_lib.lib_v1_set_sort_parallelism.restype = None
+
 # API int lib_v1_save_contacts(const char* data_file_path);
 c_lib.lib_v1_save_contacts.argtypes = [ctypes.c_char_p]
 c_lib.lib_v1_save_contacts.restype = ctypes.c_int
@@ -166,6 +203,14 @@ def edit_contact(old_email_id, new_name, new_phone, new_email):
     )
     return _c_char_p_to_py_string(result_ptr)
 
+def _record_to_dict(record_c):
+    return {
+        "id": record_c.id,
+        "name": record_c.name.decode('utf-8', 'replace'),
+        "phone": record_c.phone.decode('utf-8', 'replace'),
+        "email": record_c.email.decode('utf-8', 'replace')
+    }
+
 def _c_records_to_py_list(c_records_ptr, count_val):
     if not c_records_ptr or count_val == 0:
         if c_records_ptr: # If ptr exists but count is 0, still needs free if C allocated.
@@ -175,12 +220,7 @@ def _c_records_to_py_list(c_records_ptr, count_val):
     py_list = []
     try:
         for i in range(count_val):
-            record_c = c_records_ptr[i]
-            py_list.append({
-                "name": record_c.name.decode('utf-8', 'replace'),
-                "phone": record_c.phone.decode('utf-8', 'replace'),
-                "email": record_c.email.decode('utf-8', 'replace')
-            })
+            py_list.append(_record_to_dict(c_records_ptr[i]))
     finally:
         c_lib.lib_v1_free_contact_records(c_records_ptr, count_val) # Free the C array
     return py_list
@@ -195,15 +235,71 @@ def search_contacts(query, search_type): # search_type: 1=name, 2=phone, 3=email
     c_records_ptr = c_lib.lib_v1_search_contacts(query.encode('utf-8'), ctypes.c_int(search_type), ctypes.byref(count))
     return _c_records_to_py_list(c_records_ptr, count.value)
 
+def search_contacts_regex(pattern, search_type): # e.g. ("^70.*61$", 2); raises ValueError on a bad pattern
+    count = ctypes.c_int()
+    error = ctypes.POINTER(ctypes.c_char)()
+    c_records_ptr = c_lib.lib_v1_search_contacts_regex(pattern.encode('utf-8'), ctypes.c_int(search_type), ctypes.byref(count), ctypes.byref(error))
+    if error:
+        raise ValueError(_c_char_p_to_py_string(error))
+    return _c_records_to_py_list(c_records_ptr, count.value)
+
 def delete_contact_by_email(email):
     return c_lib.lib_v1_delete_contact_by_email(email.encode('utf-8')) == 0
 
+def add_contact_id(name, phone, email): # Returns (message, id); id is None if the add failed
+    new_id = ctypes.c_uint64()
+    result_ptr = c_lib.lib_v1_add_contact_id(name.encode('utf-8'), phone.encode('utf-8'), email.encode('utf-8'), ctypes.byref(new_id))
+    return _c_char_p_to_py_string(result_ptr), (new_id.value or None)
+
+def get_contact_by_id(contact_id): # The contact as a dict, or None
+    record = ContactRecord()
+    if c_lib.lib_v1_get_contact_by_id(contact_id, ctypes.byref(record)) != 0:
+        return None
+    return _record_to_dict(record)
+
+def edit_contact_by_id(contact_id, new_name, new_phone, new_email):
+    result_ptr = c_lib.lib_v1_edit_contact_by_id(contact_id, new_name.encode('utf-8'), new_phone.encode('utf-8'), new_email.encode('utf-8'))
+    return _c_char_p_to_py_string(result_ptr)
+
+def delete_contact_by_id(contact_id):
+    return c_lib.lib_v1_delete_contact_by_id(contact_id) == 0
+
 def delete_all_contacts():
     return c_lib.lib_v1_delete_all_contacts() == 0
 
+_BULK_ERRORS = {-2: "Error: Invalid new name format.", -3: "Error: Invalid new phone number."}
+
+def _bulk_result(result, error):
+    if error:
+        raise ValueError(_c_char_p_to_py_string(error))
+    if result < 0:
+        raise ValueError(_BULK_ERRORS.get(result, "Error: Invalid arguments."))
+    return result
+
+def delete_contacts_regex(pattern, search_type): # e.g. (r"@retired\.com$", 3); returns how many were deleted
+    error = ctypes.POINTER(ctypes.c_char)()
+    result = c_lib.lib_v1_delete_contacts_regex(pattern.encode('utf-8'), ctypes.c_int(search_type), ctypes.byref(error))
+    return _bulk_result(result, error)
+
+def update_contacts_regex(pattern, search_type, new_name=None, new_phone=None): # None keeps the field; returns how many were updated
+    error = ctypes.POINTER(ctypes.c_char)()
+    result = c_lib.lib_v1_update_contacts_regex(pattern.encode('utf-8'), ctypes.c_int(search_type),
+                                                new_name.encode('utf-8') if new_name is not None else None,
+                                                new_phone.encode('utf-8') if new_phone is not None else None,
+                                                ctypes.byref(error))
+    return _bulk_result(result, error)
+
 def sort_contacts(sort_type): # sort_type: 1=name, 2=phone, 3=email
     return c_lib.lib_v1_sort_contacts(ctypes.c_int(sort_type)) == 0
 
+def get_sorted_page(field, offset, limit): # field: 1=name, 2=phone, 3=email
+    count = ctypes.c_int()
+    c_records_ptr = c_lib.lib_v1_get_sorted_page(ctypes.c_int(field), ctypes.c_int(offset), ctypes.c_int(limit), ctypes.byref(count))
+    return _c_records_to_py_list(c_records_ptr, count.value)
+
+def set_sort_parallelism(threshold=0, threads=0): # 0 keeps the library default
+    c_lib.lib_v1_set_sort_parallelism(ctypes.c_int(threshold), ctypes.c_int(threads))
+
 def save_contacts(data_file_path="../data/contacts.csv"):
     c_path = data_file_path.encode('utf-8') if data_file_path else None
     return c_lib.lib_v1_save_contacts(c_path) == 0
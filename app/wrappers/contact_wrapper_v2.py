@@ -8,7 +8,8 @@ import platform
 class ContactRecord(ctypes.Structure):
     _fields_ = [("name", ctypes.c_char * 50),
                 ("phone", ctypes.c_char * 50),
-                ("email", ctypes.c_char * 50)]
+                ("email", ctypes.c_char * 50),
+                ("id", ctypes.c_uint64)]
 
 # Determine library extension and attempt to load the C library
 lib_filename_base = "contact_v2_lib" # Changed for Version 2
@@ -75,6 +76,22 @@ c_lib.lib_v2_add_contact.restype = ctypes.POINTER(ctypes.c_char)
 c_lib.lib_v2_edit_contact.argtypes = [ctypes.c_char_p, ctypes.c_char_p, ctypes.c_char_p, ctypes.c_char_p]
 c_lib.lib_v2_edit_contact.restype = ctypes.POINTER(ctypes.c_char)
 
+# API char* lib_v2_add_contact_id(const char* name, const char* phone, const char* email, uint64_t* out_id);
+c_lib.lib_v2_add_contact_id.argtypes = [ctypes.c_char_p, ctypes.c_char_p, ctypes.c_char_p, ctypes.POINTER(ctypes.c_uint64)]
+c_lib.lib_v2_add_contact_id.restype = ctypes.POINTER(ctypes.c_char)
+
+# API int lib_v2_get_contact_by_id(uint64_t id, ContactRecord* out);
+c_lib.lib_v2_get_contact_by_id.argtypes = [ctypes.c_uint64, ctypes.POINTER(ContactRecord)]
+c_lib.lib_v2_get_contact_by_id.restype = ctypes.c_int
+
+# API char* lib_v2_edit_contact_by_id(uint64_t id, const char* new_name, const char* new_phone, const char* new_email);
+c_lib.lib_v2_edit_contact_by_id.argtypes = [ctypes.c_uint64, ctypes.c_char_p, ctypes.c_char_p, ctypes.c_char_p]
+c_lib.lib_v2_edit_contact_by_id.restype = ctypes.POINTER(ctypes.c_char)
+
+# API int lib_v2_delete_contact_by_id(uint64_t id);
+c_lib.lib_v2_delete_contact_by_id.argtypes = [ctypes.c_uint64]
+c_lib.lib_v2_delete_contact_by_id.restype = ctypes.c_int
+
 # API ContactRecord* lib_v2_get_all_contacts(int* out_count);
 c_lib.lib_v2_get_all_contacts.argtypes = [ctypes.POINTER(ctypes.c_int)]
 c_lib.lib_v2_get_all_contacts.restype = ctypes.POINTER(ContactRecord)
@@ -83,6 +100,26 @@ c_lib.lib_v2_get_all_contacts.restype = ctypes.POINTER(ContactRecord)
 c_lib.lib_v2_search_contacts.argtypes = [ctypes.c_char_p, ctypes.c_int, ctypes.POINTER(ctypes.c_int)]
 c_lib.lib_v2_search_contacts.restype = ctypes.POINTER(ContactRecord)
 
+# API ContactRecord* lib_v2_search_contacts_regex(const char* pattern, int search_type, int* out_count, char** out_error);
+c_lib.lib_v2_search_contacts_regex.argtypes = [ctypes.c_char_p, ctypes.c_int, ctypes.POINTER(ctypes.c_int), ctypes.POINTER(ctypes.POINTER(ctypes.c_char))]
+c_lib.lib_v2_search_contacts_regex.restype = ctypes.POINTER(ContactRecord)
+
+# API ContactRecord* lib_v2_search_contacts_fuzzy(const char* name, int max_distance, int* out_count);
+c_lib.lib_v2_search_contacts_fuzzy.argtypes = [ctypes.c_char_p, ctypes.c_int, ctypes.POINTER(ctypes.c_int)]
+c_lib.lib_v2_search_contacts_fuzzy.restype = ctypes.POINTER(ContactRecord)
+
+# API ContactQuery_v2* lib_v2_query_compile(const char* text, char** out_error);
+c_lib.lib_v2_query_compile.argtypes = [ctypes.c_char_p, ctypes.POINTER(ctypes.POINTER(ctypes.c_char))]
+c_lib.lib_v2_query_compile.restype = ctypes.c_void_p
+
+# API ContactRecord* lib_v2_query_run(const ContactQuery_v2* query, int* out_count);
+c_lib.lib_v2_query_run.argtypes = [ctypes.c_void_p, ctypes.POINTER(ctypes.c_int)]
+c_lib.lib_v2_query_run.restype = ctypes.POINTER(ContactRecord)
+
+# API void lib_v2_query_free(ContactQuery_v2* query);
+c_lib.lib_v2_query_free.argtypes = [ctypes.c_void_p]
+c_lib.lib_v2_query_free.restype = None
+
 # API int lib_v2_delete_contact_by_email(const char* email);
 c_lib.lib_v2_delete_contact_by_email.argtypes = [ctypes.c_char_p]
 c_lib.lib_v2_delete_contact_by_email.restype = ctypes.c_int
@@ -91,10 +128,42 @@ c_lib.lib_v2_delete_contact_by_email.restype = ctypes.c_int
 c_lib.lib_v2_delete_all_contacts.argtypes = []
 c_lib.lib_v2_delete_all_contacts.restype = ctypes.c_int
 
+# API int lib_v2_delete_contacts_where(const ContactQuery_v2* query);
+c_lib.lib_v2_delete_contacts_where.argtypes = [ctypes.c_void_p]
+c_lib.lib_v2_delete_contacts_where.restype = ctypes.c_int
+
+# API int lib_v2_update_contacts_where(const ContactQuery_v2* query, const char* new_name, const char* new_phone);
+c_lib.lib_v2_update_contacts_where.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_char_p]
+c_lib.lib_v2_update_contacts_where.restype = ctypes.c_int
+
+# API int lib_v2_upsert_contacts(const ContactRecord* rows, int row_count, int* out_inserted, int* out_updated, int* out_unchanged);
+c_lib.lib_v2_upsert_contacts.argtypes = [ctypes.POINTER(ContactRecord), ctypes.c_int, ctypes.POINTER(ctypes.c_int), ctypes.POINTER(ctypes.c_int), ctypes.POINTER(ctypes.c_int)]
+c_lib.lib_v2_upsert_contacts.restype = ctypes.c_int
+
 # API int lib_v2_sort_contacts(int sort_type);
 c_lib.lib_v2_sort_contacts.argtypes = [ctypes.c_int]
 c_lib.lib_v2_sort_contacts.restype = ctypes.c_int
 
+# API int lib_v2_sort_contacts_by_keys(const int* keys, int key_count);
+c_lib.lib_v2_sort_contacts_by_keys.argtypes = [ctypes.POINTER(ctypes.c_int), ctypes.c_int]
+c_lib.lib_v2_sort_contacts_by_keys.restype = ctypes.c_int
+
+# API int lib_v2_sort_csv_external(const char* in_path, const char* out_path, const int* keys, int key_count, size_t memory_budget, size_t io_buffer_size);
+c_lib.lib_v2_sort_csv_external.argtypes = [ctypes.c_char_p, ctypes.c_char_p, ctypes.POINTER(ctypes.c_int), ctypes.c_int, ctypes.c_size_t, ctypes.c_size_t]
+c_lib.lib_v2_sort_csv_external.restype = ctypes.c_int
+
+# API ContactRecord* lib_v2_get_sorted_page(int field, int offset, int limit, int* out_count);
+c_lib.lib_v2_get_sorted_page.argtypes = [ctypes.c_int, ctypes.c_int, ctypes.c_int, ctypes.POINTER(ctypes.c_int)]
+c_lib.lib_v2_get_sorted_page.restype = ctypes.POINTER(ContactRecord)
+
+# API void lib_v2_set_sort_parallelism(int threshold, int threads);
+c_lib.lib_v2_set_sort_parallelism.argtypes = [ctypes.c_int, ctypes.c_int]
+c_lib.lib_v2_set_sort_parallelism.restype = None
+
+# API void lib_v2_set_search_parallelism(int threshold, int threads);
+c_lib.lib_v2_set_search_parallelism.argtypes = [ctypes.c_int, ctypes.c_int]
+c_lib.lib_v2_set_search_parallelism.restype = None
+
 # API int lib_v2_save_contacts(const char* data_file_path);
 c_lib.lib_v2_save_contacts.argtypes = [ctypes.c_char_p]
 c_lib.lib_v2_save_contacts.restype = ctypes.c_int
@@ -149,6 +218,14 @@ def edit_contact(old_email_id, new_name, new_phone, new_email):
     )
     return _c_char_p_to_py_string_and_free(result_ptr)
 
+def _record_to_dict(record_c):
+    return {
+        "id": record_c.id,
+        "name": record_c.name.decode('utf-8', 'replace'),
+        "phone": record_c.phone.decode('utf-8', 'replace'),
+        "email": record_c.email.decode('utf-8', 'replace')
+    }
+
 def _c_records_to_py_list_and_free(c_records_ptr, count_val):
     if not c_records_ptr or count_val == 0:
         if c_records_ptr: c_lib.lib_v2_free_contact_records(c_records_ptr, count_val) # Calls lib_v2_
@@ -156,12 +233,7 @@ def _c_records_to_py_list_and_free(c_records_ptr, count_val):
     py_list = []
     try:
         for i in range(count_val):
-            record_c = c_records_ptr[i]
-            py_list.append({
-                "name": record_c.name.decode('utf-8', 'replace'),
-                "phone": record_c.phone.decode('utf-8', 'replace'),
-                "email": record_c.email.decode('utf-8', 'replace')
-            })
+            py_list.append(_record_to_dict(c_records_ptr[i]))
     finally: c_lib.lib_v2_free_contact_records(c_records_ptr, count_val) # Calls lib_v2_
     return py_list
 
@@ -170,20 +242,125 @@ def get_all_contacts():
     c_records_ptr = c_lib.lib_v2_get_all_contacts(ctypes.byref(count))
     return _c_records_to_py_list_and_free(c_records_ptr, count.value)
 
-def search_contacts(query, search_type): 
+def search_contacts(query, search_type): # search_type: 1=name, 2=phone, 3=email, 4=name sounds like
     count = ctypes.c_int()
     c_records_ptr = c_lib.lib_v2_search_contacts(query.encode('utf-8'), ctypes.c_int(search_type), ctypes.byref(count))
     return _c_records_to_py_list_and_free(c_records_ptr, count.value)
 
+def search_contacts_regex(pattern, search_type): # e.g. ("^70.*61$", 2); raises ValueError on a bad pattern
+    count = ctypes.c_int()
+    error = ctypes.POINTER(ctypes.c_char)()
+    c_records_ptr = c_lib.lib_v2_search_contacts_regex(pattern.encode('utf-8'), ctypes.c_int(search_type), ctypes.byref(count), ctypes.byref(error))
+    if error:
+        raise ValueError(_c_char_p_to_py_string_and_free(error))
+    return _c_records_to_py_list_and_free(c_records_ptr, count.value)
+
+def search_contacts_fuzzy(name, max_distance=1): # Names within max_distance (0-2) edits, closest first
+    count = ctypes.c_int()
+    c_records_ptr = c_lib.lib_v2_search_contacts_fuzzy(name.encode('utf-8'), ctypes.c_int(max_distance), ctypes.byref(count))
+    return _c_records_to_py_list_and_free(c_records_ptr, count.value)
+
+class Query: # Compiled once, run any number of times; e.g. Query('name contains smith AND NOT email suffix ".org"')
+    def __init__(self, text):
+        error = ctypes.POINTER(ctypes.c_char)()
+        self._handle = c_lib.lib_v2_query_compile(text.encode('utf-8'), ctypes.byref(error))
+        if not self._handle:
+            raise ValueError(_c_char_p_to_py_string_and_free(error) or "Error: Invalid query.")
+
+    def run(self):
+        count = ctypes.c_int()
+        c_records_ptr = c_lib.lib_v2_query_run(self._handle, ctypes.byref(count))
+        return _c_records_to_py_list_and_free(c_records_ptr, count.value)
+
+    def close(self):
+        if getattr(self, "_handle", None):
+            c_lib.lib_v2_query_free(self._handle)
+            self._handle = None
+
+    def __del__(self):
+        self.close()
+
+def search_query(text): # One-off query; raises ValueError on a syntax error
+    query = Query(text)
+    try: return query.run()
+    finally: query.close()
+
 def delete_contact_by_email(email):
     return c_lib.lib_v2_delete_contact_by_email(email.encode('utf-8')) == 0
 
+def add_contact_id(name, phone, email): # Returns (message, id); id is None if the add failed
+    new_id = ctypes.c_uint64()
+    result_ptr = c_lib.lib_v2_add_contact_id(name.encode('utf-8'), phone.encode('utf-8'), email.encode('utf-8'), ctypes.byref(new_id))
+    return _c_char_p_to_py_string_and_free(result_ptr), (new_id.value or None)
+
+def get_contact_by_id(contact_id): # The contact as a dict, or None
+    record = ContactRecord()
+    if c_lib.lib_v2_get_contact_by_id(contact_id, ctypes.byref(record)) != 0:
+        return None
+    return _record_to_dict(record)
+
+def edit_contact_by_id(contact_id, new_name, new_phone, new_email):
+    result_ptr = c_lib.lib_v2_edit_contact_by_id(contact_id, new_name.encode('utf-8'), new_phone.encode('utf-8'), new_email.encode('utf-8'))
+    return _c_char_p_to_py_string_and_free(result_ptr)
+
+def delete_contact_by_id(contact_id):
+    return c_lib.lib_v2_delete_contact_by_id(contact_id) == 0
+
 def delete_all_contacts():
     return c_lib.lib_v2_delete_all_contacts() == 0
 
+_BULK_ERRORS = {-2: "Error: Invalid new name format.", -3: "Error: Invalid new phone number."}
+
+def delete_contacts_where(query): # query: a Query or its text; returns how many were deleted
+    query = query if isinstance(query, Query) else Query(query)
+    return c_lib.lib_v2_delete_contacts_where(query._handle)
+
+def update_contacts_where(query, new_name=None, new_phone=None): # None keeps the field; returns how many were updated
+    query = query if isinstance(query, Query) else Query(query)
+    result = c_lib.lib_v2_update_contacts_where(query._handle,
+                                                new_name.encode('utf-8') if new_name is not None else None,
+                                                new_phone.encode('utf-8') if new_phone is not None else None)
+    if result < 0:
+        raise ValueError(_BULK_ERRORS.get(result, "Error: Invalid arguments."))
+    return result
+
+def upsert_contacts(rows): # rows: (name, phone, email) tuples or dicts; adds new emails, updates the rest
+    rows = list(rows)
+    c_rows = (ContactRecord * len(rows))()
+    for c_row, row in zip(c_rows, rows):
+        name, phone, email = (row["name"], row["phone"], row["email"]) if isinstance(row, dict) else row
+        c_row.name, c_row.phone, c_row.email = (field.encode('utf-8')[:50] for field in (name, phone, email)) # Overlong: rejected
+    inserted, updated, unchanged = ctypes.c_int(), ctypes.c_int(), ctypes.c_int()
+    result = c_lib.lib_v2_upsert_contacts(c_rows, len(rows), ctypes.byref(inserted), ctypes.byref(updated), ctypes.byref(unchanged))
+    if result == -2:
+        raise MemoryError("Out of memory after %d inserts and %d updates" % (inserted.value, updated.value))
+    if result < 0:
+        raise ValueError("Error: Invalid arguments.")
+    return {"inserted": inserted.value, "updated": updated.value, "unchanged": unchanged.value, "rejected": result}
+
 def sort_contacts(sort_type): 
     return c_lib.lib_v2_sort_contacts(ctypes.c_int(sort_type)) == 0
 
+def sort_contacts_by_keys(keys): # e.g. [1, -3]: name ascending, then email descending
+    c_keys = (ctypes.c_int * len(keys))(*keys)
+    return c_lib.lib_v2_sort_contacts_by_keys(c_keys, len(keys)) == 0
+
+def sort_csv_external(in_path, out_path, keys, memory_budget=0, io_buffer_size=0): # Sorts a CSV file without loading it; 0 = library defaults
+    c_keys = (ctypes.c_int * len(keys))(*keys)
+    return c_lib.lib_v2_sort_csv_external(in_path.encode('utf-8'), out_path.encode('utf-8'), c_keys, len(keys),
+                                          ctypes.c_size_t(memory_budget), ctypes.c_size_t(io_buffer_size)) == 0
+
+def get_sorted_page(field, offset, limit): # field: 1=name, 2=phone, 3=email
+    count = ctypes.c_int()
+    c_records_ptr = c_lib.lib_v2_get_sorted_page(ctypes.c_int(field), ctypes.c_int(offset), ctypes.c_int(limit), ctypes.byref(count))
+    return _c_records_to_py_list_and_free(c_records_ptr, count.value)
+
+def set_sort_parallelism(threshold=0, threads=0): # 0 keeps the library default
+    c_lib.lib_v2_set_sort_parallelism(ctypes.c_int(threshold), ctypes.c_int(threads))
+
+def set_search_parallelism(threshold=0, threads=0): # 0 keeps the library default
+    c_lib.lib_v2_set_search_parallelism(ctypes.c_int(threshold), ctypes.c_int(threads))
+
 def save_contacts(data_file_path="../data/contacts.csv"): # Default CSV can be version specific
     c_path = data_file_path.encode('utf-8') if data_file_path else None
     return c_lib.lib_v2_save_contacts(c_path) == 0
@@ -0,0 +1,84 @@
+// bench.c
+// See bench.h.
+#define _POSIX_C_SOURCE 200809L // clock_gettime
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+static const char *const first_names[] = {
+    "James", "Mary", "John", "Patricia", "Robert", "Jennifer", "Michael", "Linda",
+    "William", "Elizabeth", "David", "Barbara", "Richard", "Susan", "Joseph", "Jessica",
+    "Thomas", "Sarah", "Charles", "Karen", "Emily", "Daniel", "Nancy", "Matthew",
+    "Ann", "Anthony", "Lisa", "Mark", "Betty", "Donald", "Sandra", "Steven",
+};
+static const char *const last_names[] = {
+    "Smith", "Johnson", "Williams", "Brown", "Jones", "Garcia", "Miller", "Davis",
+    "Rodriguez", "Martinez", "Hernandez", "Lopez", "Gonzalez", "Wilson", "Anderson", "Thomas",
+    "Taylor", "Moore", "Jackson", "Martin", "Lee", "Perez", "Thompson", "White",
+    "Harris", "Sanchez", "Clark", "Ramirez", "Lewis", "Robinson", "Walker", "Young",
+};
+static const char *const domains[] = { "gmail", "yahoo", "hotmail", "example", "company" };
+
+#define NAMES(list) (sizeof(list) / sizeof(list[0]))
+
+double bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+long bench_peak_rss_kb(void) {
+    struct rusage ru;
+    return getrusage(RUSAGE_SELF, &ru) == 0 ? ru.ru_maxrss : 0;
+}
+
+long bench_rss_kb(void) {
+    FILE *f = fopen("/proc/self/statm", "r");
+    long pages = 0, resident = 0;
+    if (!f) return 0;
+    if (fscanf(f, "%ld %ld", &pages, &resident) != 2) resident = 0;
+    fclose(f);
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+// splitmix64, so neighbouring records get unrelated names.
+static uint64_t mix(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+void bench_record(EngineRecord *r, uint64_t i) {
+    uint64_t h = mix(i);
+    const char *first = first_names[h % NAMES(first_names)];
+    const char *last = last_names[(h >> 8) % NAMES(last_names)];
+    snprintf(r->name, ENGINE_FIELD_BYTES, "%s %s", first, last);
+    // i -> i * 1000003 + c is a bijection mod 10^10, 1000003 being prime to 10.
+    snprintf(r->phone, ENGINE_FIELD_BYTES, "%010llu",
+             (unsigned long long)(((i % 10000000000ull) * 1000003ull + 123456789ull) % 10000000000ull));
+    snprintf(r->email, ENGINE_FIELD_BYTES, "%s.%s%llu@%s.com", first, last,
+             (unsigned long long)i, domains[(h >> 16) % NAMES(domains)]);
+}
+
+int bench_write_csv(const char *path, uint64_t first, int n, int header) {
+    FILE *f = fopen(path, "w");
+    if (!f) return -1;
+    if (header) fputs("Name,Phone,Email\n", f);
+    EngineRecord r;
+    for (int i = 0; i < n; i++) {
+        bench_record(&r, first + (uint64_t)i);
+        fprintf(f, "%s,%s,%s\n", r.name, r.phone, r.email);
+    }
+    return fclose(f) == 0 ? 0 : -1;
+}
+
+int bench_arg(int argc, char *argv[], int i, int def) {
+    if (i >= argc) return def;
+    int v = atoi(argv[i]);
+    return v > 0 ? v : def;
+}
@@ -0,0 +1,29 @@
+// bench.h
+// Helpers shared by the benchmark drivers in this directory: a wall clock,
+// memory readings, and a generator of valid synthetic contacts. Record i
+// always comes out the same, and its phone and email are unique among the
+// first 10^10 records, so a generated set loads without duplicate rejects.
+#ifndef DONNA_BENCH_H
+#define DONNA_BENCH_H
+
+#include "engine.h"
+
+#include <stdint.h>
+
+double bench_now(void);        // Seconds on a monotonic clock
+long bench_peak_rss_kb(void);  // Peak resident set of this process so far
+long bench_rss_kb(void);       // Resident set now (0 where /proc is missing)
+
+// Fills r with contact i: "First Last" (letters and spaces), a 10-digit phone
+// and a ".com" email, all valid for every front end.
+void bench_record(EngineRecord *r, uint64_t i);
+// Writes contacts first..first+n-1 as CSV, after a "Name,Phone,Email" line
+// when header is set: the v2 library always skips the first line, the other
+// front ends load it as a record. Returns 0, or -1 if the file can't be
+// written.
+int bench_write_csv(const char *path, uint64_t first, int n, int header);
+
+// argv[i] as a positive int, or def when it is missing or not one.
+int bench_arg(int argc, char *argv[], int i, int def);
+
+#endif
@@ -0,0 +1,123 @@
+// bloom_import.c
+// The Bloom filters in front of the duplicate checks (user-045).
+//
+// False-positive rate: an EngineBloom is sized the way the libraries size
+// theirs (for twice the records, so half full after a load or rebuild), then
+// filled with the folded emails, or the phones, of RECORDS generated contacts.
+// PROBES keys that were never added are looked up. The rate is also given for
+// a full filter, the state just before the next rebuild.
+//
+// Import: RECORDS rows go one by one through lib_v1_add_contact() and
+// add_contact_py() into empty stores, each add checking for duplicates. The
+// builds without a filter no longer exist, so their time is estimated: every
+// add did a full walk of the store to prove the key absent, a walk that a
+// search for an absent email (and, in the pybind module, phone) repeats. The
+// estimate is the measured import plus RECORDS/2 such walks at the final size.
+//
+//   bloom_import [RECORDS]
+//
+// Default: 1,000,000 records. The quoted import numbers are for 10,000,000.
+#include "bench.h"
+#include "contact.h"
+#include "contact_v1_lib.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define PROBES 1000000
+#define WALKS 20
+
+// Rate of "maybe" answers for PROBES absent keys, with keys records filed
+// into a filter sized for capacity keys.
+static double false_positive_rate(int records, size_t capacity, int field) {
+    EngineBloom f;
+    if (engine_bloom_init(&f, capacity) != 0) return -1;
+    EngineRecord r;
+    char key[ENGINE_FIELD_BYTES];
+    for (int i = 0; i < records; i++) {
+        bench_record(&r, (uint64_t)i);
+        engine_fold_key(key, engine_field(&r, field));
+        engine_bloom_add(&f, key);
+    }
+    long maybe = 0;
+    for (int i = 0; i < PROBES; i++) {
+        bench_record(&r, (uint64_t)records + (uint64_t)i);
+        engine_fold_key(key, engine_field(&r, field));
+        maybe += engine_bloom_maybe(&f, key);
+    }
+    engine_bloom_free(&f);
+    return (double)maybe / PROBES;
+}
+
+static size_t sized_for(int records) {
+    size_t keys = 2 * (size_t)records;
+    return keys < ENGINE_BLOOM_MIN_KEYS ? ENGINE_BLOOM_MIN_KEYS : keys;
+}
+
+static void report_import(const char *label, int added, double secs, double walk) {
+    double estimate = secs + walk * added / 2;
+    printf("%-10s %10d %10.2f %12.0f %14.1f %9.0fx\n", label, added, secs, added / secs, estimate,
+           estimate / secs);
+}
+
+int main(int argc, char *argv[]) {
+    int records = bench_arg(argc, argv, 1, 1000000);
+    EngineRecord r;
+
+    printf("False positives, %d keys filed, %d absent keys probed\n", records, PROBES);
+    printf("%-6s %14s %14s\n", "field", "after load", "before rebuild");
+    for (int field = ENGINE_FIELD_PHONE; field <= ENGINE_FIELD_EMAIL; field++) {
+        printf("%-6s %13.4f%% %13.4f%%\n", field == ENGINE_FIELD_PHONE ? "phone" : "email",
+               100 * false_positive_rate(records, sized_for(records), field),
+               100 * false_positive_rate(records, (size_t)records, field));
+    }
+
+    printf("\nImport of %d rows through the add path\n", records);
+    printf("%-10s %10s %10s %12s %14s %10s\n", "store", "added", "seconds", "rows/s", "est. no filter", "speedup");
+
+    lib_v1_initialize("bench_import_missing.csv"); // No such file: starts empty
+    int added = 0;
+    double t0 = bench_now();
+    for (int i = 0; i < records; i++) {
+        bench_record(&r, (uint64_t)i);
+        char *msg = lib_v1_add_contact(r.name, r.phone, r.email);
+        added += msg && strstr(msg, "success") != NULL;
+        lib_v1_free_string(msg);
+    }
+    double secs = bench_now() - t0;
+    double walk = 0;
+    for (int i = 0; i < WALKS; i++) {
+        bench_record(&r, (uint64_t)records + (uint64_t)i);
+        int found = 0;
+        double w0 = bench_now();
+        ContactRecord *hits = lib_v1_search_contacts(r.email, 3, &found);
+        walk += bench_now() - w0;
+        lib_v1_free_contact_records(hits, found);
+    }
+    report_import("v1 lib", added, secs, walk / WALKS);
+    lib_v1_cleanup();
+
+    initialize_library(); // Reads contacts.csv from the working directory, if any
+    delete_all_contacts_py();
+    added = 0;
+    t0 = bench_now();
+    for (int i = 0; i < records; i++) {
+        bench_record(&r, (uint64_t)i);
+        added += add_contact_py(r.name, r.phone, r.email) == 1;
+    }
+    secs = bench_now() - t0;
+    walk = 0;
+    for (int i = 0; i < WALKS; i++) {
+        bench_record(&r, (uint64_t)records + (uint64_t)i);
+        int found = 0;
+        double w0 = bench_now();
+        ContactData *hits = search_contacts_py(r.phone, 2, &found);
+        free_contact_data_array(hits);
+        hits = search_contacts_py(r.email, 3, &found);
+        walk += bench_now() - w0;
+        free_contact_data_array(hits);
+    }
+    report_import("streamlit", added, secs, walk / WALKS);
+    delete_all_contacts_py();
+    return 0;
+}
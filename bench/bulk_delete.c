@@ -0,0 +1,92 @@
+// bulk_delete.c
+// Scripted bulk-delete throughput of the array stores (user-041). Every case
+// loads a fresh copy of the generated set and reports deletes per second:
+//   - lib, front:   lib_v1_delete_contact_by_email() on the first records, in
+//                   file order, with no sorted view (lookup scans the live
+//                   slots) and with the email view built (lookup seeks it),
+//   - lib, random:  the same on records spread over the whole array,
+//   - lib, regex:   lib_v1_delete_contacts_regex() on every "Mary ...",
+//   - CLI, front:   deleteSlot() on the first live slot of the v1 CLI's
+//                   array until half the records are gone, so the
+//                   compaction passes are part of the cost.
+//
+//   bulk_delete [RECORDS]
+//
+// Default: 1,000,000 records.
+#include "bench.h"
+#include "contact1.h"
+#include "contact_v1_lib.h"
+
+#include <stdio.h>
+
+#define CSV_PATH "bench_delete.csv"
+
+extern int count;   // Records in the v1 CLI's contacts[], deleted ones included
+extern int deleted; // Deleted slots among them
+
+static int records;
+
+static int load(int email_view) {
+    if (lib_v1_initialize(CSV_PATH) != 0) { fprintf(stderr, "load failed\n"); return -1; }
+    if (email_view) lib_v1_sort_contacts(3);
+    return 0;
+}
+
+// Record k of `picks` spread over the set: 2654435761 is prime, so the picks
+// are distinct unless records is a multiple of it.
+static uint64_t spread(int k) {
+    return (uint64_t)k * 2654435761u % (uint64_t)records;
+}
+
+static void by_email(const char *label, int email_view, int deletes, int random) {
+    if (load(email_view) != 0) return;
+    EngineRecord r;
+    int done = 0;
+    double t0 = bench_now();
+    for (int k = 0; k < deletes; k++) {
+        bench_record(&r, random ? spread(k) : (uint64_t)k);
+        done += lib_v1_delete_contact_by_email(r.email) == 0;
+    }
+    double secs = bench_now() - t0;
+    printf("%-34s %8d %12.0f\n", label, done, done / secs);
+}
+
+static void by_regex(void) {
+    if (load(0) != 0) return;
+    char *error = NULL;
+    double t0 = bench_now();
+    int done = lib_v1_delete_contacts_regex("^Mary ", 1, &error);
+    double secs = bench_now() - t0;
+    lib_v1_free_string(error);
+    printf("%-34s %8d %12.0f\n", "lib, regex ^Mary", done, done / secs);
+}
+
+static void cli_front(void) {
+    if (appendContacts(CSV_PATH) < 0) { fprintf(stderr, "CLI load failed\n"); return; }
+    int target = count / 2, done = 0, next = 0;
+    double t0 = bench_now();
+    while (done < target) {
+        while (isDeleted(next)) next++;
+        deleteSlot(next);
+        done++;
+        if (deleted == 0) next = 0; // Compacted: the live records start at slot 0 again
+    }
+    double secs = bench_now() - t0;
+    printf("%-34s %8d %12.0f\n", "CLI, front (with compaction)", done, done / secs);
+}
+
+int main(int argc, char *argv[]) {
+    records = bench_arg(argc, argv, 1, 1000000);
+    if (bench_write_csv(CSV_PATH, 0, records, 0) != 0) { perror(CSV_PATH); return 1; }
+    printf("%d records\n", records);
+    printf("%-34s %8s %12s\n", "case", "deletes", "deletes/s");
+    by_email("lib, front, scan lookup", 0, 2000, 0);
+    by_email("lib, front, email view", 1, 2000, 0);
+    by_email("lib, random, scan lookup", 0, 300, 1);
+    by_email("lib, random, email view", 1, 10000, 1);
+    by_regex();
+    lib_v1_cleanup();
+    cli_front();
+    remove(CSV_PATH);
+    return 0;
+}
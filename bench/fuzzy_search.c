@@ -0,0 +1,134 @@
+// fuzzy_search.c
+// Edit-distance name search in the v2 library at 1M names (user-039), on two
+// sets: one where every name is distinct (a first name and a five-letter
+// surname spelled from the record number), and one with the 1,024 first and
+// last name pairs the generator repeats. For each set it reports the first
+// fuzzy search, which builds the BK-tree, the mean time of QUERIES searches at
+// distance 1 and 2, and the mean time of a plain dynamic-programming scan of
+// every name for BRUTE_QUERIES of them. Queries are stored names with one or
+// two letters changed, and the scan must find as many records as the library
+// does.
+//
+//   fuzzy_search [RECORDS]
+//
+// Default: 1,000,000 records.
+#include "bench.h"
+#include "contact_v2_lib.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CSV_PATH "bench_fuzzy.csv"
+#define QUERIES 200
+#define BRUTE_QUERIES 5
+
+// Gives record i of the distinct set "<first name> <five letters of i>".
+static void make_distinct(EngineRecord *r, int i) {
+    char *surname = strchr(r->name, ' ') + 1;
+    for (int k = 4; k >= 0; k--, i /= 26) surname[k] = (char)('a' + i % 26);
+    surname[0] -= 'a' - 'A';
+    surname[5] = '\0';
+}
+
+static int write_set(int records, int distinct) {
+    FILE *f = fopen(CSV_PATH, "w");
+    if (!f) return -1;
+    fputs("Name,Phone,Email\n", f); // Skipped by the v2 library
+    EngineRecord r;
+    for (int i = 0; i < records; i++) {
+        bench_record(&r, (uint64_t)i);
+        if (distinct) make_distinct(&r, i);
+        fprintf(f, "%s,%s,%s\n", r.name, r.phone, r.email);
+    }
+    return fclose(f) == 0 ? 0 : -1;
+}
+
+// Plain O(|a| |b|) Levenshtein distance.
+static int levenshtein(const char *a, const char *b) {
+    int la = (int)strlen(a), lb = (int)strlen(b);
+    int row[ENGINE_FIELD_BYTES];
+    for (int j = 0; j <= lb; j++) row[j] = j;
+    for (int i = 1; i <= la; i++) {
+        int diag = row[0];
+        row[0] = i;
+        for (int j = 1; j <= lb; j++) {
+            int up = row[j];
+            int best = diag + (a[i - 1] != b[j - 1]);
+            if (up + 1 < best) best = up + 1;
+            if (row[j - 1] + 1 < best) best = row[j - 1] + 1;
+            row[j] = best;
+            diag = up;
+        }
+    }
+    return row[lb];
+}
+
+// A stored name with `edits` letters replaced by other letters.
+static void make_query(char query[ENGINE_FIELD_BYTES], const ContactRecord *all, int n, int edits) {
+    snprintf(query, ENGINE_FIELD_BYTES, "%s", all[rand() % n].name);
+    int len = (int)strlen(query);
+    for (int e = 0; e < edits; e++) {
+        int pos = rand() % len;
+        if (query[pos] == ' ') continue;
+        char c = (char)('a' + rand() % 26);
+        query[pos] = c == query[pos] ? (char)('a' + (c - 'a' + 1) % 26) : c;
+    }
+}
+
+static int run(int records, int distinct) {
+    if (write_set(records, distinct) != 0) { perror(CSV_PATH); return 1; }
+    if (lib_v2_initialize(CSV_PATH) != 0) { fprintf(stderr, "load failed\n"); return 1; }
+    int n = 0;
+    ContactRecord *all = lib_v2_get_all_contacts(&n);
+    if (!all) { fprintf(stderr, "out of memory\n"); return 1; }
+    char (*keys)[ENGINE_FIELD_BYTES] = malloc((size_t)n * ENGINE_FIELD_BYTES);
+    if (!keys) { fprintf(stderr, "out of memory\n"); return 1; }
+    for (int i = 0; i < n; i++) engine_fold_key(keys[i], all[i].name);
+
+    printf("%d records, %s names\n", n, distinct ? "distinct" : "repeated");
+    int count = 0;
+    double t0 = bench_now();
+    ContactRecord *hits = lib_v2_search_contacts_fuzzy(all[0].name, 1, &count);
+    printf("  first search (builds the tree): %8.3f s\n", bench_now() - t0);
+    lib_v2_free_contact_records(hits, count);
+
+    int status = 0;
+    srand(1);
+    for (int k = 1; k <= 2; k++) {
+        double tree = 0, brute = 0;
+        long found = 0;
+        for (int q = 0; q < QUERIES; q++) {
+            char query[ENGINE_FIELD_BYTES], folded[ENGINE_FIELD_BYTES];
+            make_query(query, all, n, k);
+            t0 = bench_now();
+            hits = lib_v2_search_contacts_fuzzy(query, k, &count);
+            tree += bench_now() - t0;
+            lib_v2_free_contact_records(hits, count);
+            found += count;
+            if (q >= BRUTE_QUERIES) continue;
+
+            engine_fold_key(folded, query);
+            int brute_count = 0;
+            t0 = bench_now();
+            for (int i = 0; i < n; i++) brute_count += levenshtein(folded, keys[i]) <= k;
+            brute += bench_now() - t0;
+            if (brute_count != count) {
+                printf("  \"%s\", k=%d: tree found %d, scan found %d\n", query, k, count, brute_count);
+                status = 1;
+            }
+        }
+        printf("  k=%d: %8.3f ms/query (%.1f hits), scan %8.1f ms/query\n", k, tree * 1e3 / QUERIES,
+               (double)found / QUERIES, brute * 1e3 / BRUTE_QUERIES);
+    }
+    free(keys);
+    lib_v2_free_contact_records(all, n);
+    lib_v2_cleanup();
+    remove(CSV_PATH);
+    return status;
+}
+
+int main(int argc, char *argv[]) {
+    int records = bench_arg(argc, argv, 1, 1000000);
+    return run(records, 1) | run(records, 0);
+}
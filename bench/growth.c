@@ -0,0 +1,123 @@
+// growth.c
+// Amortized append cost and memory of the growable contact arrays (user-049).
+//   - cli: APPENDS single appends to the v1 CLI's contacts[] through
+//          reserveContacts(), against the same appends into an array
+//          reserved for all of them up front. Reports ns/append, the reallocs
+//          taken, the final capacity, and the peak resident set; then drops
+//          count to an eighth and reports the capacity shrinkContacts()
+//          leaves.
+//   - lib: loads RECORDS contacts into the v1 library, then adds RECORDS
+//          more one by one through lib_v1_add_contact(). Reports us/add and
+//          the peak resident set, then the resident set after the 90% of
+//          records whose email number doesn't end in 0 are deleted by regex,
+//          and after delete all.
+// Each case runs in its own child process, so each peak is its own.
+//
+//   growth [cli [APPENDS] | lib [RECORDS]]
+//
+// Default: both, with 5,000,000 appends and 1,000,000 records.
+#include "bench.h"
+#include "contact1.h"
+#include "contact_v1_lib.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define CSV_PATH "bench_growth.csv"
+
+extern EngineRecord *contacts; // The v1 CLI's array (Details is EngineRecord)
+extern int count;
+extern int capacity;
+
+// Runs run(n) in a child process and waits for it. Returns its exit status.
+static int isolated(int (*run)(int), int n) {
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid < 0) { perror("fork"); return 1; }
+    if (pid == 0) {
+        int status = run(n);
+        fflush(stdout);
+        _exit(status);
+    }
+    int status = 0;
+    if (waitpid(pid, &status, 0) < 0) return 1;
+    return WIFEXITED(status) ? WEXITSTATUS(status) : 1;
+}
+
+static int cli_appends(int appends, int presize) {
+    if (presize && !reserveContacts(appends)) { fprintf(stderr, "out of memory\n"); return 1; }
+    int reallocs = presize, last = capacity;
+    EngineRecord r;
+    double t0 = bench_now();
+    for (int i = 0; i < appends; i++) {
+        if (!reserveContacts(count + 1)) { fprintf(stderr, "out of memory at %d\n", i); return 1; }
+        if (capacity != last) { reallocs++; last = capacity; }
+        bench_record(&r, (uint64_t)i);
+        contacts[count++] = r;
+    }
+    double secs = bench_now() - t0;
+    printf("%-16s %10.1f %9d %11d %11ld %13.1f\n", presize ? "cli, presized" : "cli, growing",
+           secs * 1e9 / appends, reallocs, capacity, bench_peak_rss_kb() / 1024,
+           (double)capacity * sizeof(EngineRecord) / (1 << 20));
+    if (presize) return 0;
+
+    count /= 8; // As if seven in eight had been deleted and compacted away
+    shrinkContacts();
+    printf("%-16s %10s %9s %11d %11s %13.1f   (count %d after shrinkContacts)\n", "", "", "", capacity, "",
+           (double)capacity * sizeof(EngineRecord) / (1 << 20), count);
+    return 0;
+}
+
+static int cli_growing(int appends) { return cli_appends(appends, 0); }
+static int cli_presized(int appends) { return cli_appends(appends, 1); }
+
+static int lib_adds(int records) {
+    if (bench_write_csv(CSV_PATH, 0, records, 0) != 0) { perror(CSV_PATH); return 1; }
+    int status = lib_v1_initialize(CSV_PATH);
+    remove(CSV_PATH);
+    if (status != 0) { fprintf(stderr, "load failed\n"); return 1; }
+    long loaded = bench_rss_kb();
+
+    EngineRecord r;
+    int added = 0;
+    double t0 = bench_now();
+    for (int i = 0; i < records; i++) {
+        bench_record(&r, (uint64_t)records + (uint64_t)i);
+        char *msg = lib_v1_add_contact(r.name, r.phone, r.email);
+        added += msg && strstr(msg, "success") != NULL;
+        lib_v1_free_string(msg);
+    }
+    double secs = bench_now() - t0;
+    printf("lib: %d loaded (RSS %ld MiB), %d added at %.2f us/add, peak RSS %ld MiB\n", records, loaded / 1024,
+           added, secs * 1e6 / records, bench_peak_rss_kb() / 1024);
+
+    char *error = NULL;
+    int gone = lib_v1_delete_contacts_regex("[1-9]@", 3, &error);
+    lib_v1_free_string(error);
+    printf("lib: %d deleted by regex, RSS %ld MiB\n", gone, bench_rss_kb() / 1024);
+    lib_v1_delete_all_contacts();
+    printf("lib: after delete all, RSS %ld MiB\n", bench_rss_kb() / 1024);
+    lib_v1_cleanup();
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    int cli = argc < 2 || strcmp(argv[1], "cli") == 0;
+    int lib = argc < 2 || strcmp(argv[1], "lib") == 0;
+    if (!cli && !lib) { fprintf(stderr, "usage: growth [cli [APPENDS] | lib [RECORDS]]\n"); return 2; }
+
+    int status = 0;
+    if (cli) {
+        int appends = bench_arg(argc, argv, 2, 5000000);
+        printf("%d appends of %zu-byte records\n", appends, sizeof(EngineRecord));
+        printf("%-16s %10s %9s %11s %11s %13s\n", "case", "ns/append", "reallocs", "capacity", "peak MiB",
+               "array MiB");
+        status |= isolated(cli_growing, appends);
+        status |= isolated(cli_presized, appends);
+    }
+    if (lib) status |= isolated(lib_adds, bench_arg(argc, argv, 2, 1000000));
+    return status;
+}
@@ -0,0 +1,79 @@
+// multikey_sort.c
+// Multi-key sort against the single-field path in the v2 library (user-032).
+// Each case loads a fresh copy of the generated set, puts it in phone order
+// (untimed, so every case starts from the same shuffle of names and emails),
+// then times one sort; the best of REPEATS runs is reported. The single-field
+// row is lib_v2_sort_contacts() on one thread (the MSD radix path); the
+// others go through lib_v2_sort_contacts_by_keys() and its per-tuple kernels.
+//
+//   multikey_sort [RECORDS]
+//
+// Default: 1,000,000 records.
+#include "bench.h"
+#include "contact_v2_lib.h"
+
+#include <stdio.h>
+
+#define CSV_PATH "bench_multikey.csv"
+#define REPEATS 3
+
+typedef struct {
+    const char *label;
+    int keys[3]; // 1=name, 2=phone, 3=email, negated for descending; 0 ends
+} SortCase;
+
+static const SortCase cases[] = {
+    { "name (by_keys)",         { 1 } },
+    { "name, email",            { 1, 3 } },
+    { "name desc, email",       { -1, 3 } },
+    { "email, phone, name",     { 3, 2, 1 } },
+    { "phone desc",             { -2 } },
+};
+
+static int key_count(const SortCase *c) {
+    int n = 0;
+    while (n < 3 && c->keys[n]) n++;
+    return n;
+}
+
+// Loads the set in phone order. Returns 0, or -1 if the load failed.
+static int load_phone_order(void) {
+    if (lib_v2_initialize(CSV_PATH) != 0) return -1;
+    lib_v2_set_sort_parallelism(1, 1);
+    lib_v2_sort_contacts(2);
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    int records = bench_arg(argc, argv, 1, 1000000);
+    if (bench_write_csv(CSV_PATH, 0, records, 1) != 0) { perror(CSV_PATH); return 1; }
+    printf("v2 library, %d records, starting from phone order\n", records);
+    printf("%-30s %10s\n", "keys", "seconds");
+
+    double best = 0;
+    for (int r = 0; r < REPEATS; r++) {
+        if (load_phone_order() != 0) { fprintf(stderr, "load failed\n"); return 1; }
+        double t0 = bench_now();
+        lib_v2_sort_contacts(1);
+        double secs = bench_now() - t0;
+        if (r == 0 || secs < best) best = secs;
+    }
+    printf("%-30s %10.3f\n", "name (single field, 1 thread)", best);
+
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        for (int r = 0; r < REPEATS; r++) {
+            if (load_phone_order() != 0) { fprintf(stderr, "load failed\n"); return 1; }
+            double t0 = bench_now();
+            if (lib_v2_sort_contacts_by_keys(cases[c].keys, key_count(&cases[c])) != 0) {
+                fprintf(stderr, "%s: sort failed\n", cases[c].label);
+                return 1;
+            }
+            double secs = bench_now() - t0;
+            if (r == 0 || secs < best) best = secs;
+        }
+        printf("%-30s %10.3f\n", cases[c].label, best);
+    }
+    lib_v2_cleanup();
+    remove(CSV_PATH);
+    return 0;
+}
@@ -0,0 +1,96 @@
+// scan_gbps.c
+// Field scan throughput of the engine's substring kernel against strstr
+// (user-034). Records sit in a singly linked list of individually allocated
+// nodes, as in the v2 library and the pybind module, and every query scans
+// the name and then the email field of every record. Throughput counts the
+// 50-byte field once per record scanned; each figure is the best of REPEATS
+// scans. Both matchers must count the same hits.
+//
+//   scan_gbps [RECORDS...]
+//
+// Default: 40,000 and then 1,000,000 records. The numbers quoted with the
+// kernel were taken at 40,000 and 10,000,000 (about 2 GB of nodes).
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define REPEATS 5
+
+typedef struct ScanNode {
+    EngineRecord rec;
+    struct ScanNode *next;
+} ScanNode;
+
+static const char *const queries[] = { "a", "Sm", "son", "Lee", "gmail", "Jones4", "zzz", "Williams12345" };
+
+static int strstr_contains(const char *field, const char *query, size_t query_len) {
+    (void)query_len;
+    return strstr(field, query) != NULL;
+}
+
+// Hits for query over both fields of every record.
+static long scan(const ScanNode *head, EngineFieldMatcher contains, const char *query) {
+    size_t len = strlen(query);
+    long hits = 0;
+    for (const ScanNode *p = head; p; p = p->next) {
+        hits += contains(p->rec.name, query, len);
+        hits += contains(p->rec.email, query, len);
+    }
+    return hits;
+}
+
+// Best time of REPEATS scans; *hits gets the hit count.
+static double time_scan(const ScanNode *head, EngineFieldMatcher contains, const char *query, long *hits) {
+    double best = 0;
+    for (int r = 0; r < REPEATS; r++) {
+        double t0 = bench_now();
+        *hits = scan(head, contains, query);
+        double secs = bench_now() - t0;
+        if (r == 0 || secs < best) best = secs;
+    }
+    return best;
+}
+
+static int run(int records) {
+    ScanNode *head = NULL, **tail = &head;
+    for (int i = 0; i < records; i++) {
+        ScanNode *n = (ScanNode*)malloc(sizeof(ScanNode));
+        if (!n) { fprintf(stderr, "out of memory at %d records\n", i); break; }
+        bench_record(&n->rec, (uint64_t)i);
+        n->next = NULL;
+        *tail = n;
+        tail = &n->next;
+    }
+
+    int status = 0;
+    double bytes = 2.0 * ENGINE_FIELD_BYTES * records;
+    printf("%d records\n", records);
+    printf("%-14s %10s %12s %12s %8s\n", "query", "hits", "strstr GB/s", "kernel GB/s", "ratio");
+    for (size_t q = 0; q < sizeof(queries) / sizeof(queries[0]); q++) {
+        long slow_hits = 0, fast_hits = 0;
+        double slow = time_scan(head, strstr_contains, queries[q], &slow_hits);
+        double fast = time_scan(head, engine_field_matcher(strlen(queries[q])), queries[q], &fast_hits);
+        printf("%-14s %10ld %12.2f %12.2f %7.2fx%s\n", queries[q], fast_hits, bytes / slow / 1e9,
+               bytes / fast / 1e9, slow / fast, slow_hits == fast_hits ? "" : "  hit mismatch");
+        if (slow_hits != fast_hits) status = 1;
+    }
+
+    while (head) {
+        ScanNode *next = head->next;
+        free(head);
+        head = next;
+    }
+    return status;
+}
+
+int main(int argc, char *argv[]) {
+    int status = 0;
+    if (argc < 2) {
+        status |= run(40000);
+        status |= run(1000000);
+    }
+    for (int i = 1; i < argc; i++) status |= run(bench_arg(argc, argv, i, 40000));
+    return status;
+}
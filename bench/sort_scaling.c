@@ -0,0 +1,80 @@
+// sort_scaling.c
+// Scaling of the library sorts by thread count (user-029): each run loads a
+// fresh copy of the generated set, so no sorted view is built yet, and times
+// one lib_vN_sort_contacts() with the work-stealing pool forced to the given
+// worker count; the best of REPEATS runs is reported. Every run must leave
+// the same order; a run that doesn't is reported as a mismatch.
+//
+//   sort_scaling_v1 [RECORDS] [MAX_THREADS]   (array library)
+//   sort_scaling_v2 [RECORDS] [MAX_THREADS]   (list library)
+//
+// Defaults: 1,000,000 records, up to 64 threads, doubling from 1. Thread
+// counts past the CPU count show the pool's overhead, not a speed-up.
+#include "bench.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#if BENCH_V == 1
+#include "contact_v1_lib.h"
+#define LIB(fn) lib_v1_##fn
+#define CSV_HEADER 0
+#else
+#include "contact_v2_lib.h"
+#define LIB(fn) lib_v2_##fn
+#define CSV_HEADER 1 // The v2 library skips the first line
+#endif
+
+#define CSV_PATH "bench_sort.csv"
+#define REPEATS 3
+
+// djb2 over the whole order, to compare runs.
+static uint64_t order_hash(void) {
+    int n = 0;
+    ContactRecord *all = LIB(get_all_contacts)(&n);
+    uint64_t h = 5381;
+    for (int i = 0; i < n; i++) {
+        for (const char *p = all[i].email; *p; p++) h = h * 33 + (unsigned char)*p;
+    }
+    LIB(free_contact_records)(all, n);
+    return h;
+}
+
+int main(int argc, char *argv[]) {
+    int records = bench_arg(argc, argv, 1, 1000000);
+    int max_threads = bench_arg(argc, argv, 2, ENGINE_SORT_MAX_THREADS);
+    static const char *const field_names[] = { "", "name", "phone", "email" };
+
+    if (bench_write_csv(CSV_PATH, 0, records, CSV_HEADER) != 0) { perror(CSV_PATH); return 1; }
+    printf("v%d library, %d records, %ld CPUs online\n", BENCH_V, records, sysconf(_SC_NPROCESSORS_ONLN));
+    printf("%-6s %8s %10s %8s\n", "field", "threads", "seconds", "speedup");
+
+    int status = 0;
+    for (int field = 1; field <= 3; field++) {
+        double base = 0;
+        uint64_t expect = 0;
+        for (int threads = 1; threads <= max_threads; threads *= 2) {
+            double best = 0;
+            int same = 1;
+            for (int r = 0; r < REPEATS; r++) {
+                if (LIB(initialize)(CSV_PATH) != 0) { fprintf(stderr, "load failed\n"); return 1; }
+                LIB(set_sort_parallelism)(1, threads);
+                double t0 = bench_now();
+                LIB(sort_contacts)(field);
+                double secs = bench_now() - t0;
+                uint64_t h = order_hash();
+                if (threads == 1 && r == 0) expect = h;
+                same &= h == expect;
+                if (r == 0 || secs < best) best = secs;
+            }
+            if (threads == 1) base = best;
+            printf("%-6s %8d %10.3f %7.2fx%s\n", field_names[field], threads, best, base / best,
+                   same ? "" : "  order mismatch");
+            if (!same) status = 1;
+        }
+    }
+    LIB(cleanup)();
+    remove(CSV_PATH);
+    return status;
+}
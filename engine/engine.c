@@ -0,0 +1,265 @@
+// engine.c
+// Record-level pieces of the storage engine: validation, CSV lines, sort
+// keys, the capacity policy, the Bloom filter and the id table. See engine.h.
+#include "engine.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// --- Validation ---
+ENGINE_API int engine_valid_name(const char *name) {
+    if (name == NULL || name[0] == '\0') return 0;
+    for (int i = 0; name[i] != '\0'; i++) {
+        if (!((name[i] >= 'a' && name[i] <= 'z') ||
+              (name[i] >= 'A' && name[i] <= 'Z') ||
+              (name[i] == ' '))) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+ENGINE_API int engine_valid_phone(const char *phone) {
+    uint64_t unused;
+    return phone != NULL && engine_pack_phone(phone, &unused);
+}
+
+ENGINE_API int engine_valid_email(const char *email, int rule) {
+    if (email == NULL) return 0;
+    const char *at = strchr(email, '@');
+    if (at == NULL || at == email) return 0; // No '@' or starts with '@'
+    const char *dot = strrchr(at, '.');      // Last dot after '@'
+    if (dot == NULL || dot - (at + 1) < 1) return 0; // No character between '@' and the dot
+    if (strlen(dot + 1) < 2) return 0;               // TLD too short
+    if (rule == ENGINE_EMAIL_DOTCOM) {
+        if (strchr(email, ' ') || strcmp(dot, ".com") != 0) return 0;
+    }
+    return 1;
+}
+
+// --- CSV ---
+// Copies the run of s up to a byte in stop (or the end) into dst. Returns the
+// run's length, or -1 if it is empty or longer than max.
+static int csv_span(const char *s, const char *stop, char *dst, int max) {
+    int len = (int)strcspn(s, stop);
+    if (len == 0 || len > max) return -1;
+    memcpy(dst, s, (size_t)len);
+    dst[len] = '\0';
+    return len;
+}
+
+ENGINE_API int engine_parse_csv_line(const char *line, EngineRecord *out) {
+    const int max = ENGINE_FIELD_BYTES - 1;
+    int len = csv_span(line, ",\n", out->name, max);
+    if (len < 0 || line[len] != ',') return 0;
+    line += len + 1;
+    len = csv_span(line, ",\n", out->phone, max);
+    if (len < 0 || line[len] != ',') return 0;
+    line += len + 1;
+    len = (int)strcspn(line, "\n");
+    if (len == 0) return 0;
+    if (len > max) len = max; // The email is cut, the rest of the line ignored
+    memcpy(out->email, line, (size_t)len);
+    out->email[len] = '\0';
+    return 1;
+}
+
+ENGINE_API const char *engine_field(const EngineRecord *r, int field) {
+    return field == ENGINE_FIELD_NAME ? r->name
+         : field == ENGINE_FIELD_PHONE ? r->phone
+         : field == ENGINE_FIELD_EMAIL ? r->email
+         : NULL;
+}
+
+ENGINE_API int engine_parse_field(const char *s) {
+    return strcmp(s, "name") == 0 ? ENGINE_FIELD_NAME
+         : strcmp(s, "phone") == 0 ? ENGINE_FIELD_PHONE
+         : strcmp(s, "email") == 0 ? ENGINE_FIELD_EMAIL
+         : 0;
+}
+
+// --- Folded Keys ---
+static char fold_char(char c) {
+    return (c >= 'A' && c <= 'Z') ? (char)(c - 'A' + 'a') : c;
+}
+
+ENGINE_API int engine_fold_key(char dst[ENGINE_FIELD_BYTES], const char *src) {
+    int i = 0;
+    for (; i < ENGINE_FIELD_BYTES - 1 && src[i]; i++) dst[i] = fold_char(src[i]);
+    memset(dst + i, 0, ENGINE_FIELD_BYTES - i);
+    return src[i] == '\0';
+}
+
+ENGINE_API int engine_fold_equal(const char *a, const char *b) {
+    for (; *a && fold_char(*a) == fold_char(*b); a++, b++) {}
+    return fold_char(*a) == fold_char(*b);
+}
+
+// --- Sort Keys ---
+#define RADIX_BITS 12
+#define RADIX_SIZE (1 << RADIX_BITS)
+
+ENGINE_API uint64_t engine_key_prefix(const char *s) {
+    uint64_t prefix = 0;
+    int i = 0;
+    for (; i < 8 && s[i]; i++) prefix = (prefix << 8) | (unsigned char)s[i];
+    return i == 0 ? 0 : prefix << (8 * (8 - i)); // A 64-bit shift would be undefined
+}
+
+ENGINE_API int engine_pack_phone(const char *phone, uint64_t *out) {
+    uint64_t key = 0;
+    for (int i = 0; i < 10; i++) {
+        if (phone[i] < '0' || phone[i] > '9') return 0; // Also stops at an early '\0'
+        key = key * 10 + (uint64_t)(phone[i] - '0');
+    }
+    if (phone[10] != '\0') return 0;
+    *out = key;
+    return 1;
+}
+
+ENGINE_API EngineKey *engine_radix_sort_keys(EngineKey *keys, EngineKey *tmp, int n, int bits) {
+    size_t counts[RADIX_SIZE];
+    for (int shift = 0; shift < bits && n > 0; shift += RADIX_BITS) {
+        memset(counts, 0, sizeof(counts));
+        for (int i = 0; i < n; i++) counts[(keys[i].key >> shift) & (RADIX_SIZE - 1)]++;
+        if (counts[(keys[0].key >> shift) & (RADIX_SIZE - 1)] == (size_t)n) continue; // Digit is constant
+
+        size_t sum = 0;
+        for (int b = 0; b < RADIX_SIZE; b++) { size_t c = counts[b]; counts[b] = sum; sum += c; }
+        for (int i = 0; i < n; i++) tmp[counts[(keys[i].key >> shift) & (RADIX_SIZE - 1)]++] = keys[i];
+
+        EngineKey *swap = keys; keys = tmp; tmp = swap;
+    }
+    return keys;
+}
+
+ENGINE_API EngineKey *engine_sort_ids(EngineKey *keys, EngineKey *tmp, int n) {
+    uint64_t max = 0;
+    int sorted = 1;
+    for (int i = 0; i < n; i++) {
+        if (keys[i].key < max) sorted = 0;
+        else max = keys[i].key;
+    }
+    if (sorted) return keys;
+    int bits = 0;
+    while (bits < 64 && (max >> bits) != 0) bits++;
+    return engine_radix_sort_keys(keys, tmp, n, bits);
+}
+
+// --- Capacity ---
+ENGINE_API int engine_grow_capacity(int capacity, int need) {
+    int cap = capacity > 0 ? capacity * 2 : ENGINE_CAPACITY_MIN;
+    return cap < need ? need : cap;
+}
+
+ENGINE_API int engine_shrink_capacity(int capacity, int count) {
+    if (capacity <= ENGINE_CAPACITY_MIN || count * ENGINE_SHRINK_RATIO > capacity) return capacity;
+    return count * 2 > ENGINE_CAPACITY_MIN ? count * 2 : ENGINE_CAPACITY_MIN;
+}
+
+// --- Bloom Filter ---
+static uint64_t bloom_hash(const char *key) {
+    uint64_t h = 1469598103934665603ull; // FNV-1a, then the murmur3 finalizer to spread it
+    for (; *key; key++) { h ^= (unsigned char)*key; h *= 1099511628211ull; }
+    h ^= h >> 33; h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33; h *= 0xc4ceb9fe1a85ec53ull;
+    return h ^ (h >> 33);
+}
+
+// Low 32 hash bits pick the block; the bits within it come from a second mix.
+static uint64_t *bloom_block(const EngineBloom *f, uint64_t h, uint64_t *g) {
+    *g = h * 0x9E3779B97F4A7C15ull;
+    return f->words + (((h & 0xffffffffu) * f->blocks) >> 32) * 8;
+}
+
+ENGINE_API int engine_bloom_init(EngineBloom *f, size_t keys) {
+    if (keys < ENGINE_BLOOM_MIN_KEYS) keys = ENGINE_BLOOM_MIN_KEYS;
+    f->blocks = (keys * ENGINE_BLOOM_BITS_PER_KEY + 511) / 512;
+    f->words = (uint64_t*)calloc(f->blocks * 8, sizeof(uint64_t));
+    return f->words ? 0 : -1;
+}
+
+ENGINE_API void engine_bloom_free(EngineBloom *f) {
+    free(f->words);
+    f->words = NULL;
+    f->blocks = 0;
+}
+
+ENGINE_API void engine_bloom_add(EngineBloom *f, const char *key) {
+    if (!f->words) return;
+    uint64_t g, *b = bloom_block(f, bloom_hash(key), &g);
+    for (int i = 0; i < 8; i++) b[i] |= 1ull << ((g >> (6 * i + 16)) & 63);
+}
+
+ENGINE_API int engine_bloom_maybe(const EngineBloom *f, const char *key) {
+    if (!f->words) return 1;
+    uint64_t g, *b = bloom_block(f, bloom_hash(key), &g);
+    for (int i = 0; i < 8; i++)
+        if (!((b[i] >> ((g >> (6 * i + 16)) & 63)) & 1)) return 0;
+    return 1;
+}
+
+// --- Id Table ---
+static size_t ids_home(const EngineIds *t, uint64_t id) {
+    return (size_t)((id * 0x9E3779B97F4A7C15ull) >> 32) & t->mask;
+}
+
+// Moves every entry into a fresh table of `entries` (a power of two). Returns
+// 0, or -1 if memory is short (the table is unchanged).
+static int ids_resize(EngineIds *t, size_t entries) {
+    EngineKey *fresh = (EngineKey*)calloc(entries, sizeof(EngineKey));
+    if (!fresh) return -1;
+    EngineKey *old = t->slots;
+    size_t old_entries = old ? t->mask + 1 : 0;
+    t->slots = fresh;
+    t->mask = entries - 1;
+    for (size_t i = 0; i < old_entries; i++) {
+        if (!old[i].key) continue;
+        size_t j = ids_home(t, old[i].key);
+        while (fresh[j].key) j = (j + 1) & t->mask;
+        fresh[j] = old[i];
+    }
+    free(old);
+    return 0;
+}
+
+ENGINE_API EngineKey *engine_ids_insert(EngineIds *t, uint64_t id) {
+    size_t entries = t->slots ? t->mask + 1 : 0;
+    if ((t->count + 1) * 2 > entries && ids_resize(t, entries ? 2 * entries : ENGINE_IDS_MIN) != 0) return NULL;
+    size_t j = ids_home(t, id);
+    while (t->slots[j].key) j = (j + 1) & t->mask;
+    t->slots[j].key = id;
+    t->count++;
+    return &t->slots[j];
+}
+
+ENGINE_API EngineKey *engine_ids_find(const EngineIds *t, uint64_t id) {
+    if (!t->slots || id == 0) return NULL;
+    for (size_t j = ids_home(t, id); t->slots[j].key; j = (j + 1) & t->mask)
+        if (t->slots[j].key == id) return &t->slots[j];
+    return NULL;
+}
+
+ENGINE_API void engine_ids_remove(EngineIds *t, uint64_t id) {
+    EngineKey *e = engine_ids_find(t, id);
+    if (!e) return;
+    size_t hole = (size_t)(e - t->slots);
+    for (size_t j = (hole + 1) & t->mask; t->slots[j].key; j = (j + 1) & t->mask) {
+        size_t home = ids_home(t, t->slots[j].key);
+        if (((j - home) & t->mask) >= ((j - hole) & t->mask)) { // Home is not in (hole, j]: the entry may fill the hole
+            t->slots[hole] = t->slots[j];
+            hole = j;
+        }
+    }
+    t->slots[hole].key = 0;
+    t->count--;
+    size_t entries = t->mask + 1;
+    if (entries > ENGINE_IDS_MIN && t->count * 8 < entries) ids_resize(t, entries / 2); // A failed shrink keeps the larger table
+}
+
+ENGINE_API void engine_ids_free(EngineIds *t) {
+    free(t->slots);
+    t->slots = NULL;
+    t->mask = 0;
+    t->count = 0;
+}
@@ -0,0 +1,378 @@
+// engine.h
+// Storage engine shared by every Donna front end: the two CLIs (version1,
+// version2), the two ctypes libraries (app/version1, app/version2) and the
+// pybind module (streamlit). It holds the logic they used to carry one copy
+// each of, so a fix or a speed-up lands once:
+//   - field validation, CSV line parsing and case-folded keys,
+//   - sort keys (8-byte string prefixes, packed phones) and the LSD radix sort,
+//   - the string sort (MSD radix, the work-stealing pool), the list sort and
+//     the introselect behind sorted pages, and the fork/join behind parallel
+//     searches,
+//   - the growable-array capacity policy,
+//   - the blocked Bloom filter behind duplicate checks,
+//   - the id table behind by-id lookups,
+//   - the sorted views (order-statistic treaps) the ctypes libraries keep,
+//   - the SIMD substring kernel, the query compiler and the Soundex index
+//     behind searches,
+//   - the regex compiler (DFA, case-sensitive or folded),
+//   - a contact store over pluggable backends (array, list) and the headless
+//     subcommands, which run on whichever backend a front end picks.
+// Built as libdonna_engine.a and libdonna_engine.so (see engine/Makefile).
+#ifndef DONNA_ENGINE_H
+#define DONNA_ENGINE_H
+
+#ifdef _WIN32
+    #define ENGINE_API __declspec(dllexport) // For Windows DLL
+#else
+    #define ENGINE_API // For Linux/macOS SO
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ENGINE_FIELD_BYTES 50 // Every field, terminator included
+
+// Field numbers, as the front ends' menus and APIs already use them
+#define ENGINE_FIELD_NAME  1
+#define ENGINE_FIELD_PHONE 2
+#define ENGINE_FIELD_EMAIL 3
+
+typedef struct {
+    char name[ENGINE_FIELD_BYTES];
+    char phone[ENGINE_FIELD_BYTES];
+    char email[ENGINE_FIELD_BYTES];
+} EngineRecord;
+
+// --- Validation ---
+// Names are letters and spaces, phones exactly 10 digits. Emails need one
+// '@' that is not first, then a domain with a dot that has a character before
+// it and at least two after it. ENGINE_EMAIL_DOTCOM also wants no spaces and a
+// ".com" ending, as the CLIs and the pybind module document. All return 1 if
+// valid, else 0; NULL is invalid.
+#define ENGINE_EMAIL_SHAPE  0
+#define ENGINE_EMAIL_DOTCOM 1
+
+ENGINE_API int engine_valid_name(const char *name);
+ENGINE_API int engine_valid_phone(const char *phone);
+ENGINE_API int engine_valid_email(const char *email, int rule);
+
+// --- CSV ---
+// Splits "name,phone,email" the way sscanf("%49[^,],%49[^,],%49[^\n]") did,
+// without the format parsing: each field is non-empty, name and phone stop at
+// a ',' within 49 bytes, the email runs to the newline and is cut at 49 bytes.
+// Returns 1 and fills *out, or 0 if the line does not split.
+ENGINE_API int engine_parse_csv_line(const char *line, EngineRecord *out);
+ENGINE_API const char *engine_field(const EngineRecord *r, int field); // NULL for an unknown field
+ENGINE_API int engine_parse_field(const char *s); // "name", "phone", "email" -> field number, 0 if unknown
+
+// --- Folded Keys ---
+// Emails (and the v2 library's names) compare case-insensitively: John@x.com
+// and john@x.com are the same address. Folding lower-cases ASCII letters and
+// passes every other byte through, UTF-8 sequences included, so a folded copy
+// stored next to the field keeps comparisons plain strcmp.
+ENGINE_API int engine_fold_key(char dst[ENGINE_FIELD_BYTES], const char *src); // Zero fills dst; 0 if src does not fit
+ENGINE_API int engine_fold_equal(const char *a, const char *b); // 1 if a and b fold to the same string
+
+// --- Sort Keys ---
+typedef struct {
+    uint64_t key;
+    union {
+        int idx;   // Array slot the key was built from
+        void *ref; // Or the node
+    };
+} EngineKey;
+
+#define ENGINE_PHONE_KEY_BITS 34 // 10 decimal digits fit in 34 bits
+
+// First 8 bytes of s, big-endian and zero padded past the terminator, so
+// unsigned order equals strcmp order on those bytes.
+ENGINE_API uint64_t engine_key_prefix(const char *s);
+// Stores the value of a phone that is exactly 10 ASCII digits and returns 1,
+// else returns 0. Numeric order equals strcmp order.
+ENGINE_API int engine_pack_phone(const char *phone, uint64_t *out);
+// Stable LSD radix sort of n keys on their low `bits` bits, 12 bits a pass,
+// skipping passes whose digit is constant. tmp is scratch of n keys. Returns
+// whichever of keys and tmp holds the result.
+ENGINE_API EngineKey *engine_radix_sort_keys(EngineKey *keys, EngineKey *tmp, int n, int bits);
+// Orders n keys holding record ids in .key by id: keys untouched if they
+// already are, else the radix sort above on the bits the largest id needs.
+// Strings fed to the stable sorts below in this order come out with equal
+// strings in id order, the order the sorted views keep.
+ENGINE_API EngineKey *engine_sort_ids(EngineKey *keys, EngineKey *tmp, int n);
+
+// --- String Sort ---
+// Orders positions 0..n-1 by strs[position] in strcmp order. Each key holds
+// its position in .idx and the string's prefix in .key, so most comparisons
+// stay inside the key array; strcmp runs on the bytes past the prefix only
+// when two prefixes tie.
+#define ENGINE_SORT_PARALLEL_THRESHOLD (1 << 16) // Default; below this many keys one thread is faster
+#define ENGINE_SORT_MAX_THREADS 64
+
+// Stable MSD radix sort on the prefix bytes, with merge sort for small buckets
+// and prefix ties. With threads > 1 a work-stealing pool sorts chunks and
+// merges them pairwise, the caller being one of the workers; the order is the
+// same for any thread count. keys and tmp hold n keys each (keys is filled
+// here). Returns whichever of keys and tmp holds the order. When all but a few
+// strings are 10-digit phones, their packed values go through the LSD radix
+// sort instead and the rest are merged in.
+ENGINE_API EngineKey *engine_sort_strings(EngineKey *keys, EngineKey *tmp, const char *const *strs, int n, int threads);
+// Workers to sort n keys with: 1 below threshold (and always on Windows), else
+// threads (0: one per online CPU), fewer if the chunks would get too small.
+ENGINE_API int engine_sort_threads(int n, int threshold, int threads);
+// The same for other work on n items: 1 below threshold (and always on
+// Windows), else threads (0: one per online CPU, at most
+// ENGINE_SORT_MAX_THREADS), fewer if a share would drop under min_share items.
+ENGINE_API int engine_thread_count(int n, int threshold, int threads, int min_share);
+// Runs run() on each of count args, laid out arg_size bytes apart from args:
+// the first on the calling thread, the rest on helper threads kept between
+// calls (on the caller if one fails to start, if another call holds the
+// helpers, and always on Windows). Returns when all have.
+ENGINE_API void engine_run_parallel(void *(*run)(void *), void *args, size_t arg_size, int count);
+// Stable sort of a singly linked list of count nodes by the string at
+// field_off in each node; the next pointer sits at next_off. Returns the new
+// head. If the key arrays can't be allocated it merge sorts the nodes in place.
+ENGINE_API void *engine_sort_list(void *head, int count, size_t next_off, size_t field_off, int threads);
+// Puts keys[offset, offset + limit) in the order engine_sort_strings gives
+// those positions, without sorting the rest: introselect places the page's two
+// boundaries, introsort orders the page, O(n + limit log limit). keys holds n
+// keys (filled here); needs 0 <= offset and offset + limit <= n.
+ENGINE_API void engine_sort_page(EngineKey *keys, const char *const *strs, int n, int offset, int limit);
+
+// --- Capacity ---
+// A growable array goes to twice its capacity, or straight to what is asked
+// when that is more (a bulk load gets an exact fit), so n appends copy O(n)
+// records in total. Once its count falls to a quarter of the capacity it
+// shrinks to twice the count: half full, so the next grow or shrink is at
+// least count/2 operations away.
+#define ENGINE_CAPACITY_MIN 10
+#define ENGINE_SHRINK_RATIO 4
+
+ENGINE_API int engine_grow_capacity(int capacity, int need);    // Capacity to grow to for need records (>= need)
+ENGINE_API int engine_shrink_capacity(int capacity, int count); // Capacity to shrink to, or capacity to keep it
+
+// --- Bloom Filter ---
+// Blocked Bloom filter: a key sets one bit in each of the eight words of a
+// 64-byte block picked by its hash, so a lookup touches one cache line. With
+// 20 bits per key about one absent key in 10^4 reads as "maybe". A filter
+// whose words could not be allocated answers "maybe" to everything.
+#define ENGINE_BLOOM_BITS_PER_KEY 20
+#define ENGINE_BLOOM_MIN_KEYS 1024
+
+typedef struct {
+    uint64_t *words; // 8 per block
+    size_t blocks;
+} EngineBloom;
+
+ENGINE_API int engine_bloom_init(EngineBloom *f, size_t keys); // Sized for at least keys; 0, or -1 if memory is short
+ENGINE_API void engine_bloom_free(EngineBloom *f);
+ENGINE_API void engine_bloom_add(EngineBloom *f, const char *key);
+ENGINE_API int engine_bloom_maybe(const EngineBloom *f, const char *key); // 0 if key was never added
+
+// --- Id Table ---
+// Maps the ids of live records to their slot (.idx) or node (.ref): open
+// addressing with linear probing, deletes shift the probe run back instead of
+// leaving tombstones. The table doubles past half full and halves below an
+// eighth, so its size follows the live count, not the number of ids ever
+// issued. Id 0 marks an empty entry and is never stored.
+#define ENGINE_IDS_MIN 64
+
+typedef struct {
+    EngineKey *slots; // .key is the id, 0 if empty
+    size_t mask;      // Entries - 1, 0 while slots is NULL
+    size_t count;
+} EngineIds;
+
+ENGINE_API EngineKey *engine_ids_insert(EngineIds *t, uint64_t id); // Entry for a new id to fill in, or NULL if memory is short
+ENGINE_API EngineKey *engine_ids_find(const EngineIds *t, uint64_t id); // NULL if id is not stored
+ENGINE_API void engine_ids_remove(EngineIds *t, uint64_t id);
+ENGINE_API void engine_ids_free(EngineIds *t);
+
+// --- Sorted Views ---
+// An order-statistic treap per sort field, kept current by every write so a
+// repeated sort, a sorted page or a prefix seek never compares records. Tree
+// nodes sit in front-end structs that say which record they stand for, and
+// the view reads that record's key through key(). Equal keys are ordered by
+// the record id the front end stores in the node, so a view replays exactly
+// the (key, id) order a fresh sort gives, whatever order the records were
+// inserted in. Nodes are allocated and freed by the front end.
+typedef struct EngineViewNode {
+    struct EngineViewNode *left, *right, *parent;
+    int size;      // Records in this subtree
+    uint32_t prio; // Max-heap priority
+    uint64_t id;   // Record id, set by the front end before build or insert
+} EngineViewNode;
+
+typedef struct EngineView {
+    EngineViewNode *root;
+    size_t field_off; // Of the key in the front end's record, for key()
+    int built;
+    const char *(*key)(const struct EngineView *v, const EngineViewNode *x);
+} EngineView;
+
+// Links nodes, already in (key, id) order, into v and marks it built, O(n).
+// Returns 0, or -1 if memory is short (v is unchanged).
+ENGINE_API int engine_view_build(EngineView *v, EngineViewNode *const *nodes, int n);
+ENGINE_API void engine_view_insert(EngineView *v, EngineViewNode *x); // At its (key, id) position
+ENGINE_API void engine_view_erase(EngineView *v, EngineViewNode *x); // Unlinks x; the caller frees it
+ENGINE_API EngineViewNode *engine_view_first(const EngineView *v); // NULL if empty
+ENGINE_API EngineViewNode *engine_view_next(EngineViewNode *t); // In-order successor, or NULL
+ENGINE_API EngineViewNode *engine_view_select(const EngineView *v, int k); // At 0-based position k, or NULL
+ENGINE_API EngineViewNode *engine_view_lower_bound(const EngineView *v, const char *key); // First with key >= key, or NULL
+
+// --- Substring Search ---
+// Returns the fastest test of "field contains query" for queries of query_len
+// bytes: AVX2 or SSE2 where the CPU has them, else strstr. field must be a full
+// ENGINE_FIELD_BYTES array (the kernels load whole windows of it); a match
+// never starts past its terminator.
+typedef int (*EngineFieldMatcher)(const char *field, const char *query, size_t query_len);
+
+ENGINE_API EngineFieldMatcher engine_field_matcher(size_t query_len);
+
+// --- Query ---
+// A query is a boolean expression over per-field clauses, for example
+//     name contains smith AND (email suffix "@gmail.com" OR NOT phone prefix 555)
+//     expr   := term { OR term }
+//     term   := factor { AND factor }
+//     factor := NOT factor | '(' expr ')' | field op value
+//     field  := name | phone | email
+//     op     := contains | prefix | suffix | equals
+//     value  := word | "quoted text"
+// Keywords are case-insensitive. It is compiled once into a jump program that
+// runs the cheapest clauses first and short-circuits. Clauses read the field at
+// field_offs[field - 1] in the record; with fold set the values are case-folded
+// and the caller points the offsets at folded copies of the fields.
+#define ENGINE_QUERY_CONTAINS 0
+#define ENGINE_QUERY_PREFIX   1
+#define ENGINE_QUERY_SUFFIX   2
+#define ENGINE_QUERY_EQUALS   3
+
+typedef struct {
+    int field, op;      // ENGINE_FIELD_*, ENGINE_QUERY_*
+    size_t field_off, len;
+    EngineFieldMatcher contains;
+    char value[ENGINE_FIELD_BYTES];
+} EngineQueryClause;
+
+typedef struct {
+    int code, arg; // arg: clause index for a test, jump target otherwise
+} EngineQueryInsn;
+
+typedef struct EngineQuery {
+    EngineQueryClause *clauses;
+    int nclauses;
+    EngineQueryInsn *code;
+    int ncode;
+    int *seeks; // Top-level equals/prefix clauses every match satisfies, cheapest first:
+    int nseeks; // a caller with a sorted index on the field can visit just that range
+} EngineQuery;
+
+// Returns the compiled query, or NULL with a message in error (error_size bytes)
+// on a syntax error or if memory is short.
+ENGINE_API EngineQuery *engine_query_compile(const char *text, const size_t field_offs[3], int fold, char *error, size_t error_size);
+ENGINE_API int engine_query_match(const EngineQuery *q, const void *record); // 1 if record matches
+ENGINE_API void engine_query_free(EngineQuery *q);
+
+// --- Phonetic Index ---
+// "Sounds like" lookup on names. Each of the first ENGINE_SOUND_WORDS words of a
+// name gets an American Soundex code (Smith and Smyth are both S530). A record
+// embeds an EngineSoundEntry, and the index maps every code to the entries that
+// carry it; callers get the record back from the entry's offset in it. Writes
+// keep the index current in O(1) per code.
+#define ENGINE_SOUND_WORDS 4
+#define ENGINE_SOUND_CODES (26 * 7 * 7 * 7 + 1) // Letter plus three digits 0-6; 0 means "no word"
+
+typedef struct {
+    uint16_t codes[ENGINE_SOUND_WORDS]; // Codes of the first name words (0: none)
+    int pos[ENGINE_SOUND_WORDS];        // Slot in each code's bucket (-1: not filed there)
+} EngineSoundEntry;
+
+typedef struct {
+    EngineSoundEntry **entries;
+    int count, cap;
+} EngineSoundBucket;
+
+typedef struct {
+    EngineSoundBucket buckets[ENGINE_SOUND_CODES]; // Indexed by code
+    int stale; // A bucket failed to grow; the caller refiles every record before the next lookup
+} EngineSound;
+
+ENGINE_API void engine_sound_codes(const char *name, uint16_t codes[ENGINE_SOUND_WORDS]);
+ENGINE_API void engine_sound_insert(EngineSound *ix, EngineSoundEntry *e, const char *name); // Files e under name's codes
+ENGINE_API void engine_sound_erase(EngineSound *ix, EngineSoundEntry *e);
+ENGINE_API void engine_sound_free(EngineSound *ix); // Empties the index and clears stale
+// Entries whose name has a word sounding like every word of query, in bucket
+// order, as a malloc'd array of *count. NULL when none match, with *count -1 if
+// memory is short.
+ENGINE_API EngineSoundEntry **engine_sound_find(const EngineSound *ix, const char *query, int *count);
+
+// --- Regex ---
+// Literals, '.', [classes] with ranges and a leading ^ to negate, the \d \w \s
+// shorthands and their upper-case negations, backslash escapes, (groups), '|',
+// the quantifiers * + ? {m} {m,} {m,n}, and the anchors ^ and $. The pattern is
+// compiled to a DFA over byte classes, so a field is matched with one table
+// lookup per byte and no backtracking. With fold set, letters match either
+// case; the caller matches case-folded fields.
+#define ENGINE_REGEX_ACCEPT 1        // A match has been seen
+#define ENGINE_REGEX_ACCEPT_AT_END 2 // A match completes if the field ends here
+
+typedef struct {
+    uint8_t cls[256];  // Byte -> equivalence class
+    int nclasses;
+    int *trans;        // [state * nclasses + class] -> state
+    uint8_t *accept;   // ENGINE_REGEX_ACCEPT, ENGINE_REGEX_ACCEPT_AT_END
+    int start;
+    int dead;          // State no match can leave, or -1
+    int anchored;      // Every match starts at ^
+    char prefix[ENGINE_FIELD_BYTES];  // Literal right after a leading ^ (lower case when folded)
+    char literal[ENGINE_FIELD_BYTES]; // Longest literal every match contains (lower case when folded)
+} EngineRegex;
+
+// Returns the compiled pattern, or NULL with *error set to a static message.
+ENGINE_API EngineRegex *engine_regex_compile(const char *pattern, int fold, const char **error);
+ENGINE_API int engine_regex_match(const EngineRegex *re, const char *field);
+ENGINE_API void engine_regex_free(EngineRegex *re);
+
+// --- Store ---
+// A contact store keeps records in the order they were appended until it is
+// sorted. The backend decides the layout; everything else in the engine only
+// goes through these operations, so the same commands run on any backend.
+typedef struct {
+    const char *name;
+    void *(*open)(void);                                // New empty store, or NULL
+    void (*close)(void *s);
+    int (*count)(const void *s);
+    int (*append)(void *s, const EngineRecord *r);      // 0, or -1 if memory is short
+    EngineRecord *(*first)(void *s);                    // NULL when empty
+    EngineRecord *(*next)(void *s, EngineRecord *r);    // NULL after the last
+    int (*reorder)(void *s, EngineRecord **order);      // Position i gets *order[i] (all count records); 0 or -1
+    void (*remove)(void *s, const char *drop);          // Drops the records whose drop[position] is set, keeping order
+} EngineBackend;
+
+ENGINE_API extern const EngineBackend engine_array_backend; // Growable array of records
+ENGINE_API extern const EngineBackend engine_list_backend;  // Singly linked list of nodes
+
+typedef struct {
+    const EngineBackend *backend;
+    void *impl;
+} EngineStore;
+
+ENGINE_API int engine_store_open(EngineStore *st, const EngineBackend *backend); // 0, or -1 if memory is short
+ENGINE_API void engine_store_close(EngineStore *st);
+ENGINE_API int engine_store_load(EngineStore *st, const char *path); // Appends the CSV's records; count, or -1 if unreadable
+ENGINE_API int engine_store_save(EngineStore *st, const char *path); // 0, or -1 on an I/O error
+ENGINE_API int engine_store_sort(EngineStore *st, int field);        // Stable; 0, or -1 if memory is short
+
+// Runs one headless subcommand on a store of the given backend:
+//   [-f FILE] [--tsv] import CSV | search FIELD TEXT | sort FIELD | export | dedupe [FIELD]
+// Returns the exit status: 0 ok, 1 I/O or memory error, 2 usage error.
+ENGINE_API int engine_command(const EngineBackend *backend, int argc, char *argv[]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DONNA_ENGINE_H
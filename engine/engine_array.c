@@ -0,0 +1,90 @@
+// engine_array.c
+// Array backend: records sit back to back in one growable block, sized by the
+// engine's capacity policy. Iteration is a pointer bump, reorder is one pass
+// into a fresh block, and remove slides the survivors down in one pass.
+#include "engine.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    EngineRecord *recs;
+    int count;
+    int capacity;
+} ArrayStore;
+
+// Reallocs recs to cap records. Returns 0, or -1 (recs unchanged) if memory is short.
+static int array_resize(ArrayStore *a, int cap) {
+    EngineRecord *resized = (EngineRecord*)realloc(a->recs, (size_t)cap * sizeof(EngineRecord));
+    if (!resized) return -1;
+    a->recs = resized;
+    a->capacity = cap;
+    return 0;
+}
+
+static void *array_open(void) {
+    return calloc(1, sizeof(ArrayStore));
+}
+
+static void array_close(void *s) {
+    ArrayStore *a = (ArrayStore*)s;
+    if (!a) return;
+    free(a->recs);
+    free(a);
+}
+
+static int array_count(const void *s) {
+    return ((const ArrayStore*)s)->count;
+}
+
+static int array_append(void *s, const EngineRecord *r) {
+    ArrayStore *a = (ArrayStore*)s;
+    if (a->count == a->capacity && array_resize(a, engine_grow_capacity(a->capacity, a->count + 1)) != 0) return -1;
+    a->recs[a->count++] = *r;
+    return 0;
+}
+
+static EngineRecord *array_first(void *s) {
+    ArrayStore *a = (ArrayStore*)s;
+    return a->count > 0 ? a->recs : NULL;
+}
+
+static EngineRecord *array_next(void *s, EngineRecord *r) {
+    ArrayStore *a = (ArrayStore*)s;
+    return r + 1 < a->recs + a->count ? r + 1 : NULL;
+}
+
+static int array_reorder(void *s, EngineRecord **order) {
+    ArrayStore *a = (ArrayStore*)s;
+    EngineRecord *sorted = (EngineRecord*)malloc((size_t)a->capacity * sizeof(EngineRecord));
+    if (!sorted) return -1;
+    for (int i = 0; i < a->count; i++) sorted[i] = *order[i];
+    free(a->recs);
+    a->recs = sorted;
+    return 0;
+}
+
+static void array_remove(void *s, const char *drop) {
+    ArrayStore *a = (ArrayStore*)s;
+    int to = 0;
+    for (int i = 0; i < a->count; i++) {
+        if (drop[i]) continue;
+        if (to != i) a->recs[to] = a->recs[i];
+        to++;
+    }
+    a->count = to;
+    int cap = engine_shrink_capacity(a->capacity, a->count);
+    if (cap != a->capacity) array_resize(a, cap); // A failed shrink keeps the larger block
+}
+
+ENGINE_API const EngineBackend engine_array_backend = {
+    "array",
+    array_open,
+    array_close,
+    array_count,
+    array_append,
+    array_first,
+    array_next,
+    array_reorder,
+    array_remove,
+};
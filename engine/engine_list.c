@@ -0,0 +1,102 @@
+// engine_list.c
+// List backend: one heap node per record, singly linked in store order, with
+// a tail pointer so appends stay O(1). The record is the node's first member,
+// so a record pointer is its node pointer. Reorder and remove only relink.
+#include "engine.h"
+
+#include <stdlib.h>
+
+typedef struct ListNode {
+    EngineRecord rec; // First, see above
+    struct ListNode *next;
+} ListNode;
+
+typedef struct {
+    ListNode *head;
+    ListNode **tail; // The last node's next, or &head
+    int count;
+} ListStore;
+
+static void *list_open(void) {
+    ListStore *l = (ListStore*)calloc(1, sizeof(ListStore));
+    if (l) l->tail = &l->head;
+    return l;
+}
+
+static void list_close(void *s) {
+    ListStore *l = (ListStore*)s;
+    if (!l) return;
+    while (l->head) {
+        ListNode *next = l->head->next;
+        free(l->head);
+        l->head = next;
+    }
+    free(l);
+}
+
+static int list_count(const void *s) {
+    return ((const ListStore*)s)->count;
+}
+
+static int list_append(void *s, const EngineRecord *r) {
+    ListStore *l = (ListStore*)s;
+    ListNode *n = (ListNode*)malloc(sizeof(ListNode));
+    if (!n) return -1;
+    n->rec = *r;
+    n->next = NULL;
+    *l->tail = n;
+    l->tail = &n->next;
+    l->count++;
+    return 0;
+}
+
+static EngineRecord *list_first(void *s) {
+    ListStore *l = (ListStore*)s;
+    return l->head ? &l->head->rec : NULL;
+}
+
+static EngineRecord *list_next(void *s, EngineRecord *r) {
+    (void)s;
+    ListNode *next = ((ListNode*)r)->next;
+    return next ? &next->rec : NULL;
+}
+
+static int list_reorder(void *s, EngineRecord **order) {
+    ListStore *l = (ListStore*)s;
+    l->tail = &l->head;
+    for (int i = 0; i < l->count; i++) {
+        ListNode *n = (ListNode*)order[i];
+        *l->tail = n;
+        l->tail = &n->next;
+    }
+    *l->tail = NULL;
+    return 0;
+}
+
+static void list_remove(void *s, const char *drop) {
+    ListStore *l = (ListStore*)s;
+    ListNode **link = &l->head;
+    for (int i = 0; *link; i++) {
+        ListNode *n = *link;
+        if (drop[i]) {
+            *link = n->next;
+            free(n);
+            l->count--;
+        } else {
+            link = &n->next;
+        }
+    }
+    l->tail = link;
+}
+
+ENGINE_API const EngineBackend engine_list_backend = {
+    "list",
+    list_open,
+    list_close,
+    list_count,
+    list_append,
+    list_first,
+    list_next,
+    list_reorder,
+    list_remove,
+};
@@ -0,0 +1,435 @@
+// engine_regex.c
+// Regex compiler and matcher of the storage engine (see engine.h for the
+// syntax). The pattern is parsed into a tree and built into a Thompson NFA.
+// The NFA is then fully determinized (subset construction over byte
+// equivalence classes), so a field is matched with one table lookup per byte
+// and no backtracking. The anchors are zero-width: ^ is only crossed while
+// building the start state, and $ only when the field has been consumed, so
+// they stay exact inside groups, alternations and repeats.
+// Callers get the pattern's longest mandatory literal, to use as a substring
+// prefilter, and an anchored literal prefix (^abc...), to seek a sorted index
+// with instead of scanning.
+#include "engine.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define REGEX_SYMBOLS 256
+#define REGEX_MAX_PATTERN 256
+#define REGEX_MAX_AST (2 * REGEX_MAX_PATTERN + 2)
+#define REGEX_MAX_NFA 4096
+#define REGEX_MAX_DFA 1024
+#define REGEX_MAX_REPEAT (ENGINE_FIELD_BYTES - 1) // No field is longer
+
+typedef struct {
+    uint32_t bits[(REGEX_SYMBOLS + 31) / 32];
+} RegexSet;
+
+enum { RX_SET, RX_CAT, RX_ALT, RX_REPEAT, RX_EMPTY, RX_BEGIN, RX_END };
+
+typedef struct {
+    int kind;
+    int left, right; // Children; a repeat uses left only
+    int min, max;    // Repeat bounds, max -1 = unbounded
+    RegexSet set;
+} RegexAst;
+
+enum { NFA_SET, NFA_SPLIT, NFA_MATCH, NFA_BEGIN, NFA_END };
+
+typedef struct {
+    int kind;
+    int set;       // AST node holding the symbol set, for NFA_SET
+    int out, out1; // out1 is the second branch of NFA_SPLIT
+} RegexNfa;
+
+typedef struct {
+    const char *pattern;
+    size_t pos;
+    RegexAst ast[REGEX_MAX_AST];
+    int nast;
+    RegexNfa nfa[REGEX_MAX_NFA];
+    int nnfa;
+    int fold; // Letters match either case
+    const char *error;
+} RegexBuilder;
+
+static void regex_set_add(RegexSet *s, int sym) { s->bits[sym >> 5] |= 1u << (sym & 31); }
+static int regex_set_has(const RegexSet *s, int sym) { return (s->bits[sym >> 5] >> (sym & 31)) & 1; }
+
+static void regex_set_range(RegexSet *s, int lo, int hi, int fold) {
+    for (int c = lo; c <= hi; c++) {
+        regex_set_add(s, c);
+        if (!fold) continue;
+        if (c >= 'A' && c <= 'Z') regex_set_add(s, c - 'A' + 'a');
+        else if (c >= 'a' && c <= 'z') regex_set_add(s, c - 'a' + 'A');
+    }
+}
+
+// Adds the class named by a backslash escape (d, w, s; upper case negates),
+// or the escaped character itself.
+static void regex_set_escape(RegexSet *s, char e, int fold) {
+    RegexSet named = { { 0 } };
+    char lower = e >= 'A' && e <= 'Z' ? e - 'A' + 'a' : e;
+    if (lower == 'd') regex_set_range(&named, '0', '9', 0);
+    else if (lower == 'w') { regex_set_range(&named, 'a', 'z', 0); regex_set_range(&named, 'A', 'Z', 0); regex_set_range(&named, '0', '9', 0); regex_set_add(&named, '_'); }
+    else if (lower == 's') { regex_set_add(&named, ' '); regex_set_range(&named, '\t', '\r', 0); }
+    else { regex_set_range(s, (unsigned char)e, (unsigned char)e, fold); return; }
+    int negate = e != lower;
+    for (int c = 0; c < REGEX_SYMBOLS; c++) if (regex_set_has(&named, c) != negate) regex_set_add(s, c);
+}
+
+static int regex_ast(RegexBuilder *B, int kind, int left, int right) {
+    if (B->nast == REGEX_MAX_AST) { B->error = "Error: Pattern too long."; return -1; }
+    RegexAst *a = &B->ast[B->nast];
+    memset(a, 0, sizeof(*a));
+    a->kind = kind; a->left = left; a->right = right;
+    return B->nast++;
+}
+
+static int regex_parse_alt(RegexBuilder *B);
+
+static int regex_parse_class(RegexBuilder *B, int n) {
+    const char *p = B->pattern;
+    RegexSet *s = &B->ast[n].set, members = { { 0 } };
+    int negate = p[B->pos] == '^';
+    if (negate) B->pos++;
+    int first = 1;
+    while (p[B->pos] && (p[B->pos] != ']' || first)) {
+        first = 0;
+        int lo = (unsigned char)p[B->pos++];
+        if (lo == '\\') {
+            if (!p[B->pos]) break;
+            char e = p[B->pos++];
+            if (strchr("dDwWsS", e)) { regex_set_escape(&members, e, B->fold); continue; }
+            lo = (unsigned char)e;
+        }
+        int hi = lo;
+        if (p[B->pos] == '-' && p[B->pos + 1] && p[B->pos + 1] != ']') {
+            B->pos++;
+            hi = (unsigned char)p[B->pos++];
+            if (hi == '\\' && p[B->pos]) hi = (unsigned char)p[B->pos++];
+            if (hi < lo) { B->error = "Error: Invalid range in character class."; return -1; }
+        }
+        regex_set_range(&members, lo, hi, B->fold);
+    }
+    if (p[B->pos] != ']') { B->error = "Error: Missing ']'."; return -1; }
+    B->pos++;
+    for (int c = 0; c < REGEX_SYMBOLS; c++) if (regex_set_has(&members, c) != negate) regex_set_add(s, c);
+    return n;
+}
+
+static int regex_parse_atom(RegexBuilder *B) {
+    const char *p = B->pattern;
+    char c = p[B->pos];
+    if (c == '(') {
+        B->pos++;
+        int inner = regex_parse_alt(B);
+        if (inner < 0) return -1;
+        if (p[B->pos] != ')') { B->error = "Error: Missing ')'."; return -1; }
+        B->pos++;
+        return inner;
+    }
+    if (c == '*' || c == '+' || c == '?') { B->error = "Error: Quantifier without a preceding item."; return -1; }
+    int n = regex_ast(B, c == '^' ? RX_BEGIN : c == '$' ? RX_END : RX_SET, -1, -1);
+    if (n < 0) return -1;
+    RegexSet *s = &B->ast[n].set;
+    B->pos++;
+    if (c == '[') return regex_parse_class(B, n);
+    if (c == '.') { for (int b = 1; b < REGEX_SYMBOLS; b++) regex_set_add(s, b); }
+    else if (c == '^' || c == '$') return n;
+    else if (c == '\\') {
+        if (!p[B->pos]) { B->error = "Error: Pattern ends with '\\'."; return -1; }
+        regex_set_escape(s, p[B->pos++], B->fold);
+    } else regex_set_range(s, (unsigned char)c, (unsigned char)c, B->fold);
+    return n;
+}
+
+// Reads a {m}, {m,} or {m,n} bound; returns 0 if the brace is not a bound.
+static int regex_parse_bound(RegexBuilder *B, int *min, int *max) {
+    const char *p = B->pattern + B->pos + 1;
+    char *end;
+    if (*p < '0' || *p > '9') return 0;
+    long lo = strtol(p, &end, 10), hi = lo;
+    if (*end == ',') {
+        p = end + 1;
+        if (*p >= '0' && *p <= '9') hi = strtol(p, &end, 10);
+        else { hi = -1; end = (char*)p; }
+    }
+    if (*end != '}') return 0;
+    if (lo > REGEX_MAX_REPEAT || hi > REGEX_MAX_REPEAT || (hi >= 0 && hi < lo)) return -1;
+    *min = (int)lo; *max = (int)hi;
+    B->pos = end + 1 - B->pattern;
+    return 1;
+}
+
+static int regex_parse_repeat(RegexBuilder *B) {
+    int n = regex_parse_atom(B);
+    for (;;) {
+        if (n < 0) return -1;
+        char c = B->pattern[B->pos];
+        int min, max;
+        if (c == '*') { min = 0; max = -1; B->pos++; }
+        else if (c == '+') { min = 1; max = -1; B->pos++; }
+        else if (c == '?') { min = 0; max = 1; B->pos++; }
+        else if (c == '{') {
+            int r = regex_parse_bound(B, &min, &max);
+            if (r < 0) { B->error = "Error: Invalid repeat bound."; return -1; }
+            if (r == 0) return n; // A literal '{' starts the next atom
+        } else return n;
+        int r = regex_ast(B, RX_REPEAT, n, -1);
+        if (r < 0) return -1;
+        B->ast[r].min = min; B->ast[r].max = max;
+        n = r;
+    }
+}
+
+static int regex_parse_cat(RegexBuilder *B) {
+    int n = -1;
+    while (B->pattern[B->pos] && B->pattern[B->pos] != '|' && B->pattern[B->pos] != ')') {
+        int item = regex_parse_repeat(B);
+        if (item < 0) return -1;
+        n = n < 0 ? item : regex_ast(B, RX_CAT, n, item);
+        if (n < 0) return -1;
+    }
+    return n < 0 ? regex_ast(B, RX_EMPTY, -1, -1) : n;
+}
+
+static int regex_parse_alt(RegexBuilder *B) {
+    int n = regex_parse_cat(B);
+    while (n >= 0 && B->pattern[B->pos] == '|') {
+        B->pos++;
+        int right = regex_parse_cat(B);
+        n = right < 0 ? -1 : regex_ast(B, RX_ALT, n, right);
+    }
+    return n;
+}
+
+static int regex_nfa(RegexBuilder *B, int kind, int set, int out, int out1) {
+    if (B->nnfa == REGEX_MAX_NFA) { B->error = "Error: Pattern too complex."; return -1; }
+    B->nfa[B->nnfa] = (RegexNfa){ kind, set, out, out1 };
+    return B->nnfa++;
+}
+
+// Builds the NFA for AST node n followed by NFA state next; returns its entry state.
+static int regex_build(RegexBuilder *B, int n, int next) {
+    const RegexAst *a = &B->ast[n];
+    if (next < 0) return -1;
+    switch (a->kind) {
+    case RX_SET:   return regex_nfa(B, NFA_SET, n, next, -1);
+    case RX_CAT:   return regex_build(B, a->left, regex_build(B, a->right, next));
+    case RX_EMPTY: return next;
+    case RX_BEGIN: return regex_nfa(B, NFA_BEGIN, -1, next, -1);
+    case RX_END:   return regex_nfa(B, NFA_END, -1, next, -1);
+    case RX_ALT: {
+        int l = regex_build(B, a->left, next), r = regex_build(B, a->right, next);
+        return l < 0 || r < 0 ? -1 : regex_nfa(B, NFA_SPLIT, -1, l, r);
+    }
+    default: { // RX_REPEAT, built back to front: optional tail, then the mandatory copies
+        int tail = next;
+        if (a->max < 0) {
+            int loop = regex_nfa(B, NFA_SPLIT, -1, -1, next);
+            if (loop < 0) return -1;
+            int body = regex_build(B, a->left, loop);
+            if (body < 0) return -1;
+            B->nfa[loop].out = body;
+            tail = loop;
+        } else {
+            for (int i = a->min; i < a->max && tail >= 0; i++) {
+                int body = regex_build(B, a->left, tail);
+                tail = body < 0 ? -1 : regex_nfa(B, NFA_SPLIT, -1, body, next);
+            }
+        }
+        for (int i = 0; i < a->min && tail >= 0; i++) tail = regex_build(B, a->left, tail);
+        return tail;
+    }
+    }
+}
+
+// Single character a set stands for, or -1. When folding, both cases of one
+// letter count as that letter in lower case.
+static int regex_set_literal(const RegexSet *s, int fold) {
+    int lit = -1;
+    for (int c = 0; c < REGEX_SYMBOLS; c++) {
+        if (!regex_set_has(s, c)) continue;
+        int folded = fold && c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c;
+        if (lit >= 0 && lit != folded) return -1;
+        lit = folded;
+    }
+    return lit;
+}
+
+// Walks the top-level concatenation in order, tracking literal runs: the first
+// run (when it directly follows a leading ^) and the longest one.
+static void regex_literals(const RegexBuilder *B, int n, EngineRegex *re, char *run, int *at_start) {
+    const RegexAst *a = &B->ast[n];
+    if (a->kind == RX_CAT) {
+        regex_literals(B, a->left, re, run, at_start);
+        regex_literals(B, a->right, re, run, at_start);
+        return;
+    }
+    size_t len = strlen(run);
+    int lit = a->kind == RX_SET ? regex_set_literal(&a->set, B->fold) : -1;
+    if (lit > 0 && len + 1 < ENGINE_FIELD_BYTES) {
+        run[len] = (char)lit; run[len + 1] = '\0';
+        if (re->anchored && *at_start) strcpy(re->prefix, run);
+        if (len + 1 > strlen(re->literal)) strcpy(re->literal, run);
+        return;
+    }
+    if (a->kind == RX_BEGIN && *at_start && len == 0 && !re->anchored) { re->anchored = 1; return; }
+    *at_start = 0;
+    run[0] = '\0';
+}
+
+// Adds state s and everything reachable from it without input to the set.
+// Anchor states are crossed only when `anchor` names their kind.
+static void regex_closure(const RegexBuilder *B, uint64_t *set, int s, int *stack, int anchor) {
+    int top = 0;
+    stack[top++] = s;
+    while (top > 0) {
+        s = stack[--top];
+        if (set[s >> 6] >> (s & 63) & 1) continue;
+        set[s >> 6] |= 1ull << (s & 63);
+        const RegexNfa *n = &B->nfa[s];
+        if (n->kind == NFA_SPLIT) { stack[top++] = n->out1; stack[top++] = n->out; }
+        else if (n->kind == anchor) stack[top++] = n->out;
+    }
+}
+
+ENGINE_API void engine_regex_free(EngineRegex *re) {
+    if (!re) return;
+    free(re->trans);
+    free(re->accept);
+    free(re);
+}
+
+static uint64_t regex_hash(const uint64_t *set, size_t words) {
+    uint64_t h = 1469598103934665603ull; // FNV-1a over the words
+    for (size_t w = 0; w < words; w++) h = (h ^ set[w]) * 1099511628211ull;
+    return h;
+}
+
+
+// Subset construction. DFA states are NFA state sets, found again through an
+// open-addressing table; accepting and empty sets get no outgoing edges
+// because matching stops there.
+static int regex_determinize(const RegexBuilder *B, int start, int match, EngineRegex *re) {
+    // Byte classes: symbols that every set treats alike share a class
+    int cls[REGEX_SYMBOLS] = { 0 }, ncls = 1;
+    for (int n = 0; n < B->nast; n++) {
+        if (B->ast[n].kind != RX_SET) continue;
+        int split[2 * REGEX_SYMBOLS];
+        for (int c = 0; c < 2 * ncls; c++) split[c] = -1;
+        ncls = 0;
+        for (int sym = 0; sym < REGEX_SYMBOLS; sym++) {
+            int *slot = &split[2 * cls[sym] + regex_set_has(&B->ast[n].set, sym)];
+            if (*slot < 0) *slot = ncls++;
+            cls[sym] = *slot;
+        }
+    }
+    int rep[REGEX_SYMBOLS];
+    for (int sym = REGEX_SYMBOLS - 1; sym >= 0; sym--) { re->cls[sym] = (uint8_t)cls[sym]; rep[cls[sym]] = sym; }
+    re->nclasses = ncls;
+
+    size_t words = (B->nnfa + 63) / 64, hash_size = 2 * REGEX_MAX_DFA;
+    uint64_t *sets = (uint64_t*)calloc((size_t)(REGEX_MAX_DFA + 1) * words, sizeof(uint64_t)); // +1: scratch set
+    int *hash = (int*)malloc(hash_size * sizeof(int));
+    int *stack = (int*)malloc((2 * B->nnfa + 1) * sizeof(int));
+    re->trans = (int*)malloc((size_t)REGEX_MAX_DFA * ncls * sizeof(int));
+    re->accept = (uint8_t*)calloc(REGEX_MAX_DFA, 1);
+    if (!sets || !hash || !stack || !re->trans || !re->accept) { free(sets); free(hash); free(stack); return -1; }
+
+    for (size_t i = 0; i < hash_size; i++) hash[i] = -1;
+    regex_closure(B, sets, start, stack, NFA_BEGIN);
+    hash[regex_hash(sets, words) % hash_size] = 0;
+    re->start = 0;
+    re->dead = -1;
+    int nstates = 1, ok = 1;
+    uint64_t *next = sets + (size_t)REGEX_MAX_DFA * words;
+    for (int d = 0; ok && d < nstates; d++) {
+        const uint64_t *cur = sets + (size_t)d * words;
+        int empty = 1;
+        for (size_t w = 0; w < words; w++) empty &= cur[w] == 0;
+        if (empty) re->dead = d;
+        re->accept[d] = (cur[match >> 6] >> (match & 63)) & 1;
+        if (!re->accept[d] && !empty) { // Cross the $ states to see whether the end completes a match
+            memset(next, 0, words * sizeof(uint64_t));
+            for (int s = 0; s < B->nnfa; s++)
+                if ((cur[s >> 6] >> (s & 63) & 1) && B->nfa[s].kind == NFA_END) regex_closure(B, next, s, stack, NFA_END);
+            if ((next[match >> 6] >> (match & 63)) & 1) re->accept[d] = ENGINE_REGEX_ACCEPT_AT_END;
+        }
+        for (int c = 0; c < ncls; c++) {
+            if (re->accept[d] == ENGINE_REGEX_ACCEPT || empty) { re->trans[d * ncls + c] = d; continue; }
+            memset(next, 0, words * sizeof(uint64_t));
+            for (int s = 0; s < B->nnfa; s++) {
+                if ((cur[s >> 6] >> (s & 63) & 1) && B->nfa[s].kind == NFA_SET
+                    && regex_set_has(&B->ast[B->nfa[s].set].set, rep[c]))
+                    regex_closure(B, next, B->nfa[s].out, stack, -1); // Crosses no anchor
+            }
+            size_t slot = regex_hash(next, words) % hash_size;
+            while (hash[slot] >= 0 && memcmp(sets + (size_t)hash[slot] * words, next, words * sizeof(uint64_t)) != 0)
+                slot = (slot + 1) % hash_size;
+            if (hash[slot] < 0) {
+                if (nstates == REGEX_MAX_DFA) { ok = 0; break; }
+                memcpy(sets + (size_t)nstates * words, next, words * sizeof(uint64_t));
+                hash[slot] = nstates++;
+            }
+            re->trans[d * ncls + c] = hash[slot];
+        }
+    }
+    free(sets);
+    free(hash);
+    free(stack);
+    return ok ? 0 : -1;
+}
+
+ENGINE_API EngineRegex *engine_regex_compile(const char *pattern, int fold, const char **error) {
+    *error = "Error: Memory allocation failed.";
+    if (strlen(pattern) > REGEX_MAX_PATTERN) { *error = "Error: Pattern too long."; return NULL; }
+    RegexBuilder *B = (RegexBuilder*)calloc(1, sizeof(RegexBuilder));
+    EngineRegex *re = (EngineRegex*)calloc(1, sizeof(EngineRegex));
+    if (!B || !re) { free(B); free(re); return NULL; }
+    B->pattern = pattern;
+    B->fold = fold;
+
+    int root = regex_parse_alt(B);
+    if (root >= 0 && pattern[B->pos]) { B->error = "Error: Unmatched ')'."; root = -1; }
+    int match = root >= 0 ? regex_nfa(B, NFA_MATCH, -1, -1, -1) : -1;
+    int entry = match >= 0 ? regex_build(B, root, match) : -1;
+    int start = entry;
+    if (entry >= 0) {
+        char run[ENGINE_FIELD_BYTES] = "";
+        int at_start = 1;
+        regex_literals(B, root, re, run, &at_start);
+        if (!re->anchored) { // Unanchored: a loop over every symbol may skip ahead of the match
+            int any = regex_ast(B, RX_SET, -1, -1);
+            int loop = any >= 0 ? regex_nfa(B, NFA_SPLIT, -1, entry, -1) : -1;
+            int skip = loop >= 0 ? regex_nfa(B, NFA_SET, any, loop, -1) : -1;
+            if (skip >= 0) {
+                memset(B->ast[any].set.bits, 0xff, sizeof(B->ast[any].set.bits));
+                B->nfa[loop].out1 = skip;
+            }
+            start = skip >= 0 ? loop : -1;
+        }
+    }
+    if (start < 0 || regex_determinize(B, start, match, re) != 0) {
+        if (B->error) *error = B->error;
+        else if (start >= 0) *error = "Error: Pattern too complex.";
+        engine_regex_free(re);
+        free(B);
+        return NULL;
+    }
+    free(B);
+    return re;
+}
+
+ENGINE_API int engine_regex_match(const EngineRegex *re, const char *field) {
+    const int *trans = re->trans;
+    int n = re->nclasses, s = re->start;
+    for (const unsigned char *p = (const unsigned char*)field; *p; p++) {
+        if (re->accept[s] == ENGINE_REGEX_ACCEPT) return 1;
+        if (s == re->dead) return 0;
+        s = trans[s * n + re->cls[*p]];
+    }
+    return re->accept[s] != 0;
+}
+
@@ -0,0 +1,354 @@
+// engine_search.c
+// Field search of the storage engine: the substring kernel the search front
+// ends scan fields with, and the compiler and evaluator of boolean field
+// queries. See engine.h for the query syntax.
+#include "engine.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define SEARCH_SIMD 1
+#endif
+
+// --- Substring Kernel ---
+// Tests a whole window of start positions at once: the query's first and last
+// bytes are broadcast and compared against the window and against the window
+// shifted by len-1, and only starts where both match are confirmed by comparing
+// the bytes between them (middle_equal). Starts at or past the field's
+// terminator are masked off, so stale bytes behind it never match. Loads stay
+// inside the ENGINE_FIELD_BYTES field; start positions a full window cannot
+// reach fall back to strstr. The widest kernel the CPU supports is picked once.
+static int field_contains_scalar(const char *field, const char *query, size_t query_len) {
+    (void)query_len;
+    return strstr(field, query) != NULL;
+}
+
+#ifdef SEARCH_SIMD
+// First and last bytes already matched; short queries beat a memcmp call here.
+static inline int middle_equal(const char *at, const char *query, size_t query_len) {
+    for (size_t k = 1; k + 1 < query_len; k++) if (at[k] != query[k]) return 0;
+    return 1;
+}
+
+// Tests windows of 16 starts from start on: 0, or where a wider kernel
+// stopped without meeting the terminator.
+static inline int field_contains_sse2_from(const char *field, const char *query, size_t query_len, size_t start) {
+    const __m128i first = _mm_set1_epi8(query[0]), last = _mm_set1_epi8(query[query_len - 1]);
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = start;
+    for (; i + 16 + query_len - 1 <= ENGINE_FIELD_BYTES; i += 16) {
+        __m128i head = _mm_loadu_si128((const __m128i*)(field + i));
+        __m128i tail = _mm_loadu_si128((const __m128i*)(field + i + query_len - 1));
+        uint32_t ends = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(head, zero));
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(head, first), _mm_cmpeq_epi8(tail, last)));
+        if (ends) mask &= (ends & (0u - ends)) - 1; // Starts before the terminator only
+        for (; mask; mask &= mask - 1)
+            if (middle_equal(field + i + __builtin_ctz(mask), query, query_len)) return 1;
+        if (ends) return 0;
+    }
+    return strstr(field + i, query) != NULL;
+}
+
+static int field_contains_sse2(const char *field, const char *query, size_t query_len) {
+    return field_contains_sse2_from(field, query, query_len, 0);
+}
+
+__attribute__((target("avx2")))
+static int field_contains_avx2(const char *field, const char *query, size_t query_len) {
+    const __m256i first = _mm256_set1_epi8(query[0]), last = _mm256_set1_epi8(query[query_len - 1]);
+    const __m256i zero = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 32 + query_len - 1 <= ENGINE_FIELD_BYTES; i += 32) {
+        __m256i head = _mm256_loadu_si256((const __m256i*)(field + i));
+        __m256i tail = _mm256_loadu_si256((const __m256i*)(field + i + query_len - 1));
+        uint32_t ends = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(head, zero));
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(head, first), _mm256_cmpeq_epi8(tail, last)));
+        if (ends) mask &= (ends & (0u - ends)) - 1;
+        for (; mask; mask &= mask - 1)
+            if (middle_equal(field + i + __builtin_ctz(mask), query, query_len)) return 1;
+        if (ends) return 0;
+    }
+    // Starts a 32-byte window can no longer reach (all of them once the query
+    // is longer than 19 bytes): SSE2 resumes at i, then strstr takes the rest.
+    return field_contains_sse2_from(field, query, query_len, i);
+}
+#endif
+
+ENGINE_API EngineFieldMatcher engine_field_matcher(size_t query_len) {
+    if (query_len == 0) return field_contains_scalar; // Empty query matches every field
+#ifdef SEARCH_SIMD
+    static EngineFieldMatcher s_simd_matcher = NULL;
+    if (!s_simd_matcher) {
+        __builtin_cpu_init();
+        s_simd_matcher = __builtin_cpu_supports("avx2") ? field_contains_avx2 : field_contains_sse2;
+    }
+    return s_simd_matcher;
+#else
+    return field_contains_scalar;
+#endif
+}
+
+// --- Query ---
+// The text is parsed once into a tree; the planner orders the operands of every
+// AND/OR by estimated cost so cheap clauses run first, and the tree is flattened
+// into a jump program that short-circuits. equals/prefix clauses at the top
+// level of the query are remembered as seeks, for callers with a sorted index.
+#define QUERY_MAX_NODES 256
+
+enum { QNODE_CLAUSE, QNODE_AND, QNODE_OR, QNODE_NOT };
+enum { QI_TEST, QI_JUMP_FALSE, QI_JUMP_TRUE, QI_NOT };
+
+typedef struct {
+    int kind, clause; // clause: index into clauses for QNODE_CLAUSE
+    int first, next;  // First child and next sibling, -1 terminated
+    int cost;
+} QueryNode;
+
+typedef struct {
+    const char *text;
+    size_t pos;
+    QueryNode nodes[QUERY_MAX_NODES];
+    int nnodes;
+    EngineQueryClause clauses[QUERY_MAX_NODES];
+    int nclauses;
+    const size_t *field_offs; // Per field number - 1
+    int fold;                 // Values are case-folded
+    char error[128];
+} QueryParser;
+
+static const char *const s_query_fields[] = { "name", "phone", "email" };
+static const char *const s_query_ops[] = { "contains", "prefix", "suffix", "equals" };
+static const int s_query_op_cost[] = { 8, 2, 4, 1 };
+
+static int query_fail(QueryParser *P, const char *what) {
+    if (!P->error[0]) snprintf(P->error, sizeof(P->error), "Error: %s at position %d.", what, (int)P->pos + 1);
+    return -1;
+}
+
+// Reads the next token into buf: "(", ")", a word, or a quoted string.
+// Returns 1 (0 past the end, -1 if it does not fit); *quoted marks strings.
+static int query_token(QueryParser *P, char *buf, size_t cap, int *quoted) {
+    const char *s = P->text;
+    while (s[P->pos] == ' ' || s[P->pos] == '\t') P->pos++;
+    *quoted = 0;
+    if (!s[P->pos]) return 0;
+    size_t n = 0;
+    if (s[P->pos] == '(' || s[P->pos] == ')') {
+        buf[n++] = s[P->pos++];
+    } else if (s[P->pos] == '"') {
+        *quoted = 1;
+        size_t end = P->pos + 1;
+        while (s[end] && s[end] != '"') end++;
+        if (!s[end]) return query_fail(P, "unterminated quote");
+        for (size_t i = P->pos + 1; i < end; i++) { if (n + 1 >= cap) return -1; buf[n++] = s[i]; }
+        P->pos = end + 1;
+    } else {
+        while (s[P->pos] && s[P->pos] != ' ' && s[P->pos] != '\t' && s[P->pos] != '(' && s[P->pos] != ')' && s[P->pos] != '"') {
+            if (n + 1 >= cap) return -1;
+            buf[n++] = s[P->pos++];
+        }
+    }
+    buf[n] = '\0';
+    return 1;
+}
+
+static int query_word_is(const char *tok, const char *word) {
+    for (; *tok && *word; tok++, word++)
+        if ((*tok >= 'A' && *tok <= 'Z' ? *tok - 'A' + 'a' : *tok) != *word) return 0;
+    return !*tok && !*word;
+}
+
+// Whether the next token is the given keyword; consumes it if so.
+static int query_accept(QueryParser *P, const char *word) {
+    size_t save = P->pos;
+    char tok[16]; int quoted;
+    if (query_token(P, tok, sizeof(tok), &quoted) == 1 && !quoted && query_word_is(tok, word)) return 1;
+    P->pos = save;
+    return 0;
+}
+
+static int query_node(QueryParser *P, int kind) {
+    if (P->nnodes == QUERY_MAX_NODES) return query_fail(P, "query too long");
+    QueryNode *n = &P->nodes[P->nnodes];
+    n->kind = kind; n->clause = -1; n->first = n->next = -1; n->cost = 0;
+    return P->nnodes++;
+}
+
+static int query_parse_expr(QueryParser *P);
+
+static int query_parse_clause(QueryParser *P) {
+    char tok[64]; int quoted, field = 0, op = -1;
+    if (query_token(P, tok, sizeof(tok), &quoted) != 1 || quoted) return query_fail(P, "expected a field name");
+    for (int f = 0; f < 3; f++) if (query_word_is(tok, s_query_fields[f])) field = f + 1;
+    if (!field) return query_fail(P, "unknown field (use name, phone or email)");
+    if (query_token(P, tok, sizeof(tok), &quoted) != 1 || quoted) return query_fail(P, "expected an operator");
+    for (int o = 0; o < 4; o++) if (query_word_is(tok, s_query_ops[o])) op = o;
+    if (op < 0) return query_fail(P, "unknown operator (use contains, prefix, suffix or equals)");
+
+    char value[ENGINE_FIELD_BYTES];
+    int r = query_token(P, value, sizeof(value), &quoted);
+    if (r < 0) return query_fail(P, "value too long (at most 49 characters)");
+    if (r == 0 || (!quoted && (value[0] == '(' || value[0] == ')'))) return query_fail(P, "expected a value");
+    if (P->nclauses == QUERY_MAX_NODES) return query_fail(P, "query too long");
+    EngineQueryClause *c = &P->clauses[P->nclauses];
+    memset(c, 0, sizeof(*c));
+    c->field = field; c->op = op;
+    c->field_off = P->field_offs[field - 1];
+    if (P->fold) engine_fold_key(c->value, value);
+    else memcpy(c->value, value, sizeof(c->value));
+    c->len = strlen(c->value);
+    c->contains = engine_field_matcher(c->len);
+
+    int n = query_node(P, QNODE_CLAUSE);
+    if (n < 0) return -1;
+    P->nodes[n].clause = P->nclauses++;
+    P->nodes[n].cost = s_query_op_cost[op];
+    return n;
+}
+
+static int query_parse_factor(QueryParser *P) {
+    if (query_accept(P, "not")) {
+        int child = query_parse_factor(P);
+        if (child < 0) return -1;
+        int n = query_node(P, QNODE_NOT);
+        if (n < 0) return -1;
+        P->nodes[n].first = child;
+        P->nodes[n].cost = P->nodes[child].cost;
+        return n;
+    }
+    if (query_accept(P, "(")) {
+        int inner = query_parse_expr(P);
+        if (inner < 0) return -1;
+        if (!query_accept(P, ")")) return query_fail(P, "expected ')'");
+        return inner;
+    }
+    return query_parse_clause(P);
+}
+
+// Parses operands separated by `keyword` into one AND/OR node, with the
+// operands sorted by cost (stable, so equal costs keep their written order).
+static int query_parse_list(QueryParser *P, int kind, const char *keyword) {
+    int first = kind == QNODE_OR ? query_parse_list(P, QNODE_AND, "and") : query_parse_factor(P);
+    if (first < 0 || !query_accept(P, keyword)) return first;
+    int n = query_node(P, kind);
+    if (n < 0) return -1;
+    QueryNode *list = &P->nodes[n];
+    list->first = first;
+    list->cost = P->nodes[first].cost;
+    do {
+        int child = kind == QNODE_OR ? query_parse_list(P, QNODE_AND, "and") : query_parse_factor(P);
+        if (child < 0) return -1;
+        list->cost += P->nodes[child].cost;
+        int *link = &list->first;
+        while (*link >= 0 && P->nodes[*link].cost <= P->nodes[child].cost) link = &P->nodes[*link].next;
+        P->nodes[child].next = *link;
+        *link = child;
+    } while (query_accept(P, keyword));
+    return n;
+}
+
+static int query_parse_expr(QueryParser *P) { return query_parse_list(P, QNODE_OR, "or"); }
+
+static void query_emit(const QueryParser *P, EngineQuery *q, int node) {
+    const QueryNode *n = &P->nodes[node];
+    if (n->kind == QNODE_CLAUSE) {
+        q->code[q->ncode++] = (EngineQueryInsn){ QI_TEST, n->clause };
+    } else if (n->kind == QNODE_NOT) {
+        query_emit(P, q, n->first);
+        q->code[q->ncode++] = (EngineQueryInsn){ QI_NOT, 0 };
+    } else {
+        // Each operand but the last is followed by a short-circuit jump to the
+        // end; the pending jumps are chained through arg and patched at the end.
+        int chain = -1;
+        for (int c = n->first; c >= 0; c = P->nodes[c].next) {
+            query_emit(P, q, c);
+            if (P->nodes[c].next < 0) break;
+            q->code[q->ncode] = (EngineQueryInsn){ n->kind == QNODE_AND ? QI_JUMP_FALSE : QI_JUMP_TRUE, chain };
+            chain = q->ncode++;
+        }
+        while (chain >= 0) { int prev = q->code[chain].arg; q->code[chain].arg = q->ncode; chain = prev; }
+    }
+}
+
+static int query_eval_clause(const EngineQueryClause *c, const void *record) {
+    const char *field = (const char*)record + c->field_off;
+    switch (c->op) {
+    case ENGINE_QUERY_CONTAINS: return c->contains(field, c->value, c->len);
+    case ENGINE_QUERY_PREFIX:   return strncmp(field, c->value, c->len) == 0;
+    case ENGINE_QUERY_SUFFIX: {
+        size_t n = strlen(field);
+        return n >= c->len && memcmp(field + n - c->len, c->value, c->len) == 0;
+    }
+    default:                return strcmp(field, c->value) == 0;
+    }
+}
+
+ENGINE_API int engine_query_match(const EngineQuery *q, const void *record) {
+    int acc = 1, pc = 0;
+    while (pc < q->ncode) {
+        const EngineQueryInsn *in = &q->code[pc];
+        switch (in->code) {
+        case QI_TEST:       acc = query_eval_clause(&q->clauses[in->arg], record); pc++; break;
+        case QI_JUMP_FALSE: pc = acc ? pc + 1 : in->arg; break;
+        case QI_JUMP_TRUE:  pc = acc ? in->arg : pc + 1; break;
+        default:               acc = !acc; pc++; break;
+        }
+    }
+    return acc;
+}
+
+ENGINE_API EngineQuery *engine_query_compile(const char *text, const size_t field_offs[3], int fold, char *error, size_t error_size) {
+    if (error && error_size) error[0] = '\0';
+    QueryParser *P = (QueryParser*)calloc(1, sizeof(QueryParser));
+    if (!P) {
+        if (error && error_size) snprintf(error, error_size, "Error: Memory allocation failed.");
+        return NULL;
+    }
+    P->text = text ? text : "";
+    P->field_offs = field_offs;
+    P->fold = fold;
+    int root = query_parse_expr(P);
+    char tail[2]; int quoted;
+    if (root >= 0 && query_token(P, tail, sizeof(tail), &quoted) != 0) root = query_fail(P, "unexpected text");
+    if (root < 0) {
+        if (error && error_size) snprintf(error, error_size, "%s", P->error[0] ? P->error : "Error: Invalid query.");
+        free(P);
+        return NULL;
+    }
+
+    EngineQuery *q = (EngineQuery*)calloc(1, sizeof(EngineQuery));
+    if (q) {
+        q->clauses = (EngineQueryClause*)malloc(P->nclauses * sizeof(EngineQueryClause));
+        q->code = (EngineQueryInsn*)malloc(2 * P->nnodes * sizeof(EngineQueryInsn)); // At most one jump or NOT per node
+        q->seeks = (int*)malloc(P->nclauses * sizeof(int));
+    }
+    if (!q || !q->clauses || !q->code || !q->seeks) {
+        if (error && error_size) snprintf(error, error_size, "Error: Memory allocation failed.");
+        engine_query_free(q);
+        free(P);
+        return NULL;
+    }
+    memcpy(q->clauses, P->clauses, P->nclauses * sizeof(EngineQueryClause));
+    q->nclauses = P->nclauses;
+    query_emit(P, q, root);
+
+    // Seeks: top-level equals/prefix clauses, i.e. ones every match must satisfy.
+    const QueryNode *r = &P->nodes[root];
+    for (int c = r->kind == QNODE_AND ? r->first : root; c >= 0; c = r->kind == QNODE_AND ? P->nodes[c].next : -1) {
+        const QueryNode *n = &P->nodes[c];
+        if (n->kind == QNODE_CLAUSE && (q->clauses[n->clause].op == ENGINE_QUERY_EQUALS || q->clauses[n->clause].op == ENGINE_QUERY_PREFIX))
+            q->seeks[q->nseeks++] = n->clause;
+    }
+    free(P);
+    return q;
+}
+
+ENGINE_API void engine_query_free(EngineQuery *q) {
+    if (!q) return;
+    free(q->clauses);
+    free(q->code);
+    free(q->seeks);
+    free(q);
+}
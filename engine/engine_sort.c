@@ -0,0 +1,542 @@
+// engine_sort.c
+// String sorts shared by every front end: the stable MSD radix sort on cached
+// key prefixes, the work-stealing pool that runs it on several threads, the
+// LSD radix path for phones, the list sort built on them, the introselect
+// behind sorted pages, and a plain fork/join for other parallel work. See
+// engine.h.
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L // sysconf
+#endif
+#include "engine.h"
+
+#include <stdlib.h>
+#include <string.h>
+#ifndef _WIN32
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+// --- MSD Radix Sort ---
+// Each key caches its string's first 8 bytes big-endian, so the sort buckets on
+// those bytes without touching the strings; only keys whose whole prefix ties
+// compare the rest with strcmp.
+#define STR_SORT_CUTOFF 16
+
+// Full comparison: the prefix decides unless it ties and both strings run past it.
+static int str_key_cmp(const EngineKey *a, const EngineKey *b, const char *const *strs) {
+    if (a->key != b->key) return a->key < b->key ? -1 : 1;
+    if ((a->key & 0xFF) == 0) return 0; // Both strings ended inside the prefix
+    return strcmp(strs[a->idx] + 8, strs[b->idx] + 8);
+}
+
+// Stable sort of a small bucket or a run of tied prefixes: insertion sort below
+// the cutoff, otherwise top-down merge sort.
+static void str_merge_sort(EngineKey *a, EngineKey *tmp, int n, const char *const *strs) {
+    if (n <= STR_SORT_CUTOFF) {
+        for (int i = 1; i < n; i++) {
+            EngineKey k = a[i];
+            int j = i;
+            while (j > 0 && str_key_cmp(&a[j - 1], &k, strs) > 0) { a[j] = a[j - 1]; j--; }
+            a[j] = k;
+        }
+        return;
+    }
+    int mid = n / 2;
+    str_merge_sort(a, tmp, mid, strs);
+    str_merge_sort(a + mid, tmp, n - mid, strs);
+    if (str_key_cmp(&a[mid - 1], &a[mid], strs) <= 0) return; // Already ordered
+    int i = 0, j = mid, k = 0;
+    while (i < mid && j < n) tmp[k++] = str_key_cmp(&a[j], &a[i], strs) < 0 ? a[j++] : a[i++];
+    while (i < mid) tmp[k++] = a[i++];
+    while (j < n) tmp[k++] = a[j++];
+    memcpy(a, tmp, (size_t)n * sizeof(EngineKey));
+}
+
+// Stable MSD radix sort on prefix byte 'depth' (0 = most significant). Bucket 0
+// holds strings that already ended, so it needs no further work.
+static void str_msd_sort(EngineKey *a, EngineKey *tmp, int n, int depth, const char *const *strs) {
+    if (n <= STR_SORT_CUTOFF || depth == 8) { str_merge_sort(a, tmp, n, strs); return; }
+    int shift = 56 - 8 * depth;
+    int counts[257] = { 0 };
+    for (int i = 0; i < n; i++) counts[((a[i].key >> shift) & 0xFF) + 1]++;
+    if (counts[((a[0].key >> shift) & 0xFF) + 1] == n) { // Byte is constant, go deeper
+        if (((a[0].key >> shift) & 0xFF) != 0) str_msd_sort(a, tmp, n, depth + 1, strs);
+        return;
+    }
+    for (int b = 1; b <= 256; b++) counts[b] += counts[b - 1];
+    int starts[256];
+    memcpy(starts, counts, sizeof(starts));
+    for (int i = 0; i < n; i++) tmp[starts[(a[i].key >> shift) & 0xFF]++] = a[i];
+    memcpy(a, tmp, (size_t)n * sizeof(EngineKey));
+    for (int b = 1; b < 256; b++) {
+        int len = counts[b + 1] - counts[b];
+        if (len > 1) str_msd_sort(a + counts[b], tmp, len, depth + 1, strs);
+    }
+}
+
+// --- Introselect ---
+// Sorted pages only need the keys of one page in order: introselect puts the
+// page's two boundaries in place, then introsort orders the page. Ties on the
+// full string go by position, so the page matches the stable sort.
+#define INTRO_CUTOFF 16
+
+static int page_key_cmp(const EngineKey *a, const EngineKey *b, const char *const *strs) {
+    int c = str_key_cmp(a, b, strs);
+    return c != 0 ? c : (a->idx > b->idx) - (a->idx < b->idx);
+}
+
+static void key_swap(EngineKey *a, EngineKey *b) { EngineKey t = *a; *a = *b; *b = t; }
+
+static void page_heapsort(EngineKey *a, int n, const char *const *strs) {
+    for (int start = n / 2 - 1, end = n; end > 1; ) {
+        int root;
+        if (start >= 0) root = start--;
+        else { key_swap(&a[0], &a[--end]); root = 0; }
+        for (int child; (child = 2 * root + 1) < end; root = child) {
+            if (child + 1 < end && page_key_cmp(&a[child], &a[child + 1], strs) < 0) child++;
+            if (page_key_cmp(&a[root], &a[child], strs) >= 0) break;
+            key_swap(&a[root], &a[child]);
+        }
+    }
+}
+
+// Median of three, then Hoare partition. Returns the size of the left part;
+// every key in a[0..left) sorts before every key in a[left..n).
+static int page_partition(EngineKey *a, int n, const char *const *strs) {
+    int mid = (n - 1) / 2;
+    if (page_key_cmp(&a[mid], &a[0], strs) < 0) key_swap(&a[mid], &a[0]);
+    if (page_key_cmp(&a[n - 1], &a[0], strs) < 0) key_swap(&a[n - 1], &a[0]);
+    if (page_key_cmp(&a[n - 1], &a[mid], strs) < 0) key_swap(&a[n - 1], &a[mid]);
+    EngineKey pivot = a[mid];
+    int i = -1, j = n;
+    for (;;) {
+        do i++; while (page_key_cmp(&a[i], &pivot, strs) < 0);
+        do j--; while (page_key_cmp(&a[j], &pivot, strs) > 0);
+        if (i >= j) return j + 1;
+        key_swap(&a[i], &a[j]);
+    }
+}
+
+// Introselect when k >= 0 (a[k] ends up where a full sort would put it, smaller
+// keys before it), introsort of the whole range when k < 0.
+static void page_order(EngineKey *a, int n, int k, int depth_limit, const char *const *strs) {
+    while (n > INTRO_CUTOFF) {
+        if (depth_limit-- == 0) { page_heapsort(a, n, strs); return; }
+        int left = page_partition(a, n, strs);
+        if (k < 0) { // Sorting: recurse into the smaller side, loop on the larger
+            if (left < n - left) { page_order(a, left, -1, depth_limit, strs); a += left; n -= left; }
+            else { page_order(a + left, n - left, -1, depth_limit, strs); n = left; }
+        } else if (k < left) {
+            n = left;
+        } else {
+            a += left; n -= left; k -= left;
+        }
+    }
+    for (int i = 1; i < n; i++) {
+        EngineKey t = a[i];
+        int j = i;
+        while (j > 0 && page_key_cmp(&a[j - 1], &t, strs) > 0) { a[j] = a[j - 1]; j--; }
+        a[j] = t;
+    }
+}
+
+static int depth_limit(int n) {
+    int limit = 0;
+    for (int m = n; m > 1; m >>= 1) limit += 2;
+    return limit;
+}
+
+ENGINE_API void engine_sort_page(EngineKey *keys, const char *const *strs, int n, int offset, int limit) {
+    for (int i = 0; i < n; i++) {
+        keys[i].key = engine_key_prefix(strs[i]);
+        keys[i].idx = i;
+    }
+    int end = offset + limit;
+    if (end < n) page_order(keys, n, end, depth_limit(n), strs);              // First `end` keys to the front
+    if (offset > 0) page_order(keys, end, offset, depth_limit(end), strs);    // Page keys to [offset, end)
+    page_order(keys + offset, limit, -1, depth_limit(limit), strs);
+}
+
+#ifndef _WIN32
+// --- Work-Stealing Sort Pool ---
+// The keys are cut into CHUNKS_PER_THREAD chunks per worker. Phase 0 MSD sorts
+// every chunk; each later phase merges pairs of sorted runs, with the output of
+// every pair cut at the same chunk boundaries (merge path co-ranking), so every
+// phase is a set of equal-sized tasks. Each worker owns a contiguous range of
+// task ids, pops from its front and, once empty, steals from the back of the
+// others. Chunk sorts and merges are both stable, so the result is the same
+// for any thread count or schedule.
+#define POOL_CHUNKS_PER_THREAD 4
+#define POOL_MIN_CHUNK         4096
+
+typedef struct {
+    uint64_t range; // Owner pops lo (high 32 bits), thieves take hi - 1 (low 32 bits)
+    char pad[56];   // One deque per cache line
+} TaskDeque;
+
+typedef struct {
+    EngineKey *src, *dst;
+    const char *const *strs;
+    int n, chunks, threads, run_chunks; // run_chunks: width of a sorted run in the current phase
+    TaskDeque deques[ENGINE_SORT_MAX_THREADS];
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    int live, waiting, generation, started;
+} SortPool;
+
+typedef struct {
+    SortPool *pool;
+    int self;
+} SortWorker;
+
+static int chunk_bound(const SortPool *pool, int c) {
+    return (int)((long long)pool->n * c / pool->chunks);
+}
+
+static int deque_pop(TaskDeque *d) {
+    uint64_t r = __atomic_load_n(&d->range, __ATOMIC_ACQUIRE);
+    for (;;) {
+        uint32_t lo = (uint32_t)(r >> 32), hi = (uint32_t)r;
+        if (lo >= hi) return -1;
+        uint64_t next = ((uint64_t)(lo + 1) << 32) | hi;
+        if (__atomic_compare_exchange_n(&d->range, &r, next, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) return (int)lo;
+    }
+}
+
+static int deque_steal(TaskDeque *d) {
+    uint64_t r = __atomic_load_n(&d->range, __ATOMIC_ACQUIRE);
+    for (;;) {
+        uint32_t lo = (uint32_t)(r >> 32), hi = (uint32_t)r;
+        if (lo >= hi) return -1;
+        uint64_t next = ((uint64_t)lo << 32) | (hi - 1);
+        if (__atomic_compare_exchange_n(&d->range, &r, next, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) return (int)(hi - 1);
+    }
+}
+
+// Hands worker t the task ids [t*chunks/threads, (t+1)*chunks/threads).
+static void pool_fill_deques(SortPool *pool) {
+    for (int t = 0; t < pool->threads; t++) {
+        uint64_t lo = (uint64_t)((long long)pool->chunks * t / pool->threads);
+        uint64_t hi = (uint64_t)((long long)pool->chunks * (t + 1) / pool->threads);
+        __atomic_store_n(&pool->deques[t].range, (lo << 32) | hi, __ATOMIC_RELEASE);
+    }
+}
+
+// Number of a's elements among the first k outputs of a stable merge of a and b.
+static int merge_corank(const EngineKey *a, int na, const EngineKey *b, int nb, int k, const char *const *strs) {
+    int lo = k > nb ? k - nb : 0, hi = k < na ? k : na;
+    while (lo < hi) {
+        int i = lo + (hi - lo) / 2, j = k - i;
+        if (j == 0 || i == na || str_key_cmp(&b[j - 1], &a[i], strs) < 0) hi = i;
+        else lo = i + 1;
+    }
+    return lo;
+}
+
+static void pool_run_task(SortPool *pool, int c) {
+    int start = chunk_bound(pool, c), end = chunk_bound(pool, c + 1);
+    if (pool->run_chunks == 0) { // dst is free scratch during the first phase
+        str_msd_sort(pool->src + start, pool->dst + start, end - start, 0, pool->strs);
+        return;
+    }
+
+    int pair_first = c - c % (2 * pool->run_chunks);
+    int mid_chunk = pair_first + pool->run_chunks, last_chunk = pair_first + 2 * pool->run_chunks;
+    if (mid_chunk > pool->chunks) mid_chunk = pool->chunks;
+    if (last_chunk > pool->chunks) last_chunk = pool->chunks;
+    int pair_start = chunk_bound(pool, pair_first), pair_mid = chunk_bound(pool, mid_chunk);
+    const EngineKey *a = pool->src + pair_start, *b = pool->src + pair_mid;
+    int na = pair_mid - pair_start, nb = chunk_bound(pool, last_chunk) - pair_mid;
+
+    int k0 = start - pair_start, k1 = end - pair_start;
+    int i0 = merge_corank(a, na, b, nb, k0, pool->strs);
+    int i1 = merge_corank(a, na, b, nb, k1, pool->strs);
+    int j = k0 - i0, j1 = k1 - i1, i = i0, out = start;
+    while (i < i1 && j < j1) pool->dst[out++] = str_key_cmp(&b[j], &a[i], pool->strs) < 0 ? b[j++] : a[i++];
+    while (i < i1) pool->dst[out++] = a[i++];
+    while (j < j1) pool->dst[out++] = b[j++];
+}
+
+// Blocks until every live worker arrives. The last one advances the pool to the
+// next phase; returns 0 once all phases are done.
+static int pool_barrier(SortPool *pool) {
+    pthread_mutex_lock(&pool->lock);
+    int generation = pool->generation;
+    if (++pool->waiting == pool->live) {
+        if (pool->run_chunks > 0) { EngineKey *swap = pool->src; pool->src = pool->dst; pool->dst = swap; }
+        pool->run_chunks = pool->run_chunks == 0 ? 1 : pool->run_chunks * 2;
+        if (pool->run_chunks < pool->chunks) pool_fill_deques(pool);
+        pool->waiting = 0;
+        pool->generation++;
+        pthread_cond_broadcast(&pool->cond);
+    } else {
+        while (generation == pool->generation) pthread_cond_wait(&pool->cond, &pool->lock);
+    }
+    int more = pool->run_chunks < pool->chunks;
+    pthread_mutex_unlock(&pool->lock);
+    return more;
+}
+
+static void *sort_worker_run(void *arg) {
+    SortWorker *w = (SortWorker*)arg;
+    SortPool *pool = w->pool;
+
+    pthread_mutex_lock(&pool->lock);
+    while (!pool->started) pthread_cond_wait(&pool->cond, &pool->lock);
+    pthread_mutex_unlock(&pool->lock);
+
+    do {
+        int task;
+        while ((task = deque_pop(&pool->deques[w->self])) >= 0) pool_run_task(pool, task);
+        for (int v = 1; v < pool->threads; v++) { // Scan the others, starting with the next worker
+            TaskDeque *victim = &pool->deques[(w->self + v) % pool->threads];
+            while ((task = deque_steal(victim)) >= 0) pool_run_task(pool, task);
+        }
+    } while (pool_barrier(pool));
+    return NULL;
+}
+
+// Sorts keys with `threads` workers (the caller is worker 0). Returns the buffer
+// that holds the result (keys or tmp).
+static EngineKey *sort_parallel(EngineKey *keys, EngineKey *tmp, int n, int threads, const char *const *strs) {
+    SortPool pool = { .src = keys, .dst = tmp, .strs = strs, .n = n,
+                      .chunks = threads * POOL_CHUNKS_PER_THREAD, .threads = threads };
+    pthread_t tids[ENGINE_SORT_MAX_THREADS];
+    SortWorker workers[ENGINE_SORT_MAX_THREADS];
+    pthread_mutex_init(&pool.lock, NULL);
+    pthread_cond_init(&pool.cond, NULL);
+    pool_fill_deques(&pool);
+
+    // A worker that fails to start just leaves its range to be stolen.
+    int live = 1;
+    for (int t = 1; t < threads; t++) {
+        workers[t] = (SortWorker){ &pool, t };
+        if (pthread_create(&tids[live - 1], NULL, sort_worker_run, &workers[t]) == 0) live++;
+    }
+    pthread_mutex_lock(&pool.lock);
+    pool.live = live;
+    pool.started = 1;
+    pthread_cond_broadcast(&pool.cond);
+    pthread_mutex_unlock(&pool.lock);
+
+    workers[0] = (SortWorker){ &pool, 0 };
+    sort_worker_run(&workers[0]);
+    for (int t = 0; t < live - 1; t++) pthread_join(tids[t], NULL);
+
+    pthread_mutex_destroy(&pool.lock);
+    pthread_cond_destroy(&pool.cond);
+    return pool.src;
+}
+#endif
+
+ENGINE_API int engine_sort_threads(int n, int threshold, int threads) {
+    return engine_thread_count(n, threshold, threads, POOL_MIN_CHUNK);
+}
+
+// --- Fork/Join ---
+// For work that splits into independent shares up front (the v2 lib's
+// parallel search); the sort uses the pool above. The helper threads start on
+// first use and then sleep on a condition variable between calls, so a call
+// costs a wakeup per helper rather than a pthread_create/join per share. The
+// shares are handed out by index, the caller taking share 0 and then any left
+// unclaimed, so the call finishes even with no helper running. One call uses
+// the helpers at a time; a call made while they are busy (from another thread,
+// or from inside run) runs its shares on the caller.
+ENGINE_API int engine_thread_count(int n, int threshold, int threads, int min_share) {
+#ifdef _WIN32
+    (void)n; (void)threshold; (void)threads; (void)min_share;
+    return 1; // No threads on Windows
+#else
+    if (n < threshold) return 1;
+    if (threads <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cpus > 0 ? (int)cpus : 1;
+    }
+    if (threads > ENGINE_SORT_MAX_THREADS) threads = ENGINE_SORT_MAX_THREADS;
+    while (threads > 1 && n / threads < min_share) threads--;
+    return threads;
+#endif
+}
+
+#ifndef _WIN32
+typedef struct {
+    pthread_mutex_t lock; // Guards every field
+    pthread_cond_t work;  // Shares to claim
+    pthread_cond_t done;  // The last share of the call finished
+    void *(*run)(void *);
+    char *args;
+    size_t arg_size;
+    int count, next, pending; // Shares in the call, next to claim, not yet finished
+    int helpers, busy;
+} ForkCrew;
+
+static ForkCrew s_crew = { .lock = PTHREAD_MUTEX_INITIALIZER, .work = PTHREAD_COND_INITIALIZER,
+                           .done = PTHREAD_COND_INITIALIZER };
+
+// Runs claimed share t with the lock dropped; returns with it held again.
+static void crew_run_share(int t) {
+    void *(*run)(void *) = s_crew.run;
+    void *arg = s_crew.args + (size_t)t * s_crew.arg_size;
+    pthread_mutex_unlock(&s_crew.lock);
+    run(arg);
+    pthread_mutex_lock(&s_crew.lock);
+    if (--s_crew.pending == 0) pthread_cond_signal(&s_crew.done);
+}
+
+static void *crew_helper_run(void *unused) {
+    (void)unused;
+    pthread_mutex_lock(&s_crew.lock);
+    for (;;) {
+        while (s_crew.next >= s_crew.count) pthread_cond_wait(&s_crew.work, &s_crew.lock);
+        crew_run_share(s_crew.next++);
+    }
+    return NULL;
+}
+#endif
+
+ENGINE_API void engine_run_parallel(void *(*run)(void *), void *args, size_t arg_size, int count) {
+    char *arg = (char*)args;
+#ifndef _WIN32
+    if (count > ENGINE_SORT_MAX_THREADS) count = ENGINE_SORT_MAX_THREADS;
+    if (count > 1) {
+        pthread_mutex_lock(&s_crew.lock);
+        if (!s_crew.busy) {
+            s_crew.busy = 1;
+            while (s_crew.helpers < count - 1) { // A helper that fails to start leaves its share to the caller
+                pthread_t tid;
+                if (pthread_create(&tid, NULL, crew_helper_run, NULL) != 0) break;
+                pthread_detach(tid);
+                s_crew.helpers++;
+            }
+            s_crew.run = run;
+            s_crew.args = arg;
+            s_crew.arg_size = arg_size;
+            s_crew.count = count;
+            s_crew.next = 1;
+            s_crew.pending = count;
+            pthread_cond_broadcast(&s_crew.work);
+            crew_run_share(0);
+            while (s_crew.next < count) crew_run_share(s_crew.next++);
+            while (s_crew.pending > 0) pthread_cond_wait(&s_crew.done, &s_crew.lock);
+            s_crew.count = s_crew.next = 0;
+            s_crew.busy = 0;
+            pthread_mutex_unlock(&s_crew.lock);
+            return;
+        }
+        pthread_mutex_unlock(&s_crew.lock);
+    }
+#endif
+    for (int t = 0; t < count; t++) run(arg + t * arg_size);
+}
+
+// --- Phone Sort ---
+// Valid phones are exactly 10 digits, so each packs into a 34-bit integer whose
+// numeric order matches strcmp order, and three stable 12-bit LSD passes
+// replace the string sort. Strings that don't pack (a CSV header loaded as a
+// record) are insertion-sorted on the side and merged back.
+#define PHONE_MAX_OUTLIERS 64
+
+// Returns whichever of keys and tmp holds the order, or NULL (keys and tmp
+// clobbered) if more than PHONE_MAX_OUTLIERS strings don't pack.
+static EngineKey *sort_phones(EngineKey *keys, EngineKey *tmp, const char *const *strs, int n) {
+    int outliers[PHONE_MAX_OUTLIERS];
+    int packed = 0, n_out = 0;
+    for (int i = 0; i < n; i++) {
+        if (engine_pack_phone(strs[i], &keys[packed].key)) {
+            keys[packed++].idx = i;
+        } else if (n_out < PHONE_MAX_OUTLIERS) {
+            int j = n_out++; // Stable insertion sort by strcmp
+            while (j > 0 && strcmp(strs[outliers[j - 1]], strs[i]) > 0) { outliers[j] = outliers[j - 1]; j--; }
+            outliers[j] = i;
+        } else {
+            return NULL;
+        }
+    }
+
+    EngineKey *order = engine_radix_sort_keys(keys, tmp, packed, ENGINE_PHONE_KEY_BITS);
+    if (n_out == 0) return order;
+    EngineKey *out = order == keys ? tmp : keys;
+    int a = 0, b = 0;
+    for (int k = 0; k < n; k++) {
+        if (b == n_out || (a < packed && strcmp(strs[order[a].idx], strs[outliers[b]]) <= 0)) out[k] = order[a++];
+        else out[k].idx = outliers[b++];
+    }
+    return out;
+}
+
+ENGINE_API EngineKey *engine_sort_strings(EngineKey *keys, EngineKey *tmp, const char *const *strs, int n, int threads) {
+    EngineKey *phones = sort_phones(keys, tmp, strs, n);
+    if (phones) return phones;
+
+    for (int i = 0; i < n; i++) {
+        keys[i].key = engine_key_prefix(strs[i]);
+        keys[i].idx = i;
+    }
+#ifndef _WIN32
+    if (threads > 1) return sort_parallel(keys, tmp, n, threads, strs);
+#else
+    (void)threads;
+#endif
+    str_msd_sort(keys, tmp, n, 0, strs);
+    return keys;
+}
+
+// --- List Sort ---
+#define LIST_NEXT(node, next_off) (*(void**)((char*)(node) + (next_off)))
+#define LIST_FIELD(node, field_off) ((const char*)(node) + (field_off))
+
+// Stable bottom-up merge sort that only relinks nodes: runs of 1, 2, 4, ...
+// are merged pairwise until one pass merges everything. Used when the key
+// arrays can't be allocated.
+static void *list_merge_sort(void *head, size_t next_off, size_t field_off) {
+    for (int width = 1; ; width *= 2) {
+        void *p = head, *tail = NULL;
+        int merges = 0;
+        head = NULL;
+        while (p) {
+            merges++;
+            void *q = p;
+            int pn = 0, qn = width;
+            while (pn < width && q) { pn++; q = LIST_NEXT(q, next_off); }
+            while (pn > 0 || (qn > 0 && q)) {
+                void *e;
+                if (pn == 0) { e = q; q = LIST_NEXT(q, next_off); qn--; }
+                else if (qn == 0 || !q || strcmp(LIST_FIELD(p, field_off), LIST_FIELD(q, field_off)) <= 0) {
+                    e = p; p = LIST_NEXT(p, next_off); pn--;
+                } else { e = q; q = LIST_NEXT(q, next_off); qn--; }
+                if (tail) LIST_NEXT(tail, next_off) = e;
+                else head = e;
+                tail = e;
+            }
+            p = q;
+        }
+        LIST_NEXT(tail, next_off) = NULL;
+        if (merges <= 1) return head;
+    }
+}
+
+ENGINE_API void *engine_sort_list(void *head, int count, size_t next_off, size_t field_off, int threads) {
+    if (!head || count < 2) return head;
+    const char **strs = (const char**)malloc((size_t)count * sizeof(const char*));
+    EngineKey *keys = (EngineKey*)malloc((size_t)count * sizeof(EngineKey));
+    EngineKey *tmp = (EngineKey*)malloc((size_t)count * sizeof(EngineKey));
+    if (!strs || !keys || !tmp) {
+        free(strs); free(keys); free(tmp);
+        return list_merge_sort(head, next_off, field_off);
+    }
+
+    int n = 0;
+    for (void *p = head; p && n < count; p = LIST_NEXT(p, next_off)) strs[n++] = LIST_FIELD(p, field_off);
+    EngineKey *order = engine_sort_strings(keys, tmp, strs, n, threads);
+    head = (char*)strs[order[0].idx] - field_off;
+    void *tail = head;
+    for (int i = 1; i < n; i++) {
+        void *node = (char*)strs[order[i].idx] - field_off;
+        LIST_NEXT(tail, next_off) = node;
+        tail = node;
+    }
+    LIST_NEXT(tail, next_off) = NULL;
+
+    free(strs); free(keys); free(tmp);
+    return head;
+}
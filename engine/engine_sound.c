@@ -0,0 +1,111 @@
+// engine_sound.c
+// Phonetic index of the storage engine: American Soundex codes of the first
+// name words, and a multimap from code to the records carrying it. A code packs
+// into 14 bits, so the map is a table indexed by the code directly, with no
+// hashing. Every entry stores its slot in each of its buckets, so a removal is
+// an O(1) swap with the bucket's last entry. See engine.h.
+#include "engine.h"
+
+#include <stdlib.h>
+
+// Soundex digit per letter; 0 for vowels and y, which separate equal digits,
+// and -1 for h and w, which do not.
+static int soundex_digit(char c) {
+    static const signed char digits[26] = { 0, 1, 2, 3, 0, 1, 2, -1, 0, 2, 2, 4, 5, 5, 0, 1, 2, 6, 2, 3, 0, 1, -1, 2, 0, 2 };
+    return digits[c - 'a'];
+}
+
+// Packed Soundex code of the next word of *s, advancing past it, or 0 at the end.
+static uint16_t soundex_next(const char **s) {
+    const char *p = *s;
+    while (*p && !((*p >= 'a' && *p <= 'z') || (*p >= 'A' && *p <= 'Z'))) p++;
+    if (!*p) { *s = p; return 0; }
+    char first = *p >= 'A' && *p <= 'Z' ? *p - 'A' + 'a' : *p;
+    static const int weights[3] = { 49, 7, 1 };
+    int code = (first - 'a') * 343, digits = 0, prev = soundex_digit(first);
+    for (p++; *p && *p != ' '; p++) {
+        char c = *p >= 'A' && *p <= 'Z' ? *p - 'A' + 'a' : *p;
+        if (c < 'a' || c > 'z') continue;
+        int d = soundex_digit(c);
+        if (d < 0) continue; // h and w keep the previous digit
+        if (d > 0 && d != prev && digits < 3) code += d * weights[digits++];
+        prev = d;
+    }
+    *s = p;
+    return (uint16_t)(code + 1);
+}
+
+ENGINE_API void engine_sound_codes(const char *name, uint16_t codes[ENGINE_SOUND_WORDS]) {
+    for (int j = 0; j < ENGINE_SOUND_WORDS; j++) codes[j] = soundex_next(&name);
+}
+
+ENGINE_API void engine_sound_insert(EngineSound *ix, EngineSoundEntry *e, const char *name) {
+    engine_sound_codes(name, e->codes);
+    for (int j = 0; j < ENGINE_SOUND_WORDS; j++) {
+        e->pos[j] = -1;
+        uint16_t code = e->codes[j];
+        int repeated = 0;
+        for (int i = 0; i < j; i++) repeated |= e->codes[i] == code;
+        if (!code || repeated) continue;
+        EngineSoundBucket *b = &ix->buckets[code];
+        if (b->count == b->cap) {
+            int cap = b->cap ? 2 * b->cap : 4;
+            EngineSoundEntry **grown = (EngineSoundEntry**)realloc(b->entries, cap * sizeof(EngineSoundEntry*));
+            if (!grown) { ix->stale = 1; continue; }
+            b->entries = grown;
+            b->cap = cap;
+        }
+        e->pos[j] = b->count;
+        b->entries[b->count++] = e;
+    }
+}
+
+ENGINE_API void engine_sound_erase(EngineSound *ix, EngineSoundEntry *e) {
+    for (int j = 0; j < ENGINE_SOUND_WORDS; j++) {
+        if (e->pos[j] < 0) continue;
+        uint16_t code = e->codes[j];
+        EngineSoundBucket *b = &ix->buckets[code];
+        EngineSoundEntry *moved = b->entries[--b->count];
+        b->entries[e->pos[j]] = moved;
+        for (int k = 0; k < ENGINE_SOUND_WORDS; k++)
+            if (moved->codes[k] == code && moved->pos[k] >= 0) moved->pos[k] = e->pos[j];
+        e->pos[j] = -1;
+    }
+}
+
+ENGINE_API void engine_sound_free(EngineSound *ix) {
+    for (int c = 0; c < ENGINE_SOUND_CODES; c++) {
+        free(ix->buckets[c].entries);
+        ix->buckets[c].entries = NULL;
+        ix->buckets[c].count = ix->buckets[c].cap = 0;
+    }
+    ix->stale = 0;
+}
+
+// Only the smallest bucket among the query's codes is walked.
+ENGINE_API EngineSoundEntry **engine_sound_find(const EngineSound *ix, const char *query, int *count) {
+    *count = 0;
+    uint16_t codes[ENGINE_SOUND_WORDS];
+    engine_sound_codes(query, codes);
+    if (!codes[0]) return NULL;
+    const EngineSoundBucket *b = &ix->buckets[codes[0]];
+    for (int j = 1; j < ENGINE_SOUND_WORDS; j++)
+        if (codes[j] && ix->buckets[codes[j]].count < b->count) b = &ix->buckets[codes[j]];
+    if (b->count == 0) return NULL;
+    EngineSoundEntry **hits = (EngineSoundEntry**)malloc(b->count * sizeof(EngineSoundEntry*));
+    if (!hits) { *count = -1; return NULL; }
+    int found = 0;
+    for (int i = 0; i < b->count; i++) {
+        const EngineSoundEntry *e = b->entries[i];
+        int all = 1;
+        for (int j = 0; j < ENGINE_SOUND_WORDS && all; j++) {
+            int has = !codes[j];
+            for (int k = 0; k < ENGINE_SOUND_WORDS && !has; k++) has = e->codes[k] == codes[j];
+            all = has;
+        }
+        if (all) hits[found++] = b->entries[i];
+    }
+    if (found == 0) { free(hits); return NULL; }
+    *count = found;
+    return hits;
+}
@@ -0,0 +1,269 @@
+// engine_store.c
+// Backend-independent store algorithms (load, save, sort, dedupe) and the
+// headless subcommands built on them. Everything here reaches the records
+// through the EngineBackend operations only.
+#include "engine.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+ENGINE_API int engine_store_open(EngineStore *st, const EngineBackend *backend) {
+    st->backend = backend;
+    st->impl = backend->open();
+    return st->impl ? 0 : -1;
+}
+
+ENGINE_API void engine_store_close(EngineStore *st) {
+    if (st->impl) st->backend->close(st->impl);
+    st->impl = NULL;
+}
+
+ENGINE_API int engine_store_load(EngineStore *st, const char *path) {
+    FILE *f = fopen(path, "r");
+    if (!f) return -1;
+    char line[200];
+    EngineRecord r;
+    int added = 0;
+    while (fgets(line, sizeof(line), f)) {
+        if (!engine_parse_csv_line(line, &r)) continue; // Lines that don't split into three fields are skipped
+        if (st->backend->append(st->impl, &r) != 0) { added = -1; break; }
+        added++;
+    }
+    fclose(f);
+    return added;
+}
+
+ENGINE_API int engine_store_save(EngineStore *st, const char *path) {
+    FILE *f = fopen(path, "w");
+    if (!f) {
+        perror("Error opening file");
+        return -1;
+    }
+    for (EngineRecord *r = st->backend->first(st->impl); r; r = st->backend->next(st->impl, r)) {
+        fputs(r->name, f); putc(',', f);
+        fputs(r->phone, f); putc(',', f);
+        fputs(r->email, f); putc('\n', f);
+    }
+    if (ferror(f) | fclose(f)) {
+        perror("Error writing to file");
+        return -1;
+    }
+    return 0;
+}
+
+// --- Field Sort ---
+// Records are gathered into an array of pointers in store order and their
+// fields go through the engine's string sort (packed LSD radix for phones).
+// It is stable, so equal fields keep store order.
+
+// Sorts (key, position) pairs for recs[0..n) by field; strs is scratch for n
+// field pointers. Returns whichever of keys and tmp holds the result.
+static EngineKey *sort_field_keys(EngineRecord **recs, int n, int field, const char **strs, EngineKey *keys, EngineKey *tmp) {
+    for (int i = 0; i < n; i++) strs[i] = engine_field(recs[i], field);
+    return engine_sort_strings(keys, tmp, strs, n, 1);
+}
+
+// The store's records in order, or NULL if memory is short.
+static EngineRecord **store_gather(EngineStore *st, int n) {
+    EngineRecord **recs = (EngineRecord**)malloc((size_t)n * sizeof(EngineRecord*));
+    if (!recs) return NULL;
+    int i = 0;
+    for (EngineRecord *r = st->backend->first(st->impl); r && i < n; r = st->backend->next(st->impl, r)) recs[i++] = r;
+    return recs;
+}
+
+ENGINE_API int engine_store_sort(EngineStore *st, int field) {
+    int n = st->backend->count(st->impl);
+    if (n < 2) return 0;
+    EngineRecord **recs = store_gather(st, n);
+    EngineRecord **order = (EngineRecord**)malloc((size_t)n * sizeof(EngineRecord*));
+    const char **strs = (const char**)malloc((size_t)n * sizeof(const char*));
+    EngineKey *keys = (EngineKey*)malloc((size_t)n * sizeof(EngineKey));
+    EngineKey *tmp = (EngineKey*)malloc((size_t)n * sizeof(EngineKey));
+    int result = -1;
+    if (recs && order && strs && keys && tmp) {
+        EngineKey *sorted = sort_field_keys(recs, n, field, strs, keys, tmp);
+        for (int i = 0; i < n; i++) order[i] = recs[sorted[i].idx];
+        result = st->backend->reorder(st->impl, order);
+    }
+    free(recs); free(order); free(strs); free(keys); free(tmp);
+    return result;
+}
+
+// --- Headless Commands ---
+static void print_row(const EngineRecord *r, char sep) {
+    fputs(r->name, stdout);
+    putchar(sep);
+    fputs(r->phone, stdout);
+    putchar(sep);
+    fputs(r->email, stdout);
+    putchar('\n');
+}
+
+// Prints the records marked in drop[] and removes them from the store.
+static void drop_marked(EngineStore *st, const char *drop, char sep) {
+    int i = 0;
+    for (EngineRecord *r = st->backend->first(st->impl); r; r = st->backend->next(st->impl, r), i++)
+        if (drop[i]) print_row(r, sep);
+    st->backend->remove(st->impl, drop);
+}
+
+// Removes every record whose field repeats one earlier in the store; only
+// positions >= from may go. The stable field sort puts equal fields next to
+// each other in store order, so every one but the first of a run is marked.
+// Emails are sorted and compared case-folded. Returns the records removed, or
+// -1 if memory is short (store untouched).
+static int drop_duplicates(EngineStore *st, int field, int from, char sep) {
+    int n = st->backend->count(st->impl);
+    if (n < 2) return 0;
+    int fold = field == ENGINE_FIELD_EMAIL;
+    EngineRecord **recs = store_gather(st, n);
+    const char **strs = (const char**)malloc((size_t)n * sizeof(const char*));
+    EngineKey *keys = (EngineKey*)malloc((size_t)n * sizeof(EngineKey));
+    EngineKey *tmp = (EngineKey*)malloc((size_t)n * sizeof(EngineKey));
+    char (*folded)[ENGINE_FIELD_BYTES] = fold ? malloc((size_t)n * ENGINE_FIELD_BYTES) : NULL;
+    char *drop = (char*)calloc((size_t)n, 1);
+    int removed = -1;
+    if (recs && strs && keys && tmp && drop && (folded || !fold)) {
+        EngineKey *sorted;
+        if (fold) {
+            for (int i = 0; i < n; i++) {
+                engine_fold_key(folded[i], engine_field(recs[i], field));
+                strs[i] = folded[i];
+            }
+            sorted = engine_sort_strings(keys, tmp, strs, n, 1);
+        } else {
+            sorted = sort_field_keys(recs, n, field, strs, keys, tmp);
+        }
+        removed = 0;
+        for (int i = 1; i < n; i++) {
+            if (sorted[i].idx >= from && strcmp(strs[sorted[i - 1].idx], strs[sorted[i].idx]) == 0) {
+                drop[sorted[i].idx] = 1;
+                removed++;
+            }
+        }
+        if (removed) drop_marked(st, drop, sep);
+    }
+    free(recs); free(strs); free(keys); free(tmp); free(folded); free(drop);
+    return removed;
+}
+
+// Adds the records of a CSV file with the checks an interactive add makes:
+// rows that fail validation are dropped, then rows repeating a phone or email
+// with only the new rows removable, so a stored contact always wins over an
+// imported one. Returns 0, or 1 if the file can't be read or memory is short.
+static int import_contacts(EngineStore *st, const char *path, char sep) {
+    int before = st->backend->count(st->impl);
+    if (engine_store_load(st, path) < 0) {
+        perror(path);
+        return 1;
+    }
+    int n = st->backend->count(st->impl), invalid = 0;
+    char *drop = (char*)calloc((size_t)n + 1, 1);
+    if (!drop) {
+        fprintf(stderr, "donna: not enough memory to check duplicates\n");
+        return 1;
+    }
+    int i = 0;
+    for (EngineRecord *r = st->backend->first(st->impl); r; r = st->backend->next(st->impl, r), i++) {
+        if (i >= before && !(engine_valid_name(r->name) && engine_valid_phone(r->phone) &&
+                             engine_valid_email(r->email, ENGINE_EMAIL_DOTCOM))) {
+            drop[i] = 1;
+            invalid++;
+        }
+    }
+    if (invalid) drop_marked(st, drop, sep);
+    free(drop);
+
+    int phones = drop_duplicates(st, ENGINE_FIELD_PHONE, before, sep);
+    int emails = phones < 0 ? -1 : drop_duplicates(st, ENGINE_FIELD_EMAIL, before, sep);
+    if (emails < 0) {
+        fprintf(stderr, "donna: not enough memory to check duplicates\n");
+        return 1;
+    }
+    fprintf(stderr, "imported %d, rejected %d invalid, %d duplicate\n",
+            st->backend->count(st->impl) - before, invalid, phones + emails);
+    return 0;
+}
+
+// Loads FILE (default "contacts.csv"), runs the command with no prompts, and
+// streams records to stdout as CSV (TSV with --tsv). search, sort and export
+// only read; import and dedupe write FILE back and print the rows they reject
+// or remove. Counts go to stderr so stdout stays pure data.
+ENGINE_API int engine_command(const EngineBackend *backend, int argc, char *argv[]) {
+    const char *file = "contacts.csv";
+    char sep = ',';
+    char *args[4];
+    int n = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) file = argv[++i];
+        else if (strcmp(argv[i], "--tsv") == 0) sep = '\t';
+        else if (n < 4) args[n++] = argv[i];
+        else { n = 0; break; } // Too many arguments
+    }
+
+    const char *cmd = n > 0 ? args[0] : "";
+    int field = n > 1 ? engine_parse_field(args[1]) : 0;
+    int is_import = strcmp(cmd, "import") == 0 && n == 2;
+    int is_dedupe = strcmp(cmd, "dedupe") == 0 && (n == 1 || (n == 2 && field));
+    if (!is_import && !is_dedupe &&
+        !(strcmp(cmd, "search") == 0 && n == 3 && field) &&
+        !(strcmp(cmd, "sort") == 0 && n == 2 && field) &&
+        !(strcmp(cmd, "export") == 0 && n == 1)) {
+        fprintf(stderr,
+                "usage: donna [-f FILE] [--tsv] COMMAND\n"
+                "  import CSV           add valid, non-duplicate rows of CSV; prints the rejected ones\n"
+                "  search FIELD TEXT    contacts whose FIELD contains TEXT\n"
+                "  sort FIELD           all contacts ordered by FIELD\n"
+                "  export               all contacts\n"
+                "  dedupe [FIELD]       remove repeated FIELD values (default: phone, then email)\n"
+                "FIELD is name, phone or email. Without arguments donna starts the menus.\n");
+        return 2;
+    }
+
+    static char out_buf[1 << 16];
+    setvbuf(stdout, out_buf, _IOFBF, sizeof(out_buf));
+    EngineStore st;
+    if (engine_store_open(&st, backend) != 0) {
+        fprintf(stderr, "donna: not enough memory\n");
+        return 1;
+    }
+    if (engine_store_load(&st, file) < 0 && !is_import) {
+        perror(file);
+        engine_store_close(&st);
+        return 1;
+    }
+
+    int status = 0;
+    if (is_import) {
+        status = import_contacts(&st, args[1], sep);
+    } else if (is_dedupe) {
+        int removed = drop_duplicates(&st, field ? field : ENGINE_FIELD_PHONE, 0, sep);
+        if (!field && removed >= 0) {
+            int emails = drop_duplicates(&st, ENGINE_FIELD_EMAIL, 0, sep);
+            removed = emails < 0 ? -1 : removed + emails;
+        }
+        if (removed < 0) {
+            fprintf(stderr, "donna: not enough memory to check duplicates\n");
+            status = 1;
+        } else {
+            fprintf(stderr, "removed %d\n", removed);
+        }
+    } else if (strcmp(cmd, "search") == 0) {
+        for (EngineRecord *r = backend->first(st.impl); r; r = backend->next(st.impl, r))
+            if (strstr(engine_field(r, field), args[2])) print_row(r, sep);
+    } else {
+        if (field && engine_store_sort(&st, field) != 0) {
+            fprintf(stderr, "donna: not enough memory to sort\n");
+            status = 1;
+        }
+        for (EngineRecord *r = backend->first(st.impl); status == 0 && r; r = backend->next(st.impl, r))
+            print_row(r, sep);
+    }
+
+    if (status == 0 && (is_import || is_dedupe) && engine_store_save(&st, file) != 0) status = 1;
+    if (fflush(stdout) != 0) status = 1;
+    engine_store_close(&st);
+    return status;
+}
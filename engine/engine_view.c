@@ -0,0 +1,143 @@
+// engine_view.c
+// Sorted views of the storage engine: an order-statistic treap over records
+// whose keys the front end reads for it, so one copy serves the array lib
+// (records found by slot) and the list lib (records found by node). See
+// engine.h.
+#include "engine.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static uint32_t s_view_rng = 2463534242u;
+
+// xorshift32; the fixed seed keeps tree shapes reproducible between runs.
+static uint32_t view_next_prio(void) {
+    uint32_t x = s_view_rng;
+    x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+    return s_view_rng = x;
+}
+
+static int view_size(const EngineViewNode *t) { return t ? t->size : 0; }
+static void view_update(EngineViewNode *t) { t->size = 1 + view_size(t->left) + view_size(t->right); }
+
+// Rotates x above its parent, keeping sizes and parent links correct.
+static void view_rotate_up(EngineView *v, EngineViewNode *x) {
+    EngineViewNode *p = x->parent, *g = p->parent;
+    if (p->left == x) {
+        p->left = x->right;
+        if (x->right) x->right->parent = p;
+        x->right = p;
+    } else {
+        p->right = x->left;
+        if (x->left) x->left->parent = p;
+        x->left = p;
+    }
+    p->parent = x;
+    x->parent = g;
+    if (!g) v->root = x;
+    else if (g->left == p) g->left = x;
+    else g->right = x;
+    view_update(p);
+    view_update(x);
+}
+
+// A Cartesian tree over random priorities, built along its right spine, O(n).
+ENGINE_API int engine_view_build(EngineView *v, EngineViewNode *const *nodes, int n) {
+    EngineViewNode **spine = (EngineViewNode**)malloc((n + 1) * sizeof(EngineViewNode*)); // Right spine of the tree so far
+    if (!spine) return -1;
+
+    int top = 0;
+    for (int i = 0; i < n; i++) {
+        EngineViewNode *x = nodes[i];
+        x->prio = view_next_prio();
+        x->right = NULL;
+        x->size = 1;
+
+        EngineViewNode *last = NULL; // Spine nodes with lower priority become x's left subtree
+        while (top > 0 && spine[top - 1]->prio < x->prio) {
+            last = spine[--top];
+            view_update(last);
+        }
+        x->left = last;
+        if (last) last->parent = x;
+        x->parent = top > 0 ? spine[top - 1] : NULL;
+        if (x->parent) x->parent->right = x;
+        spine[top++] = x;
+    }
+    while (top > 1) view_update(spine[--top]);
+    if (top > 0) view_update(spine[0]);
+    v->root = top > 0 ? spine[0] : NULL;
+    v->built = 1;
+    free(spine);
+    return 0;
+}
+
+// Key order, then id order among equal keys.
+static int view_cmp(const EngineView *v, const EngineViewNode *a, const EngineViewNode *b) {
+    int c = strcmp(v->key(v, a), v->key(v, b));
+    return c != 0 ? c : (a->id > b->id) - (a->id < b->id);
+}
+
+ENGINE_API void engine_view_insert(EngineView *v, EngineViewNode *x) {
+    x->left = x->right = NULL;
+    x->size = 1;
+    x->prio = view_next_prio();
+
+    EngineViewNode *p = NULL, **link = &v->root;
+    while (*link) {
+        p = *link;
+        p->size++;
+        link = view_cmp(v, x, p) < 0 ? &p->left : &p->right;
+    }
+    *link = x;
+    x->parent = p;
+    while (x->parent && x->parent->prio < x->prio) view_rotate_up(v, x);
+}
+
+ENGINE_API void engine_view_erase(EngineView *v, EngineViewNode *x) {
+    while (x->left || x->right) { // Rotate the higher-priority child up until x is a leaf
+        EngineViewNode *c = !x->left ? x->right : !x->right ? x->left
+                          : (x->left->prio > x->right->prio ? x->left : x->right);
+        view_rotate_up(v, c);
+    }
+    EngineViewNode *p = x->parent;
+    if (!p) v->root = NULL;
+    else if (p->left == x) p->left = NULL;
+    else p->right = NULL;
+    for (; p; p = p->parent) p->size--;
+}
+
+ENGINE_API EngineViewNode *engine_view_first(const EngineView *v) {
+    EngineViewNode *t = v->root;
+    while (t && t->left) t = t->left;
+    return t;
+}
+
+ENGINE_API EngineViewNode *engine_view_next(EngineViewNode *t) {
+    if (t->right) {
+        for (t = t->right; t->left; t = t->left) {}
+        return t;
+    }
+    while (t->parent && t->parent->right == t) t = t->parent;
+    return t->parent;
+}
+
+ENGINE_API EngineViewNode *engine_view_select(const EngineView *v, int k) {
+    EngineViewNode *t = v->root;
+    while (t) {
+        int left = view_size(t->left);
+        if (k < left) t = t->left;
+        else if (k == left) return t;
+        else { k -= left + 1; t = t->right; }
+    }
+    return NULL;
+}
+
+ENGINE_API EngineViewNode *engine_view_lower_bound(const EngineView *v, const char *key) {
+    EngineViewNode *t = v->root, *best = NULL;
+    while (t) {
+        if (strcmp(v->key(v, t), key) < 0) t = t->right;
+        else { best = t; t = t->left; }
+    }
+    return best;
+}
@@ -213,13 +213,13 @@ with st.expander("➕ Add New Contact", expanded=False):
 search_expander_open = st.session_state.expander_search_results is not None
 with st.expander("🔍 Search Contacts", expanded=search_expander_open):
     search_query_input = st.text_input("Search Query",value=st.session_state.expander_last_search_query, key="search_query_exp")
-    search_type_option_input = st.selectbox("Search By", ("Name", "Phone", "Email"), key="search_type_exp")
+    search_type_option_input = st.selectbox("Search By", ("Name", "Phone", "Email", "Name sounds like"), key="search_type_exp")
     if st.button("Search", key="search_btn_exp"): 
         if search_query_input:
             op_name = f"Search by {search_type_option_input} for '{search_query_input}'"
             try:
                 start_time = time.perf_counter()
-                results = contact_manager_c.search_contacts(search_query_input, {"Name": 1, "Phone": 2, "Email": 3}[search_type_option_input])
+                results = contact_manager_c.search_contacts(search_query_input, {"Name": 1, "Phone": 2, "Email": 3, "Name sounds like": 4}[search_type_option_input])
                 end_time = time.perf_counter()
                 st.session_state.last_operation_details = {"name": op_name, "time": end_time - start_time}
                 st.session_state.expander_search_results = results if results is not None else []
@@ -1,4 +1,5 @@
 #include "contact.h" // [cite: 1]
+#include "engine.h"  // Shared storage engine (../engine)
 #include <stdio.h>    // Included via contact.h
 #include <stdlib.h>   // Included via contact.h
 #include <string.h>   // Included via contact.h
@@ -10,6 +11,170 @@ Node *head = NULL; // [cite: 1]
 int count = 0; // [cite: 1]
 static FILE *pF = NULL; // [cite: 1]
 
+// --- Record ids ---
+// Every node gets the next 64-bit id when it is loaded or added; ids are never
+// reused while the module is loaded. The engine's id table maps each live id to
+// its node, so an id lookup is O(1) whatever the list length, and with the prev
+// links the node unlinks without a walk. Deleted ids leave the table, so it
+// stays proportional to the live nodes.
+static EngineIds s_ids;        // id -> node (.ref)
+static uint64_t s_next_id = 1; // 0 is never an id
+
+// Gives n the next id. Returns 1, or 0 if the table could not grow.
+static int id_assign(Node *n) {
+    EngineKey *e = engine_ids_insert(&s_ids, s_next_id);
+    if (!e) return 0;
+    e->ref = n;
+    n->id = s_next_id++;
+    return 1;
+}
+
+static Node *id_find(uint64_t id) {
+    const EngineKey *e = engine_ids_find(&s_ids, id);
+    return e ? e->ref : NULL;
+}
+
+static void id_release(const Node *n) { engine_ids_remove(&s_ids, n->id); }
+
+// Forgets every id issued so far; the next ones continue the sequence.
+static void id_reset(void) { engine_ids_free(&s_ids); }
+
+// Pushes n on the front of the list.
+static void list_push(Node *n) {
+    n->prev = NULL;
+    n->next = head;
+    if (head) head->prev = n;
+    head = n;
+}
+
+static void list_unlink(Node *n) {
+    if (n->prev) n->prev->next = n->next; else head = n->next;
+    if (n->next) n->next->prev = n->prev;
+}
+
+// Sorts relink the list through next only; this restores prev afterwards.
+static void list_relink_prev(void) {
+    Node *prev = NULL;
+    for (Node *p = head; p; prev = p, p = p->next) p->prev = prev;
+}
+
+// --- Normalized keys ---
+// Names and emails compare case-insensitively, as in the v2 library. Each Node
+// carries a folded copy of both (engine_fold_key), written whenever the field
+// is, so comparisons stay plain strcmp and byte scans. Phones are digits only
+// and need no shadow.
+static void node_fold_keys(Node *n) {
+    engine_fold_key(n->name_key, n->name);
+    engine_fold_key(n->email_key, n->email);
+}
+
+static void node_to_data(ContactData *dst, const Node *src) {
+    memcpy(dst->name, src->name, sizeof(dst->name));
+    memcpy(dst->phone, src->phone, sizeof(dst->phone));
+    memcpy(dst->email, src->email, sizeof(dst->email));
+    dst->id = src->id;
+}
+
+// --- Duplicate-check Bloom filters ---
+// Adds reject duplicate phones and emails, and in a bulk import nearly every
+// such check is negative, which used to mean a full list walk each. A blocked
+// Bloom filter per field answers "definitely absent" from one cache line: a
+// key sets one bit in each of the eight words of a 64-byte block picked by its
+// hash. Only a "maybe" (a real duplicate, or about one absent key in 10^4)
+// walks the list. Deleted and overwritten values keep their bits, which only
+// costs false positives. Both filters are rebuilt from the list, sized for
+// twice its length, whenever the keys filed since the last build reach that
+// size, so rebuilds cost O(1) amortized per write. A filter that could not be
+// allocated answers "maybe" to everything until the next rebuild. The filters
+// themselves are the engine's EngineBloom. Emails are filed by their folded
+// key, since John@x.com and john@x.com are the same address.
+static EngineBloom s_phone_bloom, s_email_bloom;
+static size_t s_bloom_capacity = 0; // Keys the filters were sized for (0: not built)
+static size_t s_bloom_filed = 0;    // Keys filed, stale ones included
+
+static void bloom_drop(void) {
+    engine_bloom_free(&s_phone_bloom);
+    engine_bloom_free(&s_email_bloom);
+    s_bloom_capacity = s_bloom_filed = 0;
+}
+
+// Refiles every node's phone and email into filters sized from the list length.
+static void bloom_rebuild(void) {
+    bloom_drop();
+    size_t keys = 2 * (size_t)count;
+    if (keys < ENGINE_BLOOM_MIN_KEYS) keys = ENGINE_BLOOM_MIN_KEYS;
+    engine_bloom_init(&s_phone_bloom, keys); // On failure every lookup says "maybe"
+    engine_bloom_init(&s_email_bloom, keys);
+    s_bloom_capacity = keys;
+    for (Node *p = head; p; p = p->next) {
+        engine_bloom_add(&s_phone_bloom, p->phone);
+        engine_bloom_add(&s_email_bloom, p->email_key);
+    }
+    s_bloom_filed = (size_t)count;
+}
+
+// Files p's phone and email; called after every write of either, with p on the list.
+static void bloom_note(const Node *p) {
+    if (s_bloom_filed >= s_bloom_capacity) { bloom_rebuild(); return; }
+    engine_bloom_add(&s_phone_bloom, p->phone);
+    engine_bloom_add(&s_email_bloom, p->email_key);
+    s_bloom_filed++;
+}
+
+// --- Phonetic index ---
+// "Sounds like" lookup on names through the engine's Soundex index
+// (EngineSound), kept current by every write. Each Node embeds its entry.
+#define SEARCH_SOUNDS_LIKE 4 // search_type for search_contacts_py
+
+static EngineSound s_sound;
+
+#define SOUND_NODE(e) ((Node *)((char *)(e) - offsetof(Node, sound)))
+
+// Indexes rec under the codes of its current name.
+static void sound_insert(Node *rec) {
+    engine_sound_insert(&s_sound, &rec->sound, rec->name);
+}
+
+static void sound_erase(Node *rec) {
+    engine_sound_erase(&s_sound, &rec->sound);
+}
+
+static void sound_drop(void) {
+    engine_sound_free(&s_sound);
+}
+
+static int sound_hit_cmp(const void *a, const void *b) {
+    const Node *x = *(Node* const*)a, *y = *(Node* const*)b;
+    int c = strcmp(x->name_key, y->name_key);
+    return c ? c : strcmp(x->email_key, y->email_key);
+}
+
+// Contacts whose name has a word sounding like every word of query, in name order.
+static ContactData *sound_search(const char *query, int *num_found) {
+    if (s_sound.stale) { // Catch up after a failed bucket growth
+        sound_drop();
+        for (Node *p = head; p; p = p->next) sound_insert(p);
+        if (s_sound.stale) return NULL;
+    }
+    int found;
+    EngineSoundEntry **hits = engine_sound_find(&s_sound, query, &found);
+    if (!hits) return NULL;
+    Node **nodes = malloc(found * sizeof(Node*));
+    ContactData *found_array = malloc(found * sizeof(ContactData));
+    if (nodes && found_array) {
+        for (int i = 0; i < found; i++) nodes[i] = SOUND_NODE(hits[i]);
+        qsort(nodes, found, sizeof(Node*), sound_hit_cmp);
+        for (int i = 0; i < found; i++) node_to_data(&found_array[i], nodes[i]);
+        *num_found = found;
+    } else {
+        free(found_array);
+        found_array = NULL;
+    }
+    free(hits);
+    free(nodes);
+    return found_array;
+}
+
 // --- Implementation of library-friendly C functions ---
 
 void initialize_library() {
@@ -21,16 +186,24 @@ void initialize_library() {
     }
     head = NULL;
     count = 0;
+    sound_drop();
+    id_reset();
 
     pF = fopen("contacts.csv", "r"); // [cite: 1]
     if (pF) {
         char line[200];
+        EngineRecord r;
         while (fgets(line, sizeof(line), pF)) { // [cite: 1]
+            if (!engine_parse_csv_line(line, &r)) continue; // Malformed line
             Node *n = malloc(sizeof(Node)); // [cite: 1]
             if (!n) { /* Handle malloc failure if necessary */ continue; }
-            if (sscanf(line, "%49[^,],%49[^,],%49[^\n]\n", n->name, n->phone, n->email) == 3) { // [cite: 1]
-                n->next = head; // [cite: 1]
-                head = n; // [cite: 1]
+            memcpy(n->name, r.name, sizeof(n->name));
+            memcpy(n->phone, r.phone, sizeof(n->phone));
+            memcpy(n->email, r.email, sizeof(n->email));
+            node_fold_keys(n);
+            if (id_assign(n)) { // [cite: 1]
+                sound_insert(n);
+                list_push(n);
                 count++; // [cite: 1]
             } else {
                 free(n); // [cite: 1]
@@ -39,9 +212,15 @@ void initialize_library() {
         fclose(pF); // [cite: 1]
         pF = NULL;
     }
+    bloom_rebuild();
 }
 
 int add_contact_py(const char* name_str, const char* phone_str, const char* email_str) {
+    return add_contact_id_py(name_str, phone_str, email_str, NULL);
+}
+
+int add_contact_id_py(const char* name_str, const char* phone_str, const char* email_str, uint64_t* out_id) {
+    if (out_id) *out_id = 0;
     if (!isvalidname(name_str)) return -1; // [cite: 1]
     if (isvalidnumber(phone_str) != 2) return -2; // Original returns 2 for valid 10-digit number [cite: 1]
     if (isvalidemail(email_str) != 2) return -3; // Original returns 2 for valid .com email [cite: 1]
@@ -59,10 +238,14 @@ int add_contact_py(const char* name_str, const char* phone_str, const char* emai
     nw->phone[sizeof(nw->phone) - 1] = '\0';
     strncpy(nw->email, email_str, sizeof(nw->email) - 1);
     nw->email[sizeof(nw->email) - 1] = '\0';
+    node_fold_keys(nw);
+    if (!id_assign(nw)) { free(nw); return -6; }
+    if (out_id) *out_id = nw->id;
+    sound_insert(nw);
 
-    nw->next = head; // [cite: 1]
-    head = nw; // [cite: 1]
+    list_push(nw);
     count++; // [cite: 1]
+    bloom_note(nw);
     return 1; // Success
 }
 
@@ -87,12 +270,7 @@ ContactData* get_all_contacts_py(int* num_contacts) {
             // Might indicate an issue, but return what we have
             return contacts_array;
         }
-        strncpy(contacts_array[i].name, p->name, sizeof(contacts_array[i].name) -1);
-        contacts_array[i].name[sizeof(contacts_array[i].name) -1] = '\0';
-        strncpy(contacts_array[i].phone, p->phone, sizeof(contacts_array[i].phone) -1);
-         contacts_array[i].phone[sizeof(contacts_array[i].phone) -1] = '\0';
-        strncpy(contacts_array[i].email, p->email, sizeof(contacts_array[i].email) -1);
-        contacts_array[i].email[sizeof(contacts_array[i].email) -1] = '\0';
+        node_to_data(&contacts_array[i], p);
         p = p->next; // [cite: 1]
     }
     return contacts_array;
@@ -104,22 +282,27 @@ void free_contact_data_array(ContactData* data_array) {
     }
 }
 
+// --- Substring search ---
+// Fields are scanned with the engine's SIMD substring kernel (engine_field_matcher),
+// names and emails through their folded keys with a folded query.
 ContactData* search_contacts_py(const char* query, int search_type, int* num_found) {
     *num_found = 0;
     if (!head || !query || query[0] == '\0') return NULL;
+    if (search_type == SEARCH_SOUNDS_LIKE) return sound_search(query, num_found);
 
     int matches_capacity = 10; // Initial capacity
     ContactData* found_array = malloc(matches_capacity * sizeof(ContactData));
     if(!found_array) return NULL;
 
+    static const size_t field_offs[3] = { offsetof(Node, name_key), offsetof(Node, phone), offsetof(Node, email_key) };
+    char key[ENGINE_FIELD_BYTES];
+    if (search_type < 1 || search_type > 3 || !engine_fold_key(key, query)) { free(found_array); return NULL; }
+    size_t field_off = field_offs[search_type - 1], query_len = strlen(key);
+    EngineFieldMatcher contains = engine_field_matcher(query_len);
+
     int current_match_idx = 0;
     for (Node *p = head; p; p = p->next) { // [cite: 1]
-        bool is_match = false;
-        if (search_type == 1 && strstr(p->name, query)) is_match = true; // [cite: 1]
-        else if (search_type == 2 && strstr(p->phone, query)) is_match = true; // [cite: 1]
-        else if (search_type == 3 && strstr(p->email, query)) is_match = true; // [cite: 1]
-
-        if (is_match) {
+        if (contains((const char *)p + field_off, key, query_len)) {
             if (current_match_idx >= matches_capacity) {
                 matches_capacity *= 2;
                 ContactData* temp = realloc(found_array, matches_capacity * sizeof(ContactData));
@@ -130,13 +313,7 @@ ContactData* search_contacts_py(const char* query, int search_type, int* num_fou
                 }
                 found_array = temp;
             }
-            strncpy(found_array[current_match_idx].name, p->name, sizeof(found_array[current_match_idx].name)-1);
-            found_array[current_match_idx].name[sizeof(found_array[current_match_idx].name)-1] = '\0';
-            strncpy(found_array[current_match_idx].phone, p->phone, sizeof(found_array[current_match_idx].phone)-1);
-            found_array[current_match_idx].phone[sizeof(found_array[current_match_idx].phone)-1] = '\0';
-            strncpy(found_array[current_match_idx].email, p->email, sizeof(found_array[current_match_idx].email)-1);
-            found_array[current_match_idx].email[sizeof(found_array[current_match_idx].email)-1] = '\0';
-            current_match_idx++;
+            node_to_data(&found_array[current_match_idx++], p);
         }
     }
 
@@ -153,35 +330,128 @@ ContactData* search_contacts_py(const char* query, int search_type, int* num_fou
     return final_array;
 }
 
+// --- Query Engine ---
+// Boolean field queries (see engine.h for the syntax) are compiled and run by
+// the engine against the folded keys, so values match case-insensitively, like
+// search_contacts_py.
+ContactQuery* compile_query_py(const char* text, char* error, size_t error_size) {
+    static const size_t field_offs[3] = { offsetof(Node, name_key), offsetof(Node, phone), offsetof(Node, email_key) };
+    return engine_query_compile(text, field_offs, 1, error, error_size);
+}
+
+ContactData* run_query_py(const ContactQuery* query, int* num_found) {
+    *num_found = 0;
+    if (!query || !head) return NULL;
+    int capacity = 0, found = 0;
+    ContactData *found_array = NULL;
+    for (Node *p = head; p; p = p->next) {
+        if (!engine_query_match(query, p)) continue;
+        if (found == capacity) {
+            capacity = capacity ? capacity * 2 : 16;
+            ContactData *temp = realloc(found_array, capacity * sizeof(ContactData));
+            if (!temp) { free(found_array); return NULL; }
+            found_array = temp;
+        }
+        node_to_data(&found_array[found++], p);
+    }
+    *num_found = found;
+    return found_array;
+}
+
+void free_query_py(ContactQuery* query) {
+    engine_query_free(query);
+}
+
+// Unlinks p from the list and the indexes and frees it.
+static void remove_node(Node *p) {
+    sound_erase(p);
+    id_release(p);
+    list_unlink(p);
+    free(p);
+    count--;
+}
+
+// Bulk writes by predicate: one walk of the list evaluates the query on each
+// node and unlinks or rewrites the matches, instead of one lookup per victim.
+int delete_contacts_where_py(const ContactQuery* query) {
+    if (!query) return 0;
+    int deleted = 0;
+    for (Node *p = head, *next; p; p = next) {
+        next = p->next;
+        if (!engine_query_match(query, p)) continue;
+        remove_node(p);
+        deleted++;
+    }
+    return deleted;
+}
+
+int update_contacts_where_py(const ContactQuery* query, const char* new_name, const char* new_phone) {
+    if (!query || (!new_name && !new_phone)) return 0;
+    if (new_name && !isvalidname(new_name)) return -1;
+    if (new_phone && isvalidnumber(new_phone) != 2) return -2;
+    // Phones stay unique, so a new phone may go to one match only, and not to a
+    // number some other contact already has. The matches are gathered first.
+    Node **hits = NULL;
+    int found = 0, capacity = 0, phone_taken = 0;
+    for (Node *p = head; p; p = p->next) {
+        if (!engine_query_match(query, p)) {
+            phone_taken |= new_phone && strcmp(p->phone, new_phone) == 0;
+            continue;
+        }
+        if (found == capacity) {
+            capacity = capacity ? capacity * 2 : 16;
+            Node **temp = realloc(hits, capacity * sizeof(Node*));
+            if (!temp) { free(hits); return -6; }
+            hits = temp;
+        }
+        hits[found++] = p;
+    }
+    if (new_phone && (phone_taken || found > 1)) { free(hits); return -4; }
+    for (int i = 0; i < found; i++) {
+        Node *p = hits[i];
+        if (new_name) {
+            sound_erase(p);
+            strncpy(p->name, new_name, sizeof(p->name) - 1);
+            p->name[sizeof(p->name) - 1] = '\0';
+            node_fold_keys(p);
+            sound_insert(p);
+        }
+        if (new_phone) {
+            strncpy(p->phone, new_phone, sizeof(p->phone) - 1);
+            p->phone[sizeof(p->phone) - 1] = '\0';
+            bloom_note(p);
+        }
+    }
+    free(hits);
+    return found;
+}
+
 int delete_contact_by_email_py(const char* email_str) {
-    Node *cur = head, *prev = NULL; // [cite: 1]
-    while (cur) {
+    for (Node *cur = head; cur; cur = cur->next) { // [cite: 1]
         if (strcmp(cur->email, email_str) == 0) { // [cite: 1]
-            if (prev) {
-                prev->next = cur->next; // [cite: 1]
-            } else {
-                head = cur->next; // [cite: 1]
-            }
-            free(cur); // [cite: 1]
-            count--; // [cite: 1]
+            remove_node(cur);
             return 1; // Deleted
         }
-        prev = cur; // [cite: 1]
-        cur = cur->next; // [cite: 1]
     }
     return 0; // Not found
 }
 
-int edit_contact_py(const char* old_email_str, const char* new_name_str, const char* new_phone_str, const char* new_email_str) {
-    Node *target = NULL;
-    for (Node *p = head; p; p = p->next) { // [cite: 1]
-        if (strcmp(p->email, old_email_str) == 0) { // [cite: 1]
-            target = p;
-            break;
-        }
-    }
+int delete_contact_by_id_py(uint64_t id) {
+    Node *target = id_find(id);
+    if (!target) return 0; // Not found
+    remove_node(target);
+    return 1; // Deleted
+}
 
-    if (!target) return 0; // Original contact not found
+int get_contact_by_id_py(uint64_t id, ContactData* out) {
+    Node *target = id_find(id);
+    if (!target || !out) return 0;
+    node_to_data(out, target);
+    return 1;
+}
+
+// Validates the new fields and writes them into target; returns as edit_contact_py.
+static int edit_node(Node *target, const char* new_name_str, const char* new_phone_str, const char* new_email_str) {
 
     // Validate new data
     if (!isvalidname(new_name_str)) return -1; // [cite: 1]
@@ -190,27 +460,52 @@ int edit_contact_py(const char* old_email_str, const char* new_name_str, const c
 
     // Check for duplicates only if the phone/email is actually changing
     // And if the new phone/email belongs to another contact
-    if (strcmp(target->phone, new_phone_str) != 0) {
+    if (strcmp(target->phone, new_phone_str) != 0 && engine_bloom_maybe(&s_phone_bloom, new_phone_str)) {
         Node *temp_node = head;
         while(temp_node){
             if(temp_node != target && strcmp(temp_node->phone, new_phone_str) == 0) return -4; // New phone exists for another contact
             temp_node = temp_node->next;
         }
     }
-    if (strcmp(target->email, new_email_str) != 0) {
+    char email_key[ENGINE_FIELD_BYTES];
+    engine_fold_key(email_key, new_email_str);
+    if (strcmp(target->email, new_email_str) != 0 && engine_bloom_maybe(&s_email_bloom, email_key)) {
          Node *temp_node = head;
         while(temp_node){
-            if(temp_node != target && strcmp(temp_node->email, new_email_str) == 0) return -5; // New email exists for another contact
+            if(temp_node != target && strcmp(temp_node->email_key, email_key) == 0) return -5; // New email exists for another contact, in any case
             temp_node = temp_node->next;
         }
     }
 
+    sound_erase(target);
     strcpy(target->name, new_name_str); // [cite: 1]
     strcpy(target->phone, new_phone_str); // [cite: 1]
     strcpy(target->email, new_email_str); // [cite: 1]
+    node_fold_keys(target);
+    sound_insert(target);
+    bloom_note(target);
     return 1; // Success
 }
 
+int edit_contact_py(const char* old_email_str, const char* new_name_str, const char* new_phone_str, const char* new_email_str) {
+    Node *target = NULL;
+    for (Node *p = head; p; p = p->next) { // [cite: 1]
+        if (strcmp(p->email, old_email_str) == 0) { // [cite: 1]
+            target = p;
+            break;
+        }
+    }
+
+    if (!target) return 0; // Original contact not found
+    return edit_node(target, new_name_str, new_phone_str, new_email_str);
+}
+
+int edit_contact_by_id_py(uint64_t id, const char* new_name_str, const char* new_phone_str, const char* new_email_str) {
+    Node *target = id_find(id);
+    if (!target) return 0; // Contact not found
+    return edit_node(target, new_name_str, new_phone_str, new_email_str);
+}
+
 void delete_all_contacts_py() {
     Node *cur = head; // [cite: 1]
     while (cur) {
@@ -220,6 +515,9 @@ void delete_all_contacts_py() {
     }
     head = NULL; // [cite: 1]
     count = 0; // [cite: 1]
+    sound_drop();
+    id_reset();
+    bloom_drop();
 }
 
 void save_contacts_py() {
@@ -259,108 +557,67 @@ void save_contacts_py() {
     pF = NULL;
 }
 
-// --- Sorting related C functions (Merge Sort - from original code) ---
-// These static helper functions are used by the sort_contacts_by_..._py functions.
-// They don't need to be in contact.h if they are only used internally in this file.
-
-static int cmpName(Node *a, Node *b)  { return strcmp(a->name,  b->name)  <= 0; } // [cite: 1]
-static int cmpPhone(Node *a, Node *b) { return strcmp(a->phone, b->phone) <= 0; } // [cite: 1]
-static int cmpEmail(Node *a, Node *b) { return strcmp(a->email, b->email) <= 0; } // [cite: 1]
-
-static void frontBackSplit(Node *source, Node **frontRef, Node **backRef) { // [cite: 1]
-    if (source == NULL || source->next == NULL) {
-        *frontRef = source;
-        *backRef = NULL;
-        return;
-    }
-    Node *slow = source; // [cite: 1]
-    Node *fast = source->next; // [cite: 1]
-    while (fast != NULL) { // [cite: 1]
-        fast = fast->next; // [cite: 1]
-        if (fast != NULL) {
-            slow = slow->next; // [cite: 1]
-            fast = fast->next; // [cite: 1]
-        }
-    }
-    *frontRef = source; // [cite: 1]
-    *backRef  = slow->next; // [cite: 1]
-    slow->next = NULL; // [cite: 1]
-}
-
-static Node *sortedMerge(Node *a, Node *b, int (*cmp)(Node*,Node*)) { // [cite: 1]
-    if (!a) return b; // [cite: 1]
-    if (!b) return a; // [cite: 1]
-    Node *result = NULL;
-    if (cmp(a,b)) { // [cite: 1]
-        result = a;
-        result->next = sortedMerge(a->next, b, cmp); // [cite: 1]
-    } else {
-        result = b;
-        result->next = sortedMerge(a, b->next, cmp); // [cite: 1]
-    }
-    return result;
-}
-
-static Node *mergeSort(Node *h, int (*cmp)(Node*,Node*)) { // [cite: 1]
-    if (!h || !h->next) return h; // [cite: 1]
-    Node *a, *b;
-    frontBackSplit(h, &a, &b); // [cite: 1]
-    a = mergeSort(a, cmp); // [cite: 1]
-    b = mergeSort(b, cmp); // [cite: 1]
-    return sortedMerge(a, b, cmp); // [cite: 1]
-}
-
+// --- Sorting ---
+// Every field goes through the engine's list sort: packed LSD radix for phones,
+// MSD radix on cached prefixes of the folded keys for names and emails. All
+// stable.
 void sort_contacts_by_name_py() {
-    head = mergeSort(head, cmpName); // [cite: 1]
+    head = engine_sort_list(head, count, offsetof(Node, next), offsetof(Node, name_key), 1);
+    list_relink_prev();
 }
 void sort_contacts_by_phone_py() {
-    head = mergeSort(head, cmpPhone); // [cite: 1]
+    head = engine_sort_list(head, count, offsetof(Node, next), offsetof(Node, phone), 1);
+    list_relink_prev();
 }
 void sort_contacts_by_email_py() {
-    head = mergeSort(head, cmpEmail); // [cite: 1]
+    head = engine_sort_list(head, count, offsetof(Node, next), offsetof(Node, email_key), 1);
+    list_relink_prev();
+}
+
+// --- Sorted pages ---
+// Returns one page of the order sort_contacts_by_*_py would produce without
+// sorting the list: engine_sort_page() orders just the page, so the first
+// screen of a large list costs O(n + limit log limit) instead of a full sort.
+ContactData* get_sorted_page_py(int field, int offset, int limit, int* num_found) {
+    static const size_t field_offs[3] = { offsetof(Node, name_key), offsetof(Node, phone), offsetof(Node, email_key) };
+    *num_found = 0;
+    if (field < 1 || field > 3 || offset < 0 || limit <= 0 || offset >= count) return NULL;
+    if (limit > count - offset) limit = count - offset;
+    size_t off = field_offs[field - 1];
+
+    const char **strs = malloc(count * sizeof(const char *));
+    EngineKey *keys = malloc(count * sizeof(EngineKey));
+    ContactData *page = malloc(limit * sizeof(ContactData));
+    if (!strs || !keys || !page) { free(strs); free(keys); free(page); return NULL; }
+
+    int n = 0;
+    for (Node *p = head; p && n < count; p = p->next) strs[n++] = (const char *)p + off;
+    if (offset >= n) { free(strs); free(keys); free(page); return NULL; }
+    if (limit > n - offset) limit = n - offset;
+
+    engine_sort_page(keys, strs, n, offset, limit);
+    for (int i = 0; i < limit; i++) {
+        node_to_data(&page[i], (const Node *)(strs[keys[offset + i].idx] - off));
+    }
+    free(strs);
+    free(keys);
+    *num_found = limit;
+    return page;
 }
 
 // --- Validation and checking functions (from original code) ---
+// Validation is the engine's, with the CLIs' ".com" email rule.
 int isvalidname(const char name[]) { // [cite: 1]
-    if (name == NULL || name[0] == '\0') return 0; // Cannot be empty
-    for (int i = 0; name[i] != '\0'; i++) {
-        if (!isalpha(name[i]) && name[i] != ' ') { // [cite: 1]
-            return 0; // Contains non-alpha/non-space
-        }
-    }
-    return 1; // Valid (original was 0 or 1, let's stick to 1 for true)
+    return engine_valid_name(name); // 1 if valid
 }
 
 int isvalidnumber(const char number[]) { // [cite: 1]
-    int length = strlen(number); // [cite: 1]
-    if (length != 10) return 0; // [cite: 1]
-    for (int i = 0; i < length; i++) {
-        if (!isdigit(number[i])) return 0; // [cite: 1]
-    }
-    return 2; // Valid (original returns 2 for valid) [cite: 1]
+    return engine_valid_phone(number) ? 2 : 0; // Original returns 2 for valid [cite: 1]
 }
 
 int isvalidemail(const char email[]) { // [cite: 1]
-    // Basic validation: must contain '@', '.', and ".com" at the end. No spaces.
-    // Original logic was a bit convoluted. This is a simplified common check.
-    int len = strlen(email);
-    if (len < 6) return 0; // Min: a@b.cm
-
-    char *at_sym = strchr(email, '@');
-    char *dot_sym = strrchr(email, '.'); // Last dot
-
-    if (!at_sym || !dot_sym || at_sym > dot_sym) return 0; // '@' must exist, '.' must exist after '@'
-    if (at_sym == email || at_sym == email + len -1 ) return 0; // no char before @ or after
-    if (dot_sym == email || dot_sym == email + len -1 ) return 0; // no char before . or after
-
-    // Check for ".com" ending more robustly
-    if (strcmp(dot_sym, ".com") != 0) return 1; // Has '@' and '.', but not ending in ".com", original returns 1 for partial [cite: 1]
-
-    for(int i=0; email[i] != '\0'; i++){
-        if(email[i] == ' ') return 0; // No spaces allowed
-    }
-    // Original returned 2 for full valid (.com ending)
-    return 2; // [cite: 1]
+    if (engine_valid_email(email, ENGINE_EMAIL_DOTCOM)) return 2; // [cite: 1]
+    return engine_valid_email(email, ENGINE_EMAIL_SHAPE); // 1: well formed but not ".com", as the original [cite: 1]
 }
 
 int checkname(const char *s) { // [cite: 1]
@@ -370,14 +627,17 @@ int checkname(const char *s) { // [cite: 1]
 }
 
 int checkphone(const char *s) { // [cite: 1]
+    if (!engine_bloom_maybe(&s_phone_bloom, s)) return 0;
     for (Node *p = head; p; p = p->next)
         if (strcmp(p->phone, s) == 0) return 1; // [cite: 1]
     return 0;
 }
 
 int checkemail(const char *s) { // [cite: 1]
+    char key[ENGINE_FIELD_BYTES];
+    if (!engine_fold_key(key, s) || !engine_bloom_maybe(&s_email_bloom, key)) return 0;
     for (Node *p = head; p; p = p->next)
-        if (strcmp(p->email, s) == 0) return 1; // [cite: 1]
+        if (strcmp(p->email_key, key) == 0) return 1; // Emails match in any case
     return 0;
 }
 
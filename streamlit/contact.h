@@ -6,6 +6,9 @@
 #include <string.h>
 #include <ctype.h> //
 #include <stdbool.h> //
+#include <stdint.h>
+#include <stddef.h>
+#include "engine.h" // EngineSoundEntry, EngineQuery
 
 #ifdef __cplusplus
 extern "C" {
@@ -16,7 +19,12 @@ typedef struct Node { //
     char name[50]; //
     char phone[50]; //
     char email[50]; //
+    char name_key[50];  // Case-folded shadows of name and email, kept in step on every write;
+    char email_key[50]; // duplicate checks, search, queries and sorts compare these
     struct Node *next; //
+    struct Node *prev; // Kept in step with next so a node found by id unlinks in O(1)
+    uint64_t id;       // Stable record id, see get_contact_by_id_py
+    EngineSoundEntry sound; // Soundex codes of the first name words and their index slots, for search_type 4
 } Node;
 
 extern Node *head; // extern so it can be accessed by contact.c
@@ -27,6 +35,7 @@ typedef struct ContactData {
     char name[50];
     char phone[50];
     char email[50];
+    uint64_t id; // Stable record id; never reused while the module is loaded
 } ContactData;
 
 // --- Library-friendly C functions to be wrapped by Pybind11 ---
@@ -52,6 +61,21 @@ void initialize_library();
  */
 int add_contact_py(const char* name, const char* phone, const char* email);
 
+/**
+ * @brief Adds a new contact and reports its id.
+ * @param out_id Receives the new contact's id (0 if the add failed). May be NULL.
+ * @return As add_contact_py.
+ */
+int add_contact_id_py(const char* name, const char* phone, const char* email, uint64_t* out_id);
+
+/**
+ * @brief Looks a contact up by id, in O(1).
+ * @param id An id from add_contact_id_py or a returned ContactData.
+ * @param out Receives the contact.
+ * @return 1 if found, 0 if no contact has this id.
+ */
+int get_contact_by_id_py(uint64_t id, ContactData* out);
+
 /**
  * @brief Gets the current number of contacts.
  * @return Total number of contacts.
@@ -73,15 +97,64 @@ ContactData* get_all_contacts_py(int* num_contacts);
 void free_contact_data_array(ContactData* data_array);
 
 /**
- * @brief Searches contacts based on a query and type.
+ * @brief Searches contacts based on a query and type. Names and emails match case-insensitively.
  * The caller is responsible for freeing the returned array using free_contact_data_array.
  * @param query The search string.
- * @param search_type 1 for name, 2 for phone, 3 for email.
+ * @param search_type 1 for name, 2 for phone, 3 for email, 4 for names that sound like the query (Soundex).
  * @param num_found Pointer to an integer where the number of found contacts will be stored.
  * @return Pointer to an array of ContactData structs matching the query, or NULL.
  */
 ContactData* search_contacts_py(const char* query, int search_type, int* num_found);
 
+/** Opaque compiled query, see compile_query_py. */
+typedef EngineQuery ContactQuery;
+
+/**
+ * @brief Compiles a boolean query such as `name contains Smith AND NOT email suffix ".org"`.
+ * Clauses are `field op value` with field name/phone/email and op contains/prefix/suffix/equals,
+ * combined with AND, OR, NOT and parentheses. Values match case-insensitively. Free the result
+ * with free_query_py.
+ * @param text The query text.
+ * @param error Buffer that receives a message on a syntax error (may be NULL).
+ * @param error_size Size of the error buffer.
+ * @return The compiled query, or NULL on error.
+ */
+ContactQuery* compile_query_py(const char* text, char* error, size_t error_size);
+
+/**
+ * @brief Runs a compiled query over the contact list, in list order.
+ * The caller is responsible for freeing the returned array using free_contact_data_array.
+ * @param query A query from compile_query_py.
+ * @param num_found Pointer to an integer where the number of matches will be stored.
+ * @return Pointer to an array of ContactData structs, or NULL if nothing matched.
+ */
+ContactData* run_query_py(const ContactQuery* query, int* num_found);
+
+/**
+ * @brief Frees a query returned by compile_query_py.
+ */
+void free_query_py(ContactQuery* query);
+
+/**
+ * @brief Deletes every contact a compiled query matches, in one pass over the list.
+ * @param query A query from compile_query_py.
+ * @return The number of contacts deleted.
+ */
+int delete_contacts_where_py(const ContactQuery* query);
+
+/**
+ * @brief Sets the name and/or phone of every contact a compiled query matches, in one pass.
+ * @param query A query from compile_query_py.
+ * @param new_name The new name, or NULL to keep each contact's name.
+ * @param new_phone The new phone number, or NULL to keep each contact's phone.
+ * @return The number of contacts updated (0 if both new values are NULL).
+ * -1 if new_name is invalid.
+ * -2 if new_phone is invalid.
+ * -4 if new_phone would be shared: more than one match, or another contact has it.
+ * -6 if memory allocation failed.
+ */
+int update_contacts_where_py(const ContactQuery* query, const char* new_name, const char* new_phone);
+
 /**
  * @brief Deletes a contact identified by its email address.
  * @param email The email of the contact to delete.
@@ -105,6 +178,17 @@ int delete_contact_by_email_py(const char* email);
  */
 int edit_contact_py(const char* old_email, const char* new_name, const char* new_phone, const char* new_email);
 
+/**
+ * @brief Edits the contact with this id; returns as edit_contact_py.
+ */
+int edit_contact_by_id_py(uint64_t id, const char* new_name, const char* new_phone, const char* new_email);
+
+/**
+ * @brief Deletes the contact with this id, in O(1).
+ * @return 1 if deleted, 0 if not found.
+ */
+int delete_contact_by_id_py(uint64_t id);
+
 /**
  * @brief Deletes all contacts from the list.
  */
@@ -116,10 +200,22 @@ void delete_all_contacts_py();
 void save_contacts_py();
 
 // Sorting functions
+// Stable sorts; names and emails order case-insensitively.
 void sort_contacts_by_name_py();
 void sort_contacts_by_phone_py();
 void sort_contacts_by_email_py();
 
+/**
+ * @brief Retrieves one page of the contacts in sorted order without sorting the list.
+ * The caller is responsible for freeing the returned array using free_contact_data_array.
+ * @param field 1 for name, 2 for phone, 3 for email.
+ * @param offset Index of the first row of the page in sorted order.
+ * @param limit Maximum number of rows to return.
+ * @param num_found Pointer to an integer where the number of returned rows will be stored.
+ * @return Pointer to an array of ContactData structs, or NULL if the page is empty.
+ */
+ContactData* get_sorted_page_py(int field, int offset, int limit, int* num_found);
+
 // Validation and checking functions (can be called from Python)
 int isvalidname(const char *name); //
 int isvalidnumber(const char *number); //
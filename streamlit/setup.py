@@ -1,21 +1,26 @@
 from setuptools import setup, Extension
 import pybind11
 import os
+import platform
 
 # Get the absolute path to the directory containing this setup.py file
 # This helps in locating source files correctly, especially in different build environments
 source_dir = os.path.abspath(os.path.dirname(__file__))
+engine_dir = os.path.join(source_dir, '..', 'engine')  # Shared storage engine
 
 contact_module = Extension(
     'contact_manager_c',  # Name of the module as imported in Python: import contact_manager_c
     sources=[
         os.path.join(source_dir, 'wrapper.cpp'),
         os.path.join(source_dir, 'contact.c')
-    ],
+    ] + [os.path.join(engine_dir, f) for f in
+         ('engine.c', 'engine_sort.c', 'engine_sound.c', 'engine_search.c', 'engine_view.c', 'engine_regex.c', 'engine_store.c', 'engine_array.c', 'engine_list.c')],
     include_dirs=[
         pybind11.get_include(),
-        source_dir  # To find contact.h
+        source_dir,  # To find contact.h
+        engine_dir   # To find engine.h
     ],
+    libraries=[] if platform.system() == 'Windows' else ['pthread'],  # The engine's sort pool
     language='c++',
     extra_compile_args=['-std=c++11'] # Or -std=c++14, -std=c++17 if needed by your compiler/pybind11 version
     # For Windows with MSVC, you might not need extra_compile_args explicitly for C++ standard,
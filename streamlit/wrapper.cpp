@@ -12,16 +12,21 @@ extern "C" {
 
 namespace py = pybind11;
 
+py::dict convert_c_contact_to_py_dict(const ContactData& contact) {
+    py::dict contact_dict;
+    contact_dict["id"] = contact.id;
+    contact_dict["name"] = std::string(contact.name);
+    contact_dict["phone"] = std::string(contact.phone);
+    contact_dict["email"] = std::string(contact.email);
+    return contact_dict;
+}
+
 // Helper function to convert C's ContactData array to a Python list of dictionaries
 py::list convert_c_array_to_py_list(ContactData* data_array, int num_items) {
     py::list py_list;
     if (data_array && num_items > 0) {
         for (int i = 0; i < num_items; ++i) {
-            py::dict contact_dict;
-            contact_dict["name"] = std::string(data_array[i].name);
-            contact_dict["phone"] = std::string(data_array[i].phone);
-            contact_dict["email"] = std::string(data_array[i].email);
-            py_list.append(contact_dict);
+            py_list.append(convert_c_contact_to_py_dict(data_array[i]));
         }
         // IMPORTANT: Free the memory allocated by the C functions
         free_contact_data_array(data_array);
@@ -29,6 +34,64 @@ py::list convert_c_array_to_py_list(ContactData* data_array, int num_items) {
     return py_list;
 }
 
+// Raise on the error codes of add_contact_py / add_contact_id_py
+void check_add_result(int result) {
+    if (result == 1) return;
+    else if (result == -1) throw std::runtime_error("Invalid name format.");
+    else if (result == -2) throw std::runtime_error("Invalid phone number format (must be 10 digits).");
+    else if (result == -3) throw std::runtime_error("Invalid email format (must end with .com).");
+    else if (result == -4) throw std::runtime_error("Phone number already exists.");
+    else if (result == -5) throw std::runtime_error("Email already exists.");
+    else if (result == -6) throw std::runtime_error("Memory allocation failed.");
+    else throw std::runtime_error("Unknown error adding contact.");
+}
+
+// Raise on the error codes of edit_contact_py / edit_contact_by_id_py
+void check_edit_result(int result, const char* not_found) {
+    if (result == 1) return;
+    else if (result == 0) throw std::runtime_error(not_found);
+    else if (result == -1) throw std::runtime_error("Invalid new name format.");
+    else if (result == -2) throw std::runtime_error("Invalid new phone number format.");
+    else if (result == -3) throw std::runtime_error("Invalid new email format.");
+    else if (result == -4) throw std::runtime_error("New phone number already exists for another contact.");
+    else if (result == -5) throw std::runtime_error("New email already exists for another contact.");
+    else throw std::runtime_error("Unknown error editing contact.");
+}
+
+// Owns a compiled query for the lifetime of the Python object
+class Query {
+public:
+    explicit Query(const std::string& text) {
+        char error[128];
+        query_ = compile_query_py(text.c_str(), error, sizeof(error));
+        if (!query_) throw py::value_error(error);
+    }
+    ~Query() { free_query_py(query_); }
+    Query(const Query&) = delete;
+    Query& operator=(const Query&) = delete;
+
+    py::list run() const {
+        int num_found = 0;
+        ContactData* results_c_array = run_query_py(query_, &num_found);
+        return convert_c_array_to_py_list(results_c_array, num_found);
+    }
+
+    int delete_matching() const { return delete_contacts_where_py(query_); }
+
+    int update_matching(const char* new_name, const char* new_phone) const {
+        int result = update_contacts_where_py(query_, new_name, new_phone);
+        if (result >= 0) return result;
+        else if (result == -1) throw std::runtime_error("Invalid new name format.");
+        else if (result == -2) throw std::runtime_error("Invalid new phone number format.");
+        else if (result == -4) throw std::runtime_error("New phone number would belong to more than one contact.");
+        else if (result == -6) throw std::runtime_error("Memory allocation failed.");
+        else throw std::runtime_error("Unknown error updating contacts.");
+    }
+
+private:
+    ContactQuery* query_;
+};
+
 PYBIND11_MODULE(contact_manager_c, m) {
     m.doc() = "Python bindings for the C contact management library";
 
@@ -36,19 +99,27 @@ PYBIND11_MODULE(contact_manager_c, m) {
 
     m.def("add_contact", 
           [](const char* name, const char* phone, const char* email) {
-              int result = add_contact_py(name, phone, email);
-              if (result == 1) return py::cast("Contact added successfully.");
-              else if (result == -1) throw std::runtime_error("Invalid name format.");
-              else if (result == -2) throw std::runtime_error("Invalid phone number format (must be 10 digits).");
-              else if (result == -3) throw std::runtime_error("Invalid email format (must end with .com).");
-              else if (result == -4) throw std::runtime_error("Phone number already exists.");
-              else if (result == -5) throw std::runtime_error("Email already exists.");
-              else if (result == -6) throw std::runtime_error("Memory allocation failed.");
-              else throw std::runtime_error("Unknown error adding contact.");
+              check_add_result(add_contact_py(name, phone, email));
+              return py::cast("Contact added successfully.");
           }, 
           "Adds a new contact",
           py::arg("name"), py::arg("phone"), py::arg("email"));
 
+    m.def("add_contact_id",
+          [](const char* name, const char* phone, const char* email) {
+              uint64_t id = 0;
+              check_add_result(add_contact_id_py(name, phone, email, &id));
+              return id;
+          },
+          "Adds a new contact and returns its id, which stays valid across sorts and other edits",
+          py::arg("name"), py::arg("phone"), py::arg("email"));
+
+    m.def("get_contact_by_id", [](uint64_t id) -> py::object {
+        ContactData contact;
+        if (!get_contact_by_id_py(id, &contact)) return py::none();
+        return convert_c_contact_to_py_dict(contact);
+    }, "Returns the contact with this id as a dictionary, or None", py::arg("id"));
+
     m.def("get_contact_count", &get_contacts_count_py, "Gets the total number of contacts");
 
     m.def("get_all_contacts", []() {
@@ -61,9 +132,32 @@ PYBIND11_MODULE(contact_manager_c, m) {
         int num_found = 0;
         ContactData* results_c_array = search_contacts_py(query, search_type, &num_found);
         return convert_c_array_to_py_list(results_c_array, num_found);
-    }, "Searches contacts. search_type: 1 for name, 2 for phone, 3 for email.",
+    }, "Searches contacts. search_type: 1 for name, 2 for phone, 3 for email, 4 for names that sound like the query.",
         py::arg("query"), py::arg("search_type"));
 
+    py::class_<Query>(m, "Query", "A boolean query compiled once, e.g. Query('name contains Smith AND NOT email suffix \".org\"')")
+        .def(py::init<const std::string&>(), py::arg("text"))
+        .def("run", &Query::run, "Returns the matching contacts as a list of dictionaries")
+        .def("delete_matching", &Query::delete_matching, "Deletes every matching contact in one pass; returns how many")
+        .def("update_matching", &Query::update_matching,
+             "Sets name and/or phone (None keeps it) on every matching contact in one pass; returns how many",
+             py::arg("new_name") = py::none(), py::arg("new_phone") = py::none());
+
+    m.def("search_query", [](const std::string& text) {
+        return Query(text).run();
+    }, "Compiles and runs a boolean query. Raises ValueError on a syntax error.",
+        py::arg("text"));
+
+    m.def("delete_contacts_where", [](const std::string& text) {
+        return Query(text).delete_matching();
+    }, "Deletes every contact matching a boolean query; returns how many. Does not save automatically.",
+        py::arg("text"));
+
+    m.def("update_contacts_where", [](const std::string& text, const char* new_name, const char* new_phone) {
+        return Query(text).update_matching(new_name, new_phone);
+    }, "Sets name and/or phone (None keeps it) on every contact matching a boolean query; returns how many.",
+        py::arg("text"), py::arg("new_name") = py::none(), py::arg("new_phone") = py::none());
+
     m.def("delete_contact_by_email", 
         [](const char* email) {
             int result = delete_contact_by_email_py(email);
@@ -75,18 +169,23 @@ PYBIND11_MODULE(contact_manager_c, m) {
 
     m.def("edit_contact", 
         [](const char* old_email, const char* new_name, const char* new_phone, const char* new_email) {
-            int result = edit_contact_py(old_email, new_name, new_phone, new_email);
-            if (result == 1) return py::cast("Contact updated successfully.");
-            else if (result == 0) throw std::runtime_error("Contact with original email not found.");
-            else if (result == -1) throw std::runtime_error("Invalid new name format.");
-            else if (result == -2) throw std::runtime_error("Invalid new phone number format.");
-            else if (result == -3) throw std::runtime_error("Invalid new email format.");
-            else if (result == -4) throw std::runtime_error("New phone number already exists for another contact.");
-            else if (result == -5) throw std::runtime_error("New email already exists for another contact.");
-            else throw std::runtime_error("Unknown error editing contact.");
+            check_edit_result(edit_contact_py(old_email, new_name, new_phone, new_email), "Contact with original email not found.");
+            return py::cast("Contact updated successfully.");
         }, 
         "Edits an existing contact identified by old_email",
         py::arg("old_email"), py::arg("new_name"), py::arg("new_phone"), py::arg("new_email"));
+
+    m.def("edit_contact_by_id",
+        [](uint64_t id, const char* new_name, const char* new_phone, const char* new_email) {
+            check_edit_result(edit_contact_by_id_py(id, new_name, new_phone, new_email), "Contact with this id not found.");
+            return py::cast("Contact updated successfully.");
+        },
+        "Edits the contact with this id",
+        py::arg("id"), py::arg("new_name"), py::arg("new_phone"), py::arg("new_email"));
+
+    m.def("delete_contact_by_id", [](uint64_t id) { return delete_contact_by_id_py(id) == 1; },
+        "Deletes the contact with this id. Returns true if deleted, false if not found.",
+        py::arg("id"));
     
     m.def("delete_all_contacts", &delete_all_contacts_py, "Deletes all contacts from memory. Does not save automatically.");
     m.def("save_contacts", &save_contacts_py, "Saves all contacts to contacts.csv");
@@ -96,6 +195,13 @@ PYBIND11_MODULE(contact_manager_c, m) {
     m.def("sort_contacts_by_phone", &sort_contacts_by_phone_py, "Sorts contacts by phone number");
     m.def("sort_contacts_by_email", &sort_contacts_by_email_py, "Sorts contacts by email");
 
+    m.def("get_sorted_page", [](int field, int offset, int limit) {
+        int num_found = 0;
+        ContactData* page_c_array = get_sorted_page_py(field, offset, limit, &num_found);
+        return convert_c_array_to_py_list(page_c_array, num_found);
+    }, "Retrieves rows [offset, offset+limit) in sorted order without sorting. field: 1 for name, 2 for phone, 3 for email.",
+        py::arg("field"), py::arg("offset"), py::arg("limit"));
+
     // Validation and utility functions
     m.def("is_valid_name", [](const char* name) {
         return isvalidname(name) == 1; // [cite: 1]
@@ -0,0 +1,100 @@
+# menu_session.py
+# Drives a donna CLI's menus through stdin, the way an operator session would.
+#
+#   python3 menu_session.py DONNA VERSION [ACTIONS]
+#
+# 1. Long session: ACTIONS (default 1,000,000) random menu actions covering
+#    add, edit, display, search, sort, delete and invalid input, then Exit
+#    without saving. Runs under a 1 MB stack limit, so a handler that recursed
+#    back into the menu would crash. Passes if donna exits 0, every scripted
+#    add/delete cycle reports its delete, and contacts.csv is unchanged.
+# 2. End of input: for every action, donna is fed the action cut after each
+#    of its lines. Passes if every run exits within a few seconds instead of
+#    re-prompting forever.
+#
+# Each run gets a scratch copy of the version's sample contacts.csv.
+import os, random, resource, shutil, subprocess, sys, tempfile, time
+
+STACK_LIMIT = 1 << 20
+EOF_TIMEOUT = 5
+
+# Actions from the main menu back to it. The last one adds a contact and
+# deletes it again; DELETED is what donna prints for that delete.
+ACTIONS = {
+    '1': ["3\n\n\n", "4\n1\nJohn\n\n0\n", "4\n2\n555\n\n3\nexample\n\n0\n", "7\n2\n\n\n\n", "8\n\n", "x\n\n",
+          "5\n0\n", "6\nn\n\n", "2\n0\n", "1\n0\n", "2\n1\nNobody\n0\n",
+          "1\n1\nZed Test\n5550001111\nzed@test.com\n\n5\nZed Test\n\n"],
+    '2': ["3\n\n", "4\n1\nJohn\n\n", "4\n9\n\n3\nexample\n\n", "7\n2\n\n", "7\n5\n\n0\n", "8\n\n", "x\n\n",
+          "5\n0\n", "2\n0\n", "1\n0\n", "2\n1\nNobody\n\n",
+          "1\n1\nZed Test\n5550001111\nzed@test.com\n\n5\n3\nzed@test.com\n\n"],
+}
+DELETED = {'1': b"Contact Deleted Successfully!", '2': b"Contact deleted successfully!"}
+EXIT = "0\nn\n"
+
+
+def limit_stack():
+    resource.setrlimit(resource.RLIMIT_STACK, (STACK_LIMIT, STACK_LIMIT))
+
+
+def run(donna, csv, script, timeout=None, preexec=None):
+    """Runs donna on script in a scratch directory. Returns (exit code or None on timeout, stdout, csv after)."""
+    with tempfile.TemporaryDirectory() as d:
+        shutil.copy(csv, os.path.join(d, "contacts.csv"))
+        try:
+            r = subprocess.run([donna], input=script.encode(), cwd=d, capture_output=True,
+                               timeout=timeout, preexec_fn=preexec)
+            code, out = r.returncode, r.stdout
+        except subprocess.TimeoutExpired:
+            code, out = None, b""
+        with open(os.path.join(d, "contacts.csv"), "rb") as f:
+            return code, out, f.read()
+
+
+def long_session(donna, v, csv, n):
+    rng = random.Random(7)
+    acts = ACTIONS[v]
+    picks = [rng.choice(acts) for _ in range(n)]
+    cycles = sum(a is acts[-1] for a in picks)
+    script = "\n" + "".join(picks) + EXIT # The leading line answers the intro screen's pause
+
+    start = time.time()
+    code, out, after = run(donna, csv, script, preexec=limit_stack)
+    secs = time.time() - start
+    with open(csv, "rb") as f:
+        unchanged = f.read() == after
+    deleted = out.count(DELETED[v])
+    ok = code == 0 and deleted == cycles and unchanged
+    print(f"v{v} {n} actions: {secs:.1f} s, exit {code}, {deleted}/{cycles} add/delete cycles, "
+          f"contacts.csv {'unchanged' if unchanged else 'CHANGED'}")
+    return ok
+
+
+def eof_sessions(donna, v, csv):
+    failures = 0
+    runs = 0
+    for act in ACTIONS[v]:
+        lines = act.splitlines(keepends=True)
+        for cut in range(1, len(lines) + 1):
+            script = "\n" + "".join(lines[:cut])
+            code, _, _ = run(donna, csv, script, timeout=EOF_TIMEOUT)
+            runs += 1
+            if code is None:
+                failures += 1
+                print(f"v{v}: still running {EOF_TIMEOUT} s after input ended: {script!r}")
+    print(f"v{v} end of input: {runs - failures}/{runs} truncated sessions ended")
+    return failures == 0
+
+
+def main():
+    if len(sys.argv) < 3 or sys.argv[2] not in ACTIONS:
+        sys.exit("usage: menu_session.py DONNA VERSION(1|2) [ACTIONS]")
+    donna, v = os.path.abspath(sys.argv[1]), sys.argv[2]
+    n = int(sys.argv[3]) if len(sys.argv) > 3 else 1000000
+    csv = os.path.join(os.path.dirname(donna), "contacts.csv")
+    ok = long_session(donna, v, csv, n)
+    ok = eof_sessions(donna, v, csv) and ok
+    sys.exit(0 if ok else 1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,255 @@
+// sort_order.c
+// Checks that the engine's sorts give the order the original sort did. The
+// CLIs used to bubble sort the contact array, swapping neighbours whose field
+// compared greater with strcmp, which is stable: equal fields keep their input
+// order. Every sort the front ends now call is compared against that bubble
+// sort on the same records:
+//   - engine_sort_strings() on 1..8 threads (the MSD radix sort, the pool, and
+//     the packed radix path when the field is mostly 10-digit phones),
+//   - engine_sort_list() on a linked list of nodes,
+//   - engine_sort_page() on pages at the start, middle and end,
+//   - engine_store_sort() on the array and list backends.
+// The sorted views order equal fields by record id instead, so they are
+// checked against the same bubble sort run on the records in id order, as is
+// engine_sort_strings() fed in engine_sort_ids() order, which the front ends
+// use to give a fresh sort that order too.
+// The records mix upper and lower case, repeat fields (ties), share prefixes
+// longer than the 8 bytes a sort key caches, and include empty fields and
+// phones that are not 10 digits.
+//
+//   sort_order [SEED]
+//
+// Prints one line per failure and exits 1 if there were any, else prints "ok".
+#include "engine.h"
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_THREADS 8
+
+typedef struct Node {
+    EngineRecord rec;
+    struct Node *next;
+} Node;
+
+typedef struct ViewNode {
+    EngineViewNode node; // First, so the engine's node pointers cast to ViewNode
+    const char *key;
+    int pos;             // Input position
+} ViewNode;
+
+static const int sizes[] = { 0, 1, 2, 3, 17, 100, 1000, 5000 };
+static int failures = 0;
+
+static void fail(const char *what, int field, int n, int threads) {
+    printf("FAIL %s: field %d, %d records, %d threads\n", what, field, n, threads);
+    failures++;
+}
+
+// --- Records ---
+static const char *const name_parts[] = { "john", "John", "JOHN", "jo", "Ann", "ann", "Alexander", "alexander", "Z", "" };
+static const char *const name_last[] = { "", " smith", " Smith", " smithson", " SMITH" };
+static const char *const email_users[] = { "john.smith", "John.Smith", "john.smithson", "ann", "Ann", "a", "zed" };
+static const char *const email_hosts[] = { "@example.com", "@Example.com", "@ex.com", "@example.co" };
+static const char *const odd_phones[] = { "", "555", "55501234567", "555-012-34", "ABCDEFGHIJ" };
+
+static const char *pick(const char *const *list, size_t count) {
+    return list[rand() % count];
+}
+
+#define PICK(list) pick(list, sizeof(list) / sizeof(list[0]))
+
+// Mostly 10-digit phones from a small range, so many repeat. One record in
+// odd_every gets a phone that is not 10 digits (none when odd_every is 0).
+static void make_records(EngineRecord *recs, int n, int odd_every) {
+    for (int i = 0; i < n; i++) {
+        snprintf(recs[i].name, ENGINE_FIELD_BYTES, "%s%s", PICK(name_parts), PICK(name_last));
+        if (odd_every && rand() % odd_every == 0) snprintf(recs[i].phone, ENGINE_FIELD_BYTES, "%s", PICK(odd_phones));
+        else snprintf(recs[i].phone, ENGINE_FIELD_BYTES, "55500%05d", rand() % 200);
+        snprintf(recs[i].email, ENGINE_FIELD_BYTES, "%s%s", PICK(email_users), PICK(email_hosts));
+    }
+}
+
+// The original sort: bubble sort on strcmp, swapping only strictly greater
+// neighbours. order[i] is the input position of the record sorted to i.
+static void bubble_sort(const EngineRecord *recs, int n, int field, int *order) {
+    for (int i = 0; i < n; i++) order[i] = i;
+    for (int i = 0; i < n - 1; i++) {
+        for (int j = 0; j < n - i - 1; j++) {
+            if (strcmp(engine_field(&recs[order[j]], field), engine_field(&recs[order[j + 1]], field)) > 0) {
+                int t = order[j];
+                order[j] = order[j + 1];
+                order[j + 1] = t;
+            }
+        }
+    }
+}
+
+// --- Checks ---
+static void check_strings(const EngineRecord *recs, int n, int field, const int *order) {
+    const char **strs = malloc((n + 1) * sizeof(const char *));
+    EngineKey *keys = malloc((n + 1) * sizeof(EngineKey));
+    EngineKey *tmp = malloc((n + 1) * sizeof(EngineKey));
+    if (!strs || !keys || !tmp) { fail("out of memory", field, n, 0); goto done; }
+    for (int i = 0; i < n; i++) strs[i] = engine_field(&recs[i], field);
+
+    for (int threads = 1; threads <= MAX_THREADS; threads++) {
+        EngineKey *sorted = engine_sort_strings(keys, tmp, strs, n, threads);
+        for (int i = 0; i < n; i++) {
+            if (sorted[i].idx != order[i]) { fail("engine_sort_strings", field, n, threads); break; }
+        }
+    }
+
+    if (n > 0) {
+        int offsets[] = { 0, n / 2, n - 1 };
+        for (int k = 0; k < 3; k++) {
+            int offset = offsets[k], limit = n - offset < 25 ? n - offset : 25;
+            engine_sort_page(keys, strs, n, offset, limit);
+            for (int i = offset; i < offset + limit; i++) {
+                if (keys[i].idx != order[i]) { fail("engine_sort_page", field, n, 1); break; }
+            }
+        }
+    }
+done:
+    free(strs);
+    free(keys);
+    free(tmp);
+}
+
+static void check_list(const EngineRecord *recs, int n, int field, const int *order) {
+    static const size_t field_offs[] = {
+        offsetof(Node, rec.name), offsetof(Node, rec.phone), offsetof(Node, rec.email)
+    };
+    Node *nodes = malloc((n + 1) * sizeof(Node));
+    if (!nodes) { fail("out of memory", field, n, 0); return; }
+    for (int i = 0; i < n; i++) {
+        nodes[i].rec = recs[i];
+        nodes[i].next = i + 1 < n ? &nodes[i + 1] : NULL;
+    }
+
+    for (int threads = 1; threads <= MAX_THREADS; threads *= 2) {
+        Node *head = engine_sort_list(n ? &nodes[0] : NULL, n, offsetof(Node, next), field_offs[field - 1], threads);
+        int i = 0;
+        for (Node *p = head; p; p = p->next, i++) {
+            if (i >= n || p != &nodes[order[i]]) break;
+        }
+        if (i != n) fail("engine_sort_list", field, n, threads);
+        for (int j = 0; j < n; j++) nodes[j].next = j + 1 < n ? &nodes[j + 1] : NULL; // Back to input order
+    }
+    free(nodes);
+}
+
+static void check_store(const EngineBackend *backend, const EngineRecord *recs, int n, int field, const int *order) {
+    EngineStore st;
+    if (engine_store_open(&st, backend) != 0) { fail("out of memory", field, n, 0); return; }
+    for (int i = 0; i < n; i++) {
+        if (st.backend->append(st.impl, &recs[i]) != 0) { fail("out of memory", field, n, 0); goto done; }
+    }
+    if (engine_store_sort(&st, field) != 0) { fail(backend->name, field, n, 1); goto done; }
+
+    int i = 0;
+    for (EngineRecord *r = st.backend->first(st.impl); r; r = st.backend->next(st.impl, r), i++) {
+        if (i >= n || memcmp(r, &recs[order[i]], sizeof(EngineRecord)) != 0) break;
+    }
+    if (i != n) fail(backend->name, field, n, 1);
+done:
+    engine_store_close(&st);
+}
+
+static const char *view_node_key(const EngineView *v, const EngineViewNode *x) {
+    (void)v;
+    return ((const ViewNode *)x)->key;
+}
+
+// Gives the records shuffled ids, inserts them into a view in input order and
+// checks the view, and the string sort fed in id order, against (field, id).
+static void check_ids(const EngineRecord *recs, int n, int field) {
+    uint64_t *ids = malloc((n + 1) * sizeof(uint64_t));
+    int *by_id = malloc((n + 1) * sizeof(int)), *order = malloc((n + 1) * sizeof(int));
+    EngineRecord *in_id_order = malloc((n + 1) * sizeof(EngineRecord));
+    ViewNode *nodes = malloc((n + 1) * sizeof(ViewNode));
+    const char **strs = malloc((n + 1) * sizeof(const char *));
+    EngineKey *keys = malloc((n + 1) * sizeof(EngineKey)), *tmp = malloc((n + 1) * sizeof(EngineKey));
+    EngineView view = { NULL, 0, 0, view_node_key };
+    if (!ids || !by_id || !order || !in_id_order || !nodes || !strs || !keys || !tmp) {
+        fail("out of memory", field, n, 0);
+        goto done;
+    }
+
+    for (int i = 0; i < n; i++) by_id[i] = i;
+    for (int i = n - 1; i > 0; i--) {
+        int j = rand() % (i + 1), t = by_id[i];
+        by_id[i] = by_id[j];
+        by_id[j] = t;
+    }
+    for (int k = 0; k < n; k++) ids[by_id[k]] = (uint64_t)k * 7 + 1; // Record by_id[k] has the k-th smallest id
+    for (int k = 0; k < n; k++) in_id_order[k] = recs[by_id[k]];
+    bubble_sort(in_id_order, n, field, order);
+    for (int i = 0; i < n; i++) order[i] = by_id[order[i]]; // Back to input positions
+
+    if (engine_view_build(&view, NULL, 0) != 0) { fail("out of memory", field, n, 0); goto done; }
+    for (int i = 0; i < n; i++) {
+        nodes[i].key = engine_field(&recs[i], field);
+        nodes[i].pos = i;
+        nodes[i].node.id = ids[i];
+        engine_view_insert(&view, &nodes[i].node);
+    }
+    int i = 0;
+    for (EngineViewNode *t = engine_view_first(&view); t; t = engine_view_next(t), i++) {
+        if (i >= n || ((ViewNode *)t)->pos != order[i]) break;
+    }
+    if (i != n) fail("engine_view_insert", field, n, 1);
+
+    for (int j = 0; j < n; j++) {
+        keys[j].key = ids[j];
+        keys[j].idx = j;
+    }
+    EngineKey *sorted_ids = engine_sort_ids(keys, tmp, n);
+    for (int j = 0; j < n; j++) by_id[j] = sorted_ids[j].idx;
+    for (int j = 0; j < n; j++) strs[j] = engine_field(&recs[by_id[j]], field);
+    EngineKey *sorted = engine_sort_strings(keys, tmp, strs, n, 1);
+    for (int j = 0; j < n; j++) {
+        if (by_id[sorted[j].idx] != order[j]) { fail("engine_sort_ids", field, n, 1); break; }
+    }
+done:
+    free(ids);
+    free(by_id);
+    free(order);
+    free(in_id_order);
+    free(nodes);
+    free(strs);
+    free(keys);
+    free(tmp);
+}
+
+int main(int argc, char *argv[]) {
+    srand(argc > 1 ? (unsigned)atoi(argv[1]) : 1);
+    int odd_every[] = { 0, 200, 3 }; // No odd phones, a few (packed path), many (string path)
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        for (int o = 0; o < 3; o++) {
+            int n = sizes[s];
+            EngineRecord *recs = malloc((n + 1) * sizeof(EngineRecord));
+            int *order = malloc((n + 1) * sizeof(int));
+            if (!recs || !order) { fail("out of memory", 0, n, 0); free(recs); free(order); continue; }
+            make_records(recs, n, odd_every[o]);
+
+            for (int field = ENGINE_FIELD_NAME; field <= ENGINE_FIELD_EMAIL; field++) {
+                bubble_sort(recs, n, field, order);
+                check_strings(recs, n, field, order);
+                check_list(recs, n, field, order);
+                check_store(&engine_array_backend, recs, n, field, order);
+                check_store(&engine_list_backend, recs, n, field, order);
+                check_ids(recs, n, field);
+            }
+            free(recs);
+            free(order);
+        }
+    }
+
+    if (failures) return 1;
+    printf("ok\n");
+    return 0;
+}
@@ -1,18 +1,21 @@
-#include "contact.h"
+#include "contact1.h"
+#include "engine.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <ctype.h>
 
-typedef struct Record
-{
-    char name[50];
-    char phone[50];
-    char email[50];
-} Details;
+typedef EngineRecord Details; // name, phone, email of 50 bytes each
 
 Details *contacts;
 int count = 0;
-int x = 0;
+int capacity = 0; // Records allocated in contacts[]
+int sortedBy = 0; // Field contacts[] is currently ordered by: 0 none, 1 name, 2 phone, 3 email
+uint64_t *deadSlots = NULL; // Bit i set once contacts[i] is deleted; bits past deadWords read as live
+int deadWords = 0;
+int deleted = 0; // Deleted slots among contacts[0, count)
 int choice;
 FILE *pF = NULL;
 
@@ -22,11 +25,16 @@ FILE *pF = NULL;
  * What: Clears the terminal screen and flushes stdin.
  * Args: none
  * Returns: void
- * Logic: Calls system("clear") then fflush(stdin) to drop any unread input.
+ * Logic: Calls system("clear") when stdout is a terminal (a scripted session
+ *        would fork a shell per screen for nothing), then fflush(stdin) to
+ *        drop any unread input.
  */
 void clearBuffer()
 {
-    system("clear"); // clears the output screen
+    if (isatty(STDOUT_FILENO))
+    {
+        system("clear"); // clears the output screen
+    }
     fflush(stdin);   // clears the input buffers like '\n'
 }
 
@@ -46,6 +54,29 @@ void clearInputBuffer()
     }
 }
 
+/**
+ * readLine
+ * ------------------
+ * What: Reads one line of input without its newline.
+ * Args:
+ *   char buf[] – receives the line
+ *   int size   – size of buf
+ * Returns:
+ *   int – 1 if a line was read, 0 once input has ended
+ * Logic: fgets(), then cuts the '\n'. Prompts that retry on bad input
+ *        check it, so a session piped from a file ends at EOF instead of
+ *        prompting forever.
+ */
+int readLine(char buf[], int size)
+{
+    if (!fgets(buf, size, stdin))
+    {
+        return 0;
+    }
+    buf[strcspn(buf, "\n")] = 0;
+    return 1;
+}
+
 /**
  * my_pause
  * ------------------
@@ -59,70 +90,75 @@ void my_pause(){
     getchar();
 }
 
+/**
+ * menuActions
+ * ------------------
+ * Handler for each main menu choice, indexed by the number typed (NULL: no
+ * such choice). Every handler returns to loginPage() when it is done.
+ */
+void (*const menuActions[])() = {
+    Exit,                  // 0
+    addcontact,            // 1
+    editcontact,           // 2
+    displaycontacts,       // 3
+    searchcontact,         // 4
+    deletecontact,         // 5
+    Deleteall,             // 6
+    displaySortedContacts, // 7
+    NULL,                  // 8
+    save,                  // 9
+};
+
 /**
  * loginPage
  * ------------------
- * What: Displays the main menu and dispatches to the chosen action.
+ * What: Runs the main menu until input ends.
  * Args: none
  * Returns: void
- * Logic: Prints menu options, reads global 'choice', then calls matching handler.
+ * Logic: Loops: prints menu options, reads global 'choice', then calls the
+ *        matching handler from menuActions[]. Handlers return here instead of
+ *        calling loginPage() again, so the stack stays flat however long the
+ *        session runs. Exit() leaves through endScreen().
  */
 void loginPage()
 {
-    clearBuffer();
+    while (1)
+    {
+        clearBuffer();
 
-    printf("\n\t\t\t\t------------------------------------------- \n");
-    printf("\t\t\t\t\t     >>> Donna <<< \n");
-    printf("\t\t\t\t------------------------------------------- \n\n");
-    printf("\t\t\t\t\t[1] Add A New Contact. \n");
-    printf("\t\t\t\t\t[2] Update A Contact. \n");
-    printf("\t\t\t\t\t[3] Display All Contacts. \n");
-    printf("\t\t\t\t\t[4] Search Contact. \n");
-    printf("\t\t\t\t\t[5] Delete Contact. \n");
-    printf("\t\t\t\t\t[6] Delete All Contacts. \n");
-    printf("\t\t\t\t\t[7] Display Sorted Contacts. \n");
-    printf("\t\t\t\t\t[0] EXIT. \n");
-    printf("\t\t\t\t\t[9] SAVE. \n");
-    printf("\t\t\t\t   ------------------------------------ \n\n");
-    printf("\t\t\t\tEnter the number & Hit ENTER: ");
-    scanf("%d", &choice);
-    clearInputBuffer();
+        printf("\n\t\t\t\t------------------------------------------- \n");
+        printf("\t\t\t\t\t     >>> Donna <<< \n");
+        printf("\t\t\t\t------------------------------------------- \n\n");
+        printf("\t\t\t\t\t[1] Add A New Contact. \n");
+        printf("\t\t\t\t\t[2] Update A Contact. \n");
+        printf("\t\t\t\t\t[3] Display All Contacts. \n");
+        printf("\t\t\t\t\t[4] Search Contact. \n");
+        printf("\t\t\t\t\t[5] Delete Contact. \n");
+        printf("\t\t\t\t\t[6] Delete All Contacts. \n");
+        printf("\t\t\t\t\t[7] Display Sorted Contacts. \n");
+        printf("\t\t\t\t\t[0] EXIT. \n");
+        printf("\t\t\t\t\t[9] SAVE. \n");
+        printf("\t\t\t\t   ------------------------------------ \n\n");
+        printf("\t\t\t\tEnter the number & Hit ENTER: ");
+        int read = scanf("%d", &choice);
+        if (read == EOF)
+        {
+            return;
+        }
+        clearInputBuffer();
 
-    switch (choice)
-    {
-    case 1:
-        addcontact();
-        break;
-    case 2:
-        editcontact();
-        break;
-    case 3:
-        displaycontacts();
-        break;
-    case 4:
-        searchcontact();
-        break;
-    case 5:
-        deletecontact();
-        break;
-    case 6:
-        Deleteall();
-        break;
-    case 7:
-        displaySortedContacts();
-        break;
-    case 0:
-        Exit();
-        break;
-    case 9:
-        save();
-        break;
-    default:
-        printf("---------------------------------------\n");
-        printf("ERROR: Invalid input please try again. \n");
-        printf("---------------------------------------\n");
-        my_pause();
-        loginPage();
+        int actions = sizeof(menuActions) / sizeof(menuActions[0]);
+        if (read == 1 && choice >= 0 && choice < actions && menuActions[choice] != NULL)
+        {
+            menuActions[choice]();
+        }
+        else
+        {
+            printf("---------------------------------------\n");
+            printf("ERROR: Invalid input please try again. \n");
+            printf("---------------------------------------\n");
+            my_pause();
+        }
     }
 }
 
@@ -132,7 +168,7 @@ void loginPage()
  * What: Shows the introduction banner for the app.
  * Args: none
  * Returns: void
- * Logic: Prints description text, pauses, then calls loginPage().
+ * Logic: Prints description text, then pauses.
  */
 void infoscreen()
 {
@@ -144,7 +180,6 @@ void infoscreen()
     printf("\t\t\t\t------------------------------------ \n");
     printf("\t\t\t\t------------------------------------ \n\n");
     my_pause();
-    loginPage();
 }
 
 /**
@@ -178,26 +213,11 @@ void endScreen()
  *   char name[] – the input string
  * Returns:
  *   int – 1 if valid, 0 otherwise
- * Logic: Loops through 'name', rejects on first non-letter, non-space.
+ * Logic: engine_valid_name(), shared with every other front end.
  */
 int isvalidname(char name[])
 {
-    int x = 0;
-    for (int i = 0; name[i] != '\0'; i++)
-    {
-        if ((name[i] >= 'a' && name[i] <= 'z') ||
-            (name[i] >= 'A' && name[i] <= 'Z') ||
-            (name[i] == ' '))
-        {
-            x = 1;
-        }
-        else
-        {
-            x = 0;
-            break;
-        }
-    }
-    return x;
+    return engine_valid_name(name);
 }
 
 /**
@@ -208,63 +228,84 @@ int isvalidname(char name[])
  *   char number[] – input phone string
  * Returns:
  *   int – 2 if valid, 0 otherwise
- * Logic: Checks length == 10, then each char is digit.
+ * Logic: engine_valid_phone().
  */
 int isvalidnumber(char number[])
 {
-    int length = strlen(number);
-
-    if (length != 10)
-    {
-        return 0; // Not 10 digits
-    }
-
-    for (int i = 0; i < length; i++)
-    {
-        if (number[i] < '0' || number[i] > '9')
-        {
-            return 0; // Non-digit found
-        }
-    }
-
-    return 2; // All digits and length is 10
+    return engine_valid_phone(number) ? 2 : 0;
 }
 
 /**
  * isvalidemail
  * ------------------
- * What: Validates basic email format ending in ".com".
+ * What: Validates an email address ending in ".com".
  * Args:
  *   char email[] – input email string
  * Returns:
- *   int – 2 if fully valid, 1 if partial, 0 if invalid
- * Logic: Scans for '@' and '.', counts punctuation, checks ".com" suffix.
+ *   int – 2 if valid, 0 otherwise
+ * Logic: engine_valid_email() with ENGINE_EMAIL_DOTCOM: one '@' not first,
+ *        a dotted domain after it, no spaces, and a ".com" ending.
  */
 int isvalidemail(char email[])
 {
-    int x = 0;
-    int spl = 0;
-    for (int i = 0; email[i] != '\0'; i++)
+    return engine_valid_email(email, ENGINE_EMAIL_DOTCOM) ? 2 : 0;
+}
+
+/**
+ * reserveContacts
+ * ------------------
+ * What: Makes room in contacts[] for at least 'need' records.
+ * Args:
+ *   int need – records the array must hold
+ * Returns:
+ *   int – 1 on success, 0 if memory is short (contacts[] is unchanged)
+ * Logic: One realloc() to engine_grow_capacity(): twice the capacity
+ *        (ENGINE_CAPACITY_MIN to start), or exactly 'need' when that is
+ *        more. Doubling keeps n single appends at O(n) copying in total; a
+ *        bulk load asks for its whole size at once and gets an exact fit.
+ */
+int reserveContacts(int need)
+{
+    if (need <= capacity)
     {
-        if (email[i] == '@' && email[i + 1] != '\0' && email[i + 1] != '.' && i != 0 && email[i - 1] != '.')
-        {
-            x = 1;
-        }
-        if (email[i] == '@' || email[i] == '.')
-        {
-            spl++;
-        }
-        if (email[i] == '.' && email[i + 1] == 'c' && email[i + 2] == 'o' && email[i + 3] == 'm' && email[i + 4] == '\0')
-        {
-            x = 2;
-        }
+        return 1;
     }
-    if (spl != 2)
+    int cap = engine_grow_capacity(capacity, need);
+    Details *grown = (Details *)realloc(contacts, (size_t)cap * sizeof(Details));
+    if (grown == NULL)
     {
-        x = 1;
+        return 0;
     }
+    contacts = grown;
+    capacity = cap;
+    return 1;
+}
 
-    return x;
+/**
+ * shrinkContacts
+ * ------------------
+ * What: Gives memory back once most of contacts[] is unused.
+ * Args: none
+ * Returns: void
+ * Logic: engine_shrink_capacity() asks for twice count once count has
+ *        fallen to a quarter of capacity. The array is then half full, so
+ *        the next grow or shrink is at least count/2 appends or deletes away
+ *        and both stay O(1) amortized. Call it with no deleted slots
+ *        pending; a failed realloc() just keeps the larger block.
+ */
+void shrinkContacts()
+{
+    int cap = engine_shrink_capacity(capacity, count);
+    if (cap == capacity)
+    {
+        return;
+    }
+    Details *smaller = (Details *)realloc(contacts, (size_t)cap * sizeof(Details));
+    if (smaller != NULL)
+    {
+        contacts = smaller;
+        capacity = cap;
+    }
 }
 
 /**
@@ -273,34 +314,45 @@ int isvalidemail(char email[])
  * What: Adds one or more new contacts to the dynamic array.
  * Args: none
  * Returns: void
- * Logic: Reallocates if needed, loops per new contact, validates and appends.
+ * Logic: Loops per new contact, making room with reserveContacts() before
+ *        each one, validates and appends. If contacts[] is sorted,
+ *        placeSorted() then moves each one into place.
  */
 void addcontact()
 {
     clearBuffer();
-
-    if (count < x)
+    if (sortedBy != 0)
     {
-        contacts = (Details *)realloc(contacts, 2 * count * sizeof(Details));
+        compactContacts(); // placeSorted() below shifts over live records only
     }
     printf("\t\t|---------------------------------------------------------------| \n");
     printf("\t\t\t\t     >>> Add Contacts <<< \n");
     printf("\t\t|---------------------------------------------------------------| \n");
 
-    int no_of_contacts;
+    int no_of_contacts = 0;
 
     printf("\n\t\t\t   (Enter 0 to go back to the main menu)\n");
     printf("\n\t\t Enter the number of contacts to add - ");
-    scanf("%d", &no_of_contacts);
+    if (scanf("%d", &no_of_contacts) == EOF)
+    {
+        return;
+    }
     getchar();
 
     if (no_of_contacts == 0)
     {
-        loginPage();
+        return;
     }
 
+    int start = count;
     for (int i = 0; i < no_of_contacts; i++)
     {
+        if (!reserveContacts(count + 1))
+        {
+            printf("\n\t\tMemory allocation failed!\n");
+            my_pause();
+            break;
+        }
         clearBuffer();
 
         printf("\t|---------------------------------------------------------------| \n");
@@ -309,8 +361,10 @@ void addcontact()
         char data[50];
     jump1:
         printf("\t\t\t Enter Name = ");
-        fgets(data, sizeof(data), stdin);
-        data[strcspn(data, "\n")] = 0;
+        if (!readLine(data, sizeof(data)))
+        {
+            break; // Input ended: keep the contacts completed so far
+        }
         if (checkname(data) == 0)
         {
             if (isvalidname(data))
@@ -332,8 +386,10 @@ void addcontact()
 
     jump5:
         printf("\t\t\t Enter Phone = ");
-        fgets(data, sizeof(data), stdin);
-        data[strcspn(data, "\n")] = 0;
+        if (!readLine(data, sizeof(data)))
+        {
+            break; // Input ended: keep the contacts completed so far
+        }
         if (checkphone(data) == 0)
         {
             if (isvalidnumber(data) == 2)
@@ -355,8 +411,10 @@ void addcontact()
 
     jump8:
         printf("\t\t\t Enter Email = ");
-        fgets(data, sizeof(data), stdin);
-        data[strcspn(data, "\n")] = 0;
+        if (!readLine(data, sizeof(data)))
+        {
+            break; // Input ended: keep the contacts completed so far
+        }
         if (checkemail(data) == 0)
         {
             if (isvalidemail(data) == 2)
@@ -382,48 +440,234 @@ void addcontact()
     printf("\t\t|---------------------------------------------------------------| \n");
     printf("\t\t| \tName\t| \tPhone Number\t  |  \t Email\t\t| \n");
     printf("\t\t|---------------------------------------------------------------| \n");
-    int start = count - no_of_contacts;
-    for (int i = 0; i < no_of_contacts; i++)
+    for (int i = start; i < count; i++)
     {
         printf("\t\t| %s \t| %s \t| %s \t|\n",
-               contacts[start + i].name,
-               contacts[start + i].phone,
-               contacts[start + i].email);
+               contacts[i].name,
+               contacts[i].phone,
+               contacts[i].email);
+    }
+    for (int i = start; i < count; i++)
+    {
+        placeSorted(i, i + 1);
     }
 
     my_pause();
-    loginPage();
+}
+
+#define PAGE_ROWS 25
+#define OUT_BUF_SIZE (1 << 16)
+#define ROW_MAX 192 // Longest rendered row: three 49-char fields plus the frame
+
+char outBuf[OUT_BUF_SIZE];
+size_t outLen = 0;
+
+/**
+ * flushOut
+ * ------------------
+ * What: Writes the pending rendered rows to stdout.
+ * Args: none
+ * Returns: void
+ * Logic: One fwrite() of everything in outBuf, then empties it.
+ */
+void flushOut()
+{
+    fwrite(outBuf, 1, outLen, stdout);
+    outLen = 0;
+}
+
+/**
+ * padCell
+ * ------------------
+ * What: Copies a field and pads it with spaces, like "%-Ns" without printf.
+ * Args:
+ *   char *o        – where to write
+ *   const char *s  – the field
+ *   int width      – minimum width; longer fields are not cut
+ * Returns:
+ *   char * – one past the last byte written
+ */
+char *padCell(char *o, const char *s, int width)
+{
+    while (*s)
+    {
+        *o++ = *s++;
+        width--;
+    }
+    while (width-- > 0)
+    {
+        *o++ = ' ';
+    }
+    return o;
+}
+
+/**
+ * renderRows
+ * ------------------
+ * What: Formats contacts[from, to) as table rows into outBuf.
+ * Args:
+ *   int from, to – slot range; deleted slots are skipped
+ * Returns: void
+ * Logic: Builds "\t\t| name | phone | email  \n" with padCell(), the same
+ *        bytes the old per-row printf produced, and flushes whenever less
+ *        than a row's worth of room is left, so the terminal sees 64 KiB
+ *        writes instead of one call per contact.
+ */
+void renderRows(int from, int to)
+{
+    for (int i = from; i < to; i++)
+    {
+        if (isDeleted(i))
+        {
+            continue;
+        }
+        if (OUT_BUF_SIZE - outLen < ROW_MAX)
+        {
+            flushOut();
+        }
+        char *o = outBuf + outLen;
+        *o++ = '\t';
+        *o++ = '\t';
+        *o++ = '|';
+        *o++ = ' ';
+        o = padCell(o, contacts[i].name, 20);
+        memcpy(o, " | ", 3);
+        o = padCell(o + 3, contacts[i].phone, 15);
+        memcpy(o, " | ", 3);
+        o = padCell(o + 3, contacts[i].email, 30);
+        memcpy(o, "  \n", 3);
+        outLen = o + 3 - outBuf;
+    }
+}
+
+/**
+ * findLetter
+ * ------------------
+ * What: Finds the first contact whose name starts with a given letter.
+ * Args:
+ *   char letter – the letter, either case
+ * Returns:
+ *   int – its slot, or -1 if there is none
+ * Logic: Linear scan of the first byte of each name; nothing is formatted.
+ */
+int findLetter(char letter)
+{
+    letter = toupper((unsigned char)letter);
+    for (int i = 0; i < count; i++)
+    {
+        if (toupper((unsigned char)contacts[i].name[0]) == letter)
+        {
+            return i;
+        }
+    }
+    return -1;
 }
 
 /**
  * displaycontacts
  * ------------------
- * What: Displays all stored contacts in a tabular format.
+ * What: Displays the stored contacts one page at a time.
  * Args: none
  * Returns: void
- * Logic: Iterates the contacts[] array up to 'count' and prints each entry.
+ * Logic: Compacts deleted slots away so page p is contacts[p*PAGE_ROWS, ...),
+ *        then loops: renders only the visible page through renderRows() and
+ *        reads a pager command:
+ *          Enter – next page (back to the menu after the last one)
+ *          <     – previous page
+ *          N     – page N (0 goes back to the menu)
+ *          A-Z   – page holding the first name starting with that letter
+ *          *     – every contact at once, written in 64 KiB chunks
+ *        A one-page list therefore behaves like the old display-then-pause.
  */
 void displaycontacts()
 {
-    clearBuffer();
-    printf("\t\t\t\t\t----------------------------- \n");
-    printf("\t\t\t\t\t    >>> Contacts List <<< \n");
-    printf("\t\t\t\t\t----------------------------- \n");
-    printf("\t\t\t\t\t    Total Contacts = %d\n", count);
-    printf("\t\t|-------------------------------------------------------------------------| \n");
-    printf("\t\t| %-20s | %-15s | %-30s | \n", "Name", "Phone Number", "Email");
-    printf("\t\t|-------------------------------------------------------------------------| \n\n");
+    compactContacts();
+    int pages = count > 0 ? (count + PAGE_ROWS - 1) / PAGE_ROWS : 1;
+    int page = 0;
+    const char *note = "";
+    char line[32];
 
-    for (int i = 0; i < count; i++)
+    while (1)
     {
-        printf("\t\t| %-20s | %-15s | %-30s  \n",
-               contacts[i].name,
-               contacts[i].phone,
-               contacts[i].email);
+        clearBuffer();
+        printf("\t\t\t\t\t----------------------------- \n");
+        printf("\t\t\t\t\t    >>> Contacts List <<< \n");
+        printf("\t\t\t\t\t----------------------------- \n");
+        printf("\t\t\t\t\t    Total Contacts = %d\n", count);
+        printf("\t\t|-------------------------------------------------------------------------| \n");
+        printf("\t\t| %-20s | %-15s | %-30s | \n", "Name", "Phone Number", "Email");
+        printf("\t\t|-------------------------------------------------------------------------| \n\n");
+        int end = (page + 1) * PAGE_ROWS;
+        renderRows(page * PAGE_ROWS, end < count ? end : count);
+        flushOut();
+        printf("\n\t\t\t\t\t    Page %d of %d %s\n", page + 1, pages, note);
+        printf("\t\t[Enter] next  [<] previous  [N] page N  [A-Z] jump to letter  [*] all  [0] back: ");
+        note = "";
+
+        if (!fgets(line, sizeof(line), stdin))
+        {
+            return;
+        }
+        if (!strchr(line, '\n'))
+        {
+            clearInputBuffer();
+        }
+
+        if (line[0] == '\n')
+        {
+            if (++page == pages)
+            {
+                return;
+            }
+        }
+        else if (line[0] == '<')
+        {
+            if (page > 0)
+            {
+                page--;
+            }
+        }
+        else if (line[0] == '*')
+        {
+            printf("\n\n");
+            renderRows(0, count);
+            flushOut();
+            my_pause();
+            return;
+        }
+        else if (isdigit((unsigned char)line[0]))
+        {
+            int n = atoi(line);
+            if (n == 0)
+            {
+                return;
+            }
+            if (n <= pages)
+            {
+                page = n - 1;
+            }
+            else
+            {
+                note = "(no such page)";
+            }
+        }
+        else if (isalpha((unsigned char)line[0]))
+        {
+            int i = findLetter(line[0]);
+            if (i >= 0)
+            {
+                page = i / PAGE_ROWS;
+            }
+            else
+            {
+                note = "(no name with that letter)";
+            }
+        }
+        else
+        {
+            note = "(invalid command)";
+        }
     }
-    getchar();
-    my_pause();
-    loginPage();
 }
 
 /**
@@ -431,10 +675,11 @@ void displaycontacts()
  * ------------------
  * What: Finds and displays contacts whose name contains the query substring.
  * Args: none
- * Returns: void
+ * Returns:
+ *   int – 1 if 0 was entered to go back to the main menu, else 0
  * Logic: Prompts for substring, loops through contacts[], uses strstr() for match.
  */
-void searchByName()
+int searchByName()
 {
     clearBuffer();
     printf("\t\t|---------------------------------------------------------------| \n");
@@ -444,11 +689,9 @@ void searchByName()
     char searchName[50];
 
     printf("\t\tEnter the name to search - ");
-    fgets(searchName, sizeof(searchName), stdin);
-    searchName[strcspn(searchName, "\n")] = 0;
-    if (strcmp(searchName, "0") == 0)
+    if (!readLine(searchName, sizeof(searchName)) || strcmp(searchName, "0") == 0)
     {
-        loginPage();
+        return 1;
     }
 
     printf("\t\t|---------------------------------------------------------------| \n");
@@ -457,7 +700,7 @@ void searchByName()
 
     for (int i = 0; i < count; i++)
     {
-        if (strstr(contacts[i].name, searchName))
+        if (!isDeleted(i) && strstr(contacts[i].name, searchName))
         {
             printf("\t\t| %-20s | %-15s | %-30s |\n",
                    contacts[i].name,
@@ -467,7 +710,7 @@ void searchByName()
     }
 
     my_pause();
-    searchcontact();
+    return 0;
 }
 
 /**
@@ -475,10 +718,11 @@ void searchByName()
  * ------------------
  * What: Finds and displays contacts whose phone contains the query substring.
  * Args: none
- * Returns: void
+ * Returns:
+ *   int – 1 if 0 was entered to go back to the main menu, else 0
  * Logic: Prompts for substring, loops through contacts[], uses strstr().
  */
-void searchByNumber()
+int searchByNumber()
 {
     clearBuffer();
     printf("\t\t|---------------------------------------------------------------| \n");
@@ -488,11 +732,9 @@ void searchByNumber()
     char searchphone[50];
 
     printf("\t\tEnter the number to search - ");
-    fgets(searchphone, sizeof(searchphone), stdin);
-    searchphone[strcspn(searchphone, "\n")] = 0;
-    if (strcmp(searchphone, "0") == 0)
+    if (!readLine(searchphone, sizeof(searchphone)) || strcmp(searchphone, "0") == 0)
     {
-        loginPage();
+        return 1;
     }
 
     printf("\t\t|---------------------------------------------------------------| \n");
@@ -501,7 +743,7 @@ void searchByNumber()
 
     for (int i = 0; i < count; i++)
     {
-        if (strstr(contacts[i].phone, searchphone))
+        if (!isDeleted(i) && strstr(contacts[i].phone, searchphone))
         {
             printf("\t\t| %-20s | %-15s | %-30s |\n",
                    contacts[i].name,
@@ -511,7 +753,7 @@ void searchByNumber()
     }
 
     my_pause();
-    searchcontact();
+    return 0;
 }
 
 /**
@@ -519,10 +761,11 @@ void searchByNumber()
  * ------------------
  * What: Finds and displays contacts whose email contains the query substring.
  * Args: none
- * Returns: void
+ * Returns:
+ *   int – 1 if 0 was entered to go back to the main menu, else 0
  * Logic: Prompts for substring, loops through contacts[], uses strstr().
  */
-void searchByEmail()
+int searchByEmail()
 {
     clearBuffer();
     printf("\t\t|---------------------------------------------------------------| \n");
@@ -532,11 +775,9 @@ void searchByEmail()
     char searchemail[50];
 
     printf("\t\tEnter the Email to search - ");
-    fgets(searchemail, sizeof(searchemail), stdin);
-    searchemail[strcspn(searchemail, "\n")] = 0;
-    if (strcmp(searchemail, "0") == 0)
+    if (!readLine(searchemail, sizeof(searchemail)) || strcmp(searchemail, "0") == 0)
     {
-        loginPage();
+        return 1;
     }
 
     printf("\t\t|---------------------------------------------------------------| \n");
@@ -545,7 +786,7 @@ void searchByEmail()
 
     for (int i = 0; i < count; i++)
     {
-        if (strstr(contacts[i].email, searchemail))
+        if (!isDeleted(i) && strstr(contacts[i].email, searchemail))
         {
             printf("\t\t| %-20s | %-15s | %-30s |\n",
                    contacts[i].name,
@@ -555,7 +796,7 @@ void searchByEmail()
     }
 
     my_pause();
-    searchcontact();
+    return 0;
 }
 
 /**
@@ -564,43 +805,133 @@ void searchByEmail()
  * What: Menu to choose search by name, phone, or email.
  * Args: none
  * Returns: void
- * Logic: Reads sub-choice then calls the corresponding searchByX().
+ * Logic: Loops: reads sub-choice then calls the corresponding searchByX(),
+ *        which comes back here unless 0 was entered to leave for the main
+ *        menu. Any other choice returns to the main menu.
  */
 void searchcontact()
 {
-    clearBuffer();
-    int searchchoice;
-    printf("\t\t|---------------------------------------------------------------| \n");
-    printf("\t\t\t\t     >>> Search Contacts <<< \n");
-    printf("\t\t|---------------------------------------------------------------| \n");
-    printf("\n\t\t\t   (Enter 0 to go back to the main menu)\n");
-    printf("\n\t\t\t1. Search by Name");
-    printf("\n\t\t\t2. Search by Phone Number");
-    printf("\n\t\t\t3. Search by Email");
-    printf("\n\n\t\tEnter the search parameter - ");
-    scanf("%d", &searchchoice);
-    clearInputBuffer();
+    int back = 0;
+    while (!back)
+    {
+        clearBuffer();
+        int searchchoice = -1;
+        printf("\t\t|---------------------------------------------------------------| \n");
+        printf("\t\t\t\t     >>> Search Contacts <<< \n");
+        printf("\t\t|---------------------------------------------------------------| \n");
+        printf("\n\t\t\t   (Enter 0 to go back to the main menu)\n");
+        printf("\n\t\t\t1. Search by Name");
+        printf("\n\t\t\t2. Search by Phone Number");
+        printf("\n\t\t\t3. Search by Email");
+        printf("\n\n\t\tEnter the search parameter - ");
+        if (scanf("%d", &searchchoice) == EOF)
+        {
+            return;
+        }
+        clearInputBuffer();
 
-    if (searchchoice == 0)
+        switch (searchchoice)
+        {
+        case 0:
+            return;
+        case 1:
+            back = searchByName();
+            break;
+        case 2:
+            back = searchByNumber();
+            break;
+        case 3:
+            back = searchByEmail();
+            break;
+        default:
+            printf("Invalid search parameter");
+            my_pause();
+            return;
+        }
+    }
+}
+
+/**
+ * isDeleted
+ * ------------------
+ * What: Tells whether slot i of contacts[] was deleted.
+ * Args:
+ *   int i – slot index below count
+ * Returns:
+ *   int – 1 if deleted, 0 if it holds a contact
+ * Logic: Tests bit i of deadSlots; slots past the bitmap are live.
+ */
+int isDeleted(int i)
+{
+    return i / 64 < deadWords && ((deadSlots[i / 64] >> (i % 64)) & 1);
+}
+
+/**
+ * compactContacts
+ * ------------------
+ * What: Closes the gaps left by deleted slots.
+ * Args: none
+ * Returns: void
+ * Logic: Slides every live record down over the deleted ones in a single
+ *        pass, keeping their order, clears the bitmap, then lets
+ *        shrinkContacts() return memory the array no longer needs.
+ */
+void compactContacts()
+{
+    if (deleted == 0)
     {
-        loginPage();
+        return;
     }
-    switch (searchchoice)
+    int to = 0;
+    for (int i = 0; i < count; i++)
     {
-    case 1:
-        searchByName();
-        break;
-    case 2:
-        searchByNumber();
-        break;
-    case 3:
-        searchByEmail();
-        break;
-    default:
-        printf("Invalid search parameter");
+        if (!isDeleted(i))
+        {
+            contacts[to++] = contacts[i];
+        }
+    }
+    count = to;
+    deleted = 0;
+    memset(deadSlots, 0, deadWords * sizeof(uint64_t));
+    shrinkContacts();
+}
+
+/**
+ * deleteSlot
+ * ------------------
+ * What: Deletes the contact in slot i without moving the records after it.
+ * Args:
+ *   int i – slot of a live contact
+ * Returns: void
+ * Logic: Sets bit i of deadSlots, growing the bitmap if needed. Once a
+ *        quarter of the slots are deleted, compactContacts() runs; a pass
+ *        over n records comes at least n/4 deletes after the previous one,
+ *        so a delete is O(1) amortized.
+ *        If the bitmap can't grow, every slot from i on is past it (so live)
+ *        and the tail is shifted down the old way.
+ */
+void deleteSlot(int i)
+{
+    if (i / 64 >= deadWords)
+    {
+        int words = (count + 63) / 64 * 2;
+        uint64_t *grown = realloc(deadSlots, words * sizeof(uint64_t));
+        if (grown == NULL)
+        {
+            memmove(&contacts[i], &contacts[i + 1], (count - i - 1) * sizeof(Details));
+            count--;
+            return;
+        }
+        memset(grown + deadWords, 0, (words - deadWords) * sizeof(uint64_t));
+        deadSlots = grown;
+        deadWords = words;
+    }
+    deadSlots[i / 64] |= (uint64_t)1 << (i % 64);
+    deleted++;
+    if (deleted * 4 >= count)
+    {
+        compactContacts();
     }
-    my_pause();
-    loginPage();
 }
 
 /**
@@ -609,7 +940,8 @@ void searchcontact()
  * What: Deletes the first contact that exactly matches a given name.
  * Args: none
  * Returns: void
- * Logic: Prompts for a name, validates it, shifts array elements down to overwrite.
+ * Logic: Prompts for a name, validates it, then deleteSlot() leaves a
+ *        tombstone in its place instead of shifting the array.
  */
 void deletecontact()
 {
@@ -622,30 +954,23 @@ void deletecontact()
     char searchname[50];
 jump3:
     printf("\t\tEnter the Name to Delete - ");
-    fgets(searchname, sizeof(searchname), stdin);
-    searchname[strcspn(searchname, "\n")] = 0;
-    if (strcmp(searchname, "0") == 0)
+    if (!readLine(searchname, sizeof(searchname)) || strcmp(searchname, "0") == 0)
     {
-        loginPage();
+        return;
     }
     if (isvalidname(searchname))
     {
         for (int i = 0; i < count; i++)
         {
-            if (strcmp(contacts[i].name, searchname) == 0)
+            if (!isDeleted(i) && strcmp(contacts[i].name, searchname) == 0)
             {
                 printf("\n\t\t| %-20s | %-15s | %-30s |\n",
                        contacts[i].name,
                        contacts[i].phone,
                        contacts[i].email);
-                for (int j = i; j < count - 1; j++)
-                {
-                    contacts[j] = contacts[j + 1];
-                }
-                count--;
+                deleteSlot(i);
                 printf("\n\n\t\tContact Deleted Successfully!\n");
                 my_pause();
-                loginPage();
                 return;
             }
         }
@@ -657,7 +982,6 @@ jump3:
         goto jump3;
     }
     my_pause();
-    loginPage();
 }
 
 /**
@@ -666,7 +990,8 @@ jump3:
  * What: Deletes all contacts after confirmation.
  * Args: none
  * Returns: void
- * Logic: Prompts Y/N; if yes sets count=0, else does nothing.
+ * Logic: Prompts Y/N; if yes sets count=0, drops the tombstones and shrinks
+ *        contacts[] back to ENGINE_CAPACITY_MIN, else does nothing.
  */
 void Deleteall()
 {
@@ -680,6 +1005,11 @@ void Deleteall()
     if (choice == 'Y' || choice == 'y')
     {
         count = 0;
+        deleted = 0;
+        free(deadSlots);
+        deadSlots = NULL;
+        deadWords = 0;
+        shrinkContacts();
         printf("\n\n\t\t\t\tAll contacts deleted successfully!\n\t\t\t\t");
     }
     else
@@ -687,7 +1017,6 @@ void Deleteall()
         printf("\n\n\t\t\t\tOperation Cancelled!\n\t\t\t");
     }
     my_pause();
-    loginPage();
 }
 
 /**
@@ -697,10 +1026,15 @@ void Deleteall()
  * Args: none
  * Returns: void
  * Logic: Menu to choose field, prompts for old value, validates, replaces with new.
+ *        If contacts[] is sorted, placeSorted() moves the record to its new place.
  */
 void editcontact()
 {
     clearBuffer();
+    if (sortedBy != 0)
+    {
+        compactContacts(); // placeSorted() below shifts over live records only
+    }
     printf("\t\t|---------------------------------------------------------------| \n");
     printf("\t\t\t\t     >>> Edit a Contact <<< \n");
     printf("\t\t|---------------------------------------------------------------| \n");
@@ -711,7 +1045,7 @@ void editcontact()
     char newname[50];
     char newphone[50];
     char newemail[50];
-    int flag, choice;
+    int flag, choice = 0;
 
 jump_here:
     printf("\n\t\t\t   (Enter 0 to go back to the main menu)\n");
@@ -720,11 +1054,14 @@ jump_here:
     printf("\t\t2. Phone Number\n");
     printf("\t\t3. Email\n");
     printf("\n\t\tEnter your choice - ");
-    scanf("%d", &choice);
+    if (scanf("%d", &choice) == EOF)
+    {
+        return;
+    }
     getchar();
     if (choice == 0)
     {
-        loginPage();
+        return;
     }
 
     flag = 0;
@@ -733,17 +1070,15 @@ jump_here:
     case 1:
     jump4:
         printf("\n\n\tEnter the name to edit - ");
-        fgets(searchname, sizeof(searchname), stdin);
-        searchname[strcspn(searchname, "\n")] = 0;
-        if (strcmp(searchname, "0") == 0)
+        if (!readLine(searchname, sizeof(searchname)) || strcmp(searchname, "0") == 0)
         {
-            loginPage();
+            return;
         }
         if (isvalidname(searchname))
         {
             for (int i = 0; i < count; i++)
             {
-                if (strcmp(contacts[i].name, searchname) == 0)
+                if (!isDeleted(i) && strcmp(contacts[i].name, searchname) == 0)
                 {
                     printf("\t\tFound the contact!\n");
                     flag = 1;
@@ -755,15 +1090,13 @@ jump_here:
                 goto jump_here;
             }
             printf("\n\n\tEnter the new name - ");
-            fgets(newname, sizeof(newname), stdin);
-            newname[strcspn(newname, "\n")] = 0;
-            if (strcmp(newname, "0") == 0)
+            if (!readLine(newname, sizeof(newname)) || strcmp(newname, "0") == 0)
             {
-                loginPage();
+                return;
             }
             for (int i = 0; i < count; i++)
             {
-                if (strcmp(contacts[i].name, searchname) == 0)
+                if (!isDeleted(i) && strcmp(contacts[i].name, searchname) == 0)
                 {
                     strcpy(contacts[i].name, newname);
                     printf("\n\tName updated successfully!\n");
@@ -771,8 +1104,9 @@ jump_here:
                            contacts[i].name,
                            contacts[i].phone,
                            contacts[i].email);
+                    placeSorted(i, count);
                     my_pause();
-                    loginPage();
+                    return;
                 }
             }
         }
@@ -786,17 +1120,15 @@ jump_here:
     case 2:
     jump7:
         printf("\n\n\tEnter the phone number to edit - ");
-        fgets(searchphone, sizeof(searchphone), stdin);
-        searchphone[strcspn(searchphone, "\n")] = 0;
-        if (strcmp(searchphone, "0") == 0)
+        if (!readLine(searchphone, sizeof(searchphone)) || strcmp(searchphone, "0") == 0)
         {
-            loginPage();
+            return;
         }
         if (isvalidnumber(searchphone) == 2)
         {
             for (int i = 0; i < count; i++)
             {
-                if (strcmp(contacts[i].phone, searchphone) == 0)
+                if (!isDeleted(i) && strcmp(contacts[i].phone, searchphone) == 0)
                 {
                     printf("\t\tFound the contact!\n");
                     flag = 1;
@@ -807,17 +1139,15 @@ jump_here:
                 printf("\n\t\tContact not found!\n");
             }
             printf("\n\n\tEnter the new phone number - ");
-            fgets(newphone, sizeof(newphone), stdin);
-            newphone[strcspn(newphone, "\n")] = 0;
-            if (strcmp(newphone, "0") == 0)
+            if (!readLine(newphone, sizeof(newphone)) || strcmp(newphone, "0") == 0)
             {
-                loginPage();
+                return;
             }
             if (isvalidnumber(newphone) == 2)
             {
                 for (int i = 0; i < count; i++)
                 {
-                    if (strcmp(contacts[i].phone, searchphone) == 0)
+                    if (!isDeleted(i) && strcmp(contacts[i].phone, searchphone) == 0)
                     {
                         strcpy(contacts[i].phone, newphone);
                         printf("\n\tPhone number updated successfully!\n");
@@ -825,8 +1155,9 @@ jump_here:
                                contacts[i].name,
                                contacts[i].phone,
                                contacts[i].email);
+                        placeSorted(i, count);
                         my_pause();
-                        loginPage();
+                        return;
                     }
                 }
             }
@@ -841,17 +1172,15 @@ jump_here:
     case 3:
     jump10:
         printf("\n\n\tEnter the email to edit - ");
-        fgets(searchemail, sizeof(searchemail), stdin);
-        searchemail[strcspn(searchemail, "\n")] = 0;
-        if (strcmp(searchemail, "0") == 0)
+        if (!readLine(searchemail, sizeof(searchemail)) || strcmp(searchemail, "0") == 0)
         {
-            loginPage();
+            return;
         }
         if (isvalidemail(searchemail) == 2)
         {
             for (int i = 0; i < count; i++)
             {
-                if (strcmp(contacts[i].email, searchemail) == 0)
+                if (!isDeleted(i) && strcmp(contacts[i].email, searchemail) == 0)
                 {
                     printf("\t\tFound the contact!\n");
                     flag = 1;
@@ -864,17 +1193,20 @@ jump_here:
             }
         jump11:
             printf("\n\n\tEnter the new email - ");
-            fgets(newemail, sizeof(newemail), stdin);
-            newemail[strcspn(newemail, "\n")] = 0;
-            if (strcmp(newemail, "0") == 0)
+            if (!readLine(newemail, sizeof(newemail)) || strcmp(newemail, "0") == 0)
             {
-                loginPage();
+                return;
             }
             if (isvalidemail(newemail) == 2)
             {
+                if (!engine_fold_equal(newemail, searchemail) && checkemail(newemail))
+                {
+                    printf("\n\t\tEmail already exists! Please enter a different email.\n");
+                    goto jump11;
+                }
                 for (int i = 0; i < count; i++)
                 {
-                    if (strcmp(contacts[i].email, searchemail) == 0)
+                    if (!isDeleted(i) && strcmp(contacts[i].email, searchemail) == 0)
                     {
                         strcpy(contacts[i].email, newemail);
                         printf("\n\tEmail updated successfully!\n");
@@ -882,8 +1214,9 @@ jump_here:
                                contacts[i].name,
                                contacts[i].phone,
                                contacts[i].email);
+                        placeSorted(i, count);
                         my_pause();
-                        loginPage();
+                        return;
                     }
                 }
             }
@@ -903,85 +1236,172 @@ jump_here:
     default:
         printf("\n\n\tInvalid choice!\n");
         my_pause();
-        loginPage();
+        return;
     }
 }
 
+/**
+ * indexSort
+ * ------------------
+ * What: Sorts contacts[] by one field without moving records during the sort.
+ * Args:
+ *   size_t off – offsetof(Details, name/phone/email)
+ * Returns:
+ *   int – 1 if sorted, 0 if memory is short (contacts[] untouched)
+ * Logic: engine_sort_strings() orders (key, index) pairs for the field (an
+ *        LSD radix sort on packed phones, MSD radix on cached prefixes
+ *        otherwise, both stable), then every record is copied to its final
+ *        slot exactly once.
+ */
+int indexSort(size_t off)
+{
+    const char **strs = malloc(count * sizeof(const char *));
+    EngineKey *keys = malloc(count * sizeof(EngineKey));
+    EngineKey *tmp = malloc(count * sizeof(EngineKey));
+    Details *sorted = malloc(count * sizeof(Details));
+    int ok = strs != NULL && keys != NULL && tmp != NULL && sorted != NULL;
+    if (ok)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            strs[i] = (const char *)&contacts[i] + off;
+        }
+        EngineKey *order = engine_sort_strings(keys, tmp, strs, count, 1);
+        for (int i = 0; i < count; i++)
+        {
+            sorted[i] = contacts[order[i].idx];
+        }
+        memcpy(contacts, sorted, count * sizeof(Details));
+    }
+    free(strs);
+    free(keys);
+    free(tmp);
+    free(sorted);
+    return ok;
+}
+
 /**
  * sortByName
  * ------------------
- * What: Sorts contacts[] by name using bubble sort.
+ * What: Sorts contacts[] by name.
  * Args: none
  * Returns: void
- * Logic: Nested loops swapping adjacent out-of-order entries.
+ * Logic: sortBy(1), then displaycontacts().
  */
 void sortByName()
 {
-    Details temp;
-    for (int i = 0; i < count; i++)
+    sortBy(1);
+    displaycontacts();
+}
+
+/**
+ * fieldOffset
+ * ------------------
+ * What: Maps a sort choice to the matching Details field.
+ * Args:
+ *   int field – 1 name, 2 phone, 3 email
+ * Returns:
+ *   size_t – offsetof() that field
+ */
+size_t fieldOffset(int field)
+{
+    return field == 1 ? offsetof(Details, name)
+         : field == 2 ? offsetof(Details, phone)
+         : offsetof(Details, email);
+}
+
+/**
+ * placeSorted
+ * ------------------
+ * What: Keeps contacts[] ordered by sortedBy after a record is added or edited.
+ * Args:
+ *   int i – index of the new or changed record
+ *   int n – records [0, n) other than i are already in order
+ * Returns: void
+ * Logic: Binary search for the slot after any equal keys, then shift the
+ *        records in between by one. Deletes keep the order on their own, so
+ *        sorting by the same field again never has to re-sort. Expects no
+ *        deleted slots; callers run compactContacts() first.
+ */
+void placeSorted(int i, int n)
+{
+    if (sortedBy == 0)
     {
-        for (int j = 0; j < count - i - 1; j++)
+        return;
+    }
+    size_t off = fieldOffset(sortedBy);
+    Details moved = contacts[i];
+    memmove(&contacts[i], &contacts[i + 1], (n - i - 1) * sizeof(Details));
+
+    int lo = 0, hi = n - 1;
+    while (lo < hi)
+    {
+        int mid = lo + (hi - lo) / 2;
+        if (strcmp((const char *)&moved + off, (const char *)&contacts[mid] + off) < 0)
         {
-            if (strcmp(contacts[j].name, contacts[j + 1].name) > 0)
-            {
-                temp = contacts[j];
-                contacts[j] = contacts[j + 1];
-                contacts[j + 1] = temp;
-            }
+            hi = mid;
+        }
+        else
+        {
+            lo = mid + 1;
         }
     }
-    displaycontacts();
+    memmove(&contacts[lo + 1], &contacts[lo], (n - 1 - lo) * sizeof(Details));
+    contacts[lo] = moved;
+}
+
+/**
+ * sortBy
+ * ------------------
+ * What: Orders contacts[] by one field unless it already is.
+ * Args:
+ *   int field – 1 name, 2 phone, 3 email
+ * Returns: void
+ * Logic: Compacts deleted slots, then indexSort().
+ */
+void sortBy(int field)
+{
+    if (sortedBy == field || count < 2)
+    {
+        sortedBy = field;
+        return;
+    }
+    compactContacts();
+    if (indexSort(fieldOffset(field)))
+    {
+        sortedBy = field;
+    }
+    else
+    {
+        printf("\n\t\tNot enough memory to sort!\n");
+    }
 }
 
 /**
  * sortByNumber
  * ------------------
- * What: Sorts contacts[] by phone number using bubble sort.
+ * What: Sorts contacts[] by phone number.
  * Args: none
  * Returns: void
- * Logic: Nested loops swapping adjacent out-of-order entries.
+ * Logic: sortBy(2), then displaycontacts().
  */
 void sortByNumber()
 {
-    Details temp;
-    for (int i = 0; i < count - 1; i++)
-    {
-        for (int j = 0; j < count - i - 1; j++)
-        {
-            if (strcmp(contacts[j].phone, contacts[j + 1].phone) > 0)
-            {
-                temp = contacts[j];
-                contacts[j] = contacts[j + 1];
-                contacts[j + 1] = temp;
-            }
-        }
-    }
+    sortBy(2);
     displaycontacts();
 }
 
 /**
  * sortByEmail
  * ------------------
- * What: Sorts contacts[] by email using bubble sort.
+ * What: Sorts contacts[] by email.
  * Args: none
  * Returns: void
- * Logic: Nested loops swapping adjacent out-of-order entries.
+ * Logic: sortBy(3), then displaycontacts().
  */
 void sortByEmail()
 {
-    Details temp;
-    for (int i = 0; i < count - 1; i++)
-    {
-        for (int j = 0; j < count - i - 1; j++)
-        {
-            if (strcmp(contacts[j].email, contacts[j + 1].email) > 0)
-            {
-                temp = contacts[j];
-                contacts[j] = contacts[j + 1];
-                contacts[j + 1] = temp;
-            }
-        }
-    }
+    sortBy(3);
     displaycontacts();
 }
 
@@ -991,7 +1411,8 @@ void sortByEmail()
  * What: Shows sort menu then calls the chosen sort function.
  * Args: none
  * Returns: void
- * Logic: Reads choice and dispatches to sortByName/Number/Email.
+ * Logic: Reads choice and dispatches to sortByName/Number/Email, whose
+ *        pager returns straight to the main menu.
  */
 void displaySortedContacts()
 {
@@ -1004,7 +1425,10 @@ void displaySortedContacts()
     printf("2. Sort by Phone Number\n");
     printf("3. Sort by Email\n");
     printf("\n\tEnter your choice - ");
-    scanf("%d", &choice);
+    if (scanf("%d", &choice) == EOF)
+    {
+        return;
+    }
     getchar();
     switch (choice)
     {
@@ -1019,26 +1443,25 @@ void displaySortedContacts()
         break;
     default:
         printf("Invalid choice!");
+        my_pause();
     }
-    my_pause();
-    loginPage();
 }
 
 /**
  * checkemail
  * ------------------
- * What: Checks if the given email already exists.
+ * What: Checks if the given email already exists, ignoring case.
  * Args:
  *   char email[] – the email to check
  * Returns:
  *   int – 1 if found, 0 otherwise
- * Logic: Linear scan of contacts[] comparing strings.
+ * Logic: Linear scan of contacts[] comparing with engine_fold_equal().
  */
 int checkemail(char email[])
 {
     for (int i = 0; i < count; i++)
     {
-        if (strcmp(contacts[i].email, email) == 0)
+        if (!isDeleted(i) && engine_fold_equal(contacts[i].email, email))
         {
             return 1;
         }
@@ -1060,7 +1483,7 @@ int checkphone(char phone[])
 {
     for (int i = 0; i < count; i++)
     {
-        if (strcmp(contacts[i].phone, phone) == 0)
+        if (!isDeleted(i) && strcmp(contacts[i].phone, phone) == 0)
         {
             return 1;
         }
@@ -1082,7 +1505,7 @@ int checkname(char name[])
 {
     for (int i = 0; i < count; i++)
     {
-        if (strcmp(contacts[i].name, name) == 0)
+        if (!isDeleted(i) && strcmp(contacts[i].name, name) == 0)
         {
             return 1;
         }
@@ -1091,62 +1514,102 @@ int checkname(char name[])
 }
 
 /**
- * initialize
+ * appendContacts
  * ------------------
- * What: Loads contacts from "contacts.csv" into memory.
- * Args: none
- * Returns: void
- * Logic: Counts lines, mallocs 2*x entries, then fscanf() each record.
+ * What: Appends the records of a CSV file to contacts[].
+ * Args:
+ *   const char *path – file to read
+ * Returns:
+ *   int – records appended, or -1 if the file can't be opened or memory is short
+ * Logic: Counts the lines, reserveContacts() room for all of them in one
+ *        step, then engine_parse_csv_line() splits each line straight into
+ *        its slot; lines that don't split into three fields are skipped.
  */
-void initialize()
+int appendContacts(const char *path)
 {
-    pF = fopen("contacts.csv", "r");
-    int ch;
+    pF = fopen(path, "r");
+    if (pF == NULL)
+    {
+        return -1;
+    }
+    int lines = 0, ch, last = '\n';
     while ((ch = fgetc(pF)) != EOF)
     {
         if (ch == '\n')
         {
-            x++;
+            lines++;
         }
+        last = ch;
+    }
+    if (last != '\n')
+    {
+        lines++; // Last line has no newline
+    }
+    if (lines == 0)
+    {
+        fclose(pF);
+        return 0;
+    }
+    if (!reserveContacts(count + lines))
+    {
+        fclose(pF);
+        return -1;
     }
     rewind(pF);
 
-    contacts = (Details *)malloc(2 * x * sizeof(Details));
-    fclose(pF);
-
-    pF = fopen("contacts.csv", "r");
-    for (int i = 0; i < x; i++)
+    char line[200];
+    int added = 0;
+    while (added < lines && fgets(line, sizeof(line), pF))
     {
-        fscanf(pF, "%49[^,],%14[^,],%49[^\n]\n",
-               contacts[i].name,
-               contacts[i].phone,
-               contacts[i].email);
-        count++;
+        if (engine_parse_csv_line(line, &contacts[count]))
+        {
+            count++;
+            added++;
+        }
     }
     fclose(pF);
-
-    infoscreen();
+    return added;
 }
 
 /**
- * save
+ * initialize
  * ------------------
- * What: Writes all contacts back to "contacts.csv".
+ * What: Loads contacts from "contacts.csv" into memory.
  * Args: none
  * Returns: void
- * Logic: Opens file for write, fprintf() each record, then prompts to exit/menu.
+ * Logic: appendContacts("contacts.csv"), infoscreen(), then the loginPage() menu loop.
  */
-void save()
+void initialize()
 {
-    pF = fopen("contacts.csv", "w");
+    appendContacts("contacts.csv");
+    infoscreen();
+    loginPage();
+}
+
+/**
+ * writeContacts
+ * ------------------
+ * What: Writes every live contact to a CSV file.
+ * Args:
+ *   const char *path – file to overwrite
+ * Returns:
+ *   int – 1 on success, 0 on an I/O error (already reported with perror)
+ */
+int writeContacts(const char *path)
+{
+    pF = fopen(path, "w");
     if (pF == NULL)
     {
         perror("Error opening file");
-        return;
+        return 0;
     }
 
     for (int i = 0; i < count; i++)
     {
+        if (isDeleted(i))
+        {
+            continue;
+        }
         if (fprintf(pF, "%s,%s,%s\n",
                     contacts[i].name,
                     contacts[i].phone,
@@ -1154,28 +1617,41 @@ void save()
         {
             perror("Error writing to file");
             fclose(pF);
-            return;
+            return 0;
         }
     }
-    fclose(pF);
+    if (fclose(pF) != 0)
+    {
+        perror("Error writing to file");
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * save
+ * ------------------
+ * What: Writes all contacts back to "contacts.csv".
+ * Args: none
+ * Returns: void
+ * Logic: writeContacts("contacts.csv"), then prompts to exit/menu.
+ */
+void save()
+{
+    if (!writeContacts("contacts.csv"))
+    {
+        return;
+    }
 
     clearBuffer();
     printf("\n\n\t\t\t\t\tContacts saved successfully!\n");
-    char ch;
+    char ch = '0';
     printf("\n\t\t\t\tEnter 0 to go back or y to EXIT - ");
     scanf(" %c", &ch);
-    if (ch == '0')
-    {
-        loginPage();
-    }
-    else if (ch == 'Y' || ch == 'y')
+    if (ch == 'Y' || ch == 'y')
     {
-        endScreen();
         free(contacts);
-    }
-    else
-    {
-        loginPage();
+        endScreen();
     }
 }
 
@@ -1185,26 +1661,21 @@ void save()
  * What: Prompts user to save before exiting.
  * Args: none
  * Returns: void
- * Logic: Asks Y/N; on yes calls save(), else frees memory and exits.
+ * Logic: Asks Y/N; on yes calls save(), whose own prompt exits or returns
+ *        to the menu (as does a failed write); on 0 returns to the menu;
+ *        otherwise frees memory and exits.
  */
 void Exit()
 {
     printf("\n\t\t\t\t(Enter 0 to go back to the main menu)\n");
     printf("\n\t\t\t\tDo you want to save the changes? (Y/N) - ");
-    char ch;
+    char ch = '0';
     scanf(" %c", &ch);
-    if (ch == '0')
-    {
-        loginPage();
-    }
-    else if (ch == 'Y' || ch == 'y')
+    if (ch == 'Y' || ch == 'y')
     {
         save();
-        printf("\n\n\t\t\t\t\t Contacts saved successfully!\n\t\t\t\t");
-        my_pause();
-        endScreen();
     }
-    else
+    else if (ch != '0')
     {
         free(contacts);
         endScreen();
@@ -1255,3 +1726,25 @@ void addgiven()
 
     fclose(pF);
 }
+
+/**
+ * runCommand
+ * ------------------
+ * What: Runs one headless subcommand instead of the menus.
+ * Args:
+ *   int argc, char *argv[] – the program arguments:
+ *     donna [-f FILE] [--tsv] import CSV | search FIELD TEXT |
+ *           sort FIELD | export | dedupe [FIELD]
+ * Returns:
+ *   int – exit status: 0 ok, 1 I/O or memory error, 2 usage error
+ * Logic: engine_command() on the engine's array backend, the same layout
+ *        as contacts[]: loads FILE (default "contacts.csv"), runs the
+ *        command with no prompts or screen clears, and streams records to
+ *        stdout as CSV (TSV with --tsv). search, sort and export only read;
+ *        import and dedupe write FILE back and print the rows they reject
+ *        or remove. Counts go to stderr so stdout stays pure data.
+ */
+int runCommand(int argc, char *argv[])
+{
+    return engine_command(&engine_array_backend, argc, argv);
+}
@@ -11,18 +11,30 @@ void displaySortedContacts();
 void sortByEmail();
 void sortByNumber();
 void sortByName();
+void sortBy(int field);
+void placeSorted(int i, int n);
+int isDeleted(int i);
+void compactContacts();
+void deleteSlot(int i);
 void infoscreen();
 void loginPage();
-void searchByName();
-void searchByEmail();
-void searchByNumber();
+int searchByName();
+int searchByEmail();
+int searchByNumber();
 void searchcontact();
 void deletecontact();
 void displaycontacts();
+void flushOut();
+char *padCell(char *o, const char *s, int width);
+void renderRows(int from, int to);
+int findLetter(char letter);
 void editcontact();
+int reserveContacts(int need);
+void shrinkContacts();
 void addcontact();
 void clearBuffer();
 void clearinputbuffer();
+int readLine(char buf[], int size);
 void Deleteall();
 void endScreen();
 int checkemail(char email[]);
@@ -31,6 +43,9 @@ int checkname(char name[]);
 void addgiven();
 void Exit();
 void save();
+int appendContacts(const char *path);
+int writeContacts(const char *path);
+int runCommand(int argc, char *argv[]);
 
 
 #endif
@@ -1,7 +1,11 @@
-#include "contact.h"
+#include "contact1.h"
 
-int main()
+int main(int argc, char *argv[])
 {
+    if (argc > 1)
+    {
+        return runCommand(argc, argv); // Headless: donna import|search|sort|export|dedupe ...
+    }
 /**
  * initialize
  * ------------------
@@ -1,10 +1,12 @@
-#include "contact.h"
+#include "contact2.h"
+#include "engine.h"
 
 #define LINE_LEN 58
 
 Node *head = NULL;
 int count = 0;
 static FILE *pF = NULL;
+static int sortedBy = 0; // Field the list is currently ordered by: 0 none, 1 name, 2 phone, 3 email
 
 
 /**
@@ -13,11 +15,13 @@ static FILE *pF = NULL;
  * What: Clears the terminal screen and flushes stdout.
  * Args: none
  * Returns: void
- * Logic: Calls system("clear") then fflush(stdout) to ensure output is clean.
+ * Logic: Calls system("clear") when stdout is a terminal (a scripted session
+ *        would fork a shell per screen for nothing), then fflush(stdout).
  */
 void clearBuffer()
 {
-    system("clear");
+    if (isatty(STDOUT_FILENO))
+        system("clear");
     fflush(stdout);
 }
 
@@ -50,38 +54,102 @@ void my_pause()
     getchar();
 }
 
+/**
+ * readChoice
+ * ------------------
+ * What: Reads a menu number and discards the rest of the line.
+ * Args:
+ *   int *choice – receives the number, or -1 if the line isn't one
+ * Returns:
+ *   bool – false at end of input (choice untouched)
+ */
+static bool readChoice(int *choice)
+{
+    int read = scanf("%d", choice);
+    if (read == EOF)
+        return false;
+    clearInputBuffer();
+    if (read != 1)
+        *choice = -1;
+    return true;
+}
+
+/**
+ * readLine
+ * ------------------
+ * What: Reads one line of input without its newline.
+ * Args:
+ *   char *buf – receives the line
+ *   int size  – size of buf
+ * Returns:
+ *   bool – false at end of input
+ */
+static bool readLine(char *buf, int size)
+{
+    if (!fgets(buf, size, stdin))
+        return false;
+    buf[strcspn(buf, "\n")] = '\0';
+    return true;
+}
+
+/**
+ * appendContacts
+ * ------------------
+ * What: Appends the records of a CSV file to the end of the list.
+ * Args:
+ *   const char *path – file to read
+ * Returns:
+ *   int – records appended, or -1 if the file can't be opened
+ * Logic: Splits each line with engine_parse_csv_line() and links a new
+ *        Node at the tail, so the list keeps file order and save() writes
+ *        it back unchanged. Lines that don't split into three fields are
+ *        skipped.
+ */
+int appendContacts(const char *path)
+{
+    pF = fopen(path, "r");
+    if (!pF)
+        return -1;
+    Node **link = &head;
+    while (*link)
+        link = &(*link)->next;
+
+    char line[200];
+    EngineRecord r;
+    int added = 0;
+    while (fgets(line, sizeof(line), pF))
+    {
+        if (!engine_parse_csv_line(line, &r))
+            continue;
+        Node *n = malloc(sizeof *n);
+        if (!n)
+            break;
+        memcpy(n->name, r.name, sizeof n->name);
+        memcpy(n->phone, r.phone, sizeof n->phone);
+        memcpy(n->email, r.email, sizeof n->email);
+        n->next = NULL;
+        *link = n;
+        link = &n->next;
+        count++;
+        added++;
+    }
+    fclose(pF);
+    return added;
+}
+
 /**
  * initialize
  * ------------------
  * What: Loads contacts from CSV into the linked list and shows intro.
  * Args: none
  * Returns: void
- * Logic: Opens "contacts.csv", reads each line, sscanf into a new Node,
- *        pushes onto head, increments count, then closes file and calls infoscreen().
+ * Logic: appendContacts("contacts.csv"), infoscreen(), then the loginPage() menu loop.
  */
 void initialize()
 {
-    pF = fopen("contacts.csv", "r");
-    if (pF)
-    {
-        char line[200];
-        while (fgets(line, sizeof(line), pF))
-        {
-            Node *n = malloc(sizeof *n);
-            if (sscanf(line,
-                       "%49[^,],%49[^,],%49[^\n]\n",
-                       n->name, n->phone, n->email) == 3)
-            {
-                n->next = head;
-                head = n;
-                count++;
-            }
-            else
-                free(n);
-        }
-        fclose(pF);
-    }
+    appendContacts("contacts.csv");
     infoscreen();
+    loginPage();
 }
 
 /**
@@ -90,7 +158,7 @@ void initialize()
  * What: Displays the application title/introduction screen.
  * Args: none
  * Returns: void
- * Logic: Calls clearBuffer(), prints banner & description, pauses, then calls loginPage().
+ * Logic: Calls clearBuffer(), prints banner & description, then pauses.
  */
 void infoscreen()
 {
@@ -103,7 +171,6 @@ void infoscreen()
     printf("\t\t\t\t------------------------------------ \n");
     printf("\t\t\t\t------------------------------------ \n\n");
     my_pause();
-    loginPage();
 }
 
 /**
@@ -129,54 +196,109 @@ void endScreen()
     exit(0);
 }
 
+// Handler for each main menu choice, indexed by the number typed (NULL: no such choice)
+static void (*const menuActions[])(void) = {
+    Exit, addcontact, editcontact, displaycontacts, searchcontact,
+    deletecontact, Deleteall, displaySortedContacts, NULL, save,
+};
+
 /**
  * loginPage
  * ------------------
- * What: Shows the main menu and dispatches based on user choice.
+ * What: Runs the main menu until input ends.
  * Args: none
  * Returns: void
- * Logic: Clears screen, prints options, reads choice, calls corresponding function.
+ * Logic: Loops: clears screen, prints options, reads choice, calls the
+ *        matching menuActions[] handler. Handlers return here instead of
+ *        calling loginPage() again, so the stack stays flat however long the
+ *        session runs. Exit() leaves through endScreen().
  */
 void loginPage()
 {
-    clearBuffer();
-    printf("\n\t\t\t\t------------------------------------------- \n");
-    printf("\t\t\t\t\t      >>> Donna <<<      \n");
-    printf("\t\t\t\t------------------------------------------- \n\n");
-    printf("\t\t\t\t[1] Add A New Contact. \n");
-    printf("\t\t\t\t[2] Update A Contact. \n");
-    printf("\t\t\t\t[3] Display All Contacts. \n");
-    printf("\t\t\t\t[4] Search Contact. \n");
-    printf("\t\t\t\t[5] Delete Contact. \n");
-    printf("\t\t\t\t[6] Delete All Contacts. \n");
-    printf("\t\t\t\t[7] Display Sorted Contacts. \n");
-    printf("\t\t\t\t[0] EXIT. \n");
-    printf("\t\t\t\t[9] SAVE. \n");
-    printf("\t\t\t\t------------------------------------ \n\n");
-    printf("\t\t\t\tEnter the number & Hit ENTER: ");
-    int choice;
-    scanf("%d", &choice);
-    clearInputBuffer();
-    switch (choice)
+    for (;;)
     {
-    case 1: addcontact();             break;
-    case 2: editcontact();            break;
-    case 3: displaycontacts();        break;
-    case 4: searchcontact();          break;
-    case 5: deletecontact();          break;
-    case 6: Deleteall();              break;
-    case 7: displaySortedContacts();  break;
-    case 9: save();                   break;
-    case 0: Exit();                   break;
-    default:
-        printf("---------------------------------------\n");
-        printf("ERROR: Invalid input please try again. \n");
-        printf("---------------------------------------\n");
-        my_pause();
-        loginPage();
+        clearBuffer();
+        printf("\n\t\t\t\t------------------------------------------- \n");
+        printf("\t\t\t\t\t      >>> Donna <<<      \n");
+        printf("\t\t\t\t------------------------------------------- \n\n");
+        printf("\t\t\t\t[1] Add A New Contact. \n");
+        printf("\t\t\t\t[2] Update A Contact. \n");
+        printf("\t\t\t\t[3] Display All Contacts. \n");
+        printf("\t\t\t\t[4] Search Contact. \n");
+        printf("\t\t\t\t[5] Delete Contact. \n");
+        printf("\t\t\t\t[6] Delete All Contacts. \n");
+        printf("\t\t\t\t[7] Display Sorted Contacts. \n");
+        printf("\t\t\t\t[0] EXIT. \n");
+        printf("\t\t\t\t[9] SAVE. \n");
+        printf("\t\t\t\t------------------------------------ \n\n");
+        printf("\t\t\t\tEnter the number & Hit ENTER: ");
+        int choice;
+        if (!readChoice(&choice))
+            return;
+        int actions = sizeof menuActions / sizeof menuActions[0];
+        if (choice >= 0 && choice < actions && menuActions[choice])
+            menuActions[choice]();
+        else
+        {
+            printf("---------------------------------------\n");
+            printf("ERROR: Invalid input please try again. \n");
+            printf("---------------------------------------\n");
+            my_pause();
+        }
     }
 }
 
+/**
+ * fieldOffset
+ * ------------------
+ * What: Maps a sort choice to the matching Node field.
+ * Args:
+ *   int field – 1 name, 2 phone, 3 email
+ * Returns:
+ *   size_t – offsetof() that field
+ */
+static size_t fieldOffset(int field) {
+    return field == 1 ? offsetof(Node, name)
+         : field == 2 ? offsetof(Node, phone)
+         : offsetof(Node, email);
+}
+
+/**
+ * insertSorted
+ * ------------------
+ * What: Links a detached node into the list at its sorted position.
+ * Args:
+ *   Node *nw – node to insert
+ * Returns: void
+ * Logic: Used while the list is ordered by sortedBy; walks past every key
+ *        <= the new one so equal keys keep arrival order. Deletes keep the
+ *        order on their own, so sorting by the same field again is free.
+ */
+static void insertSorted(Node *nw) {
+    size_t off = fieldOffset(sortedBy);
+    Node **link = &head;
+    while (*link && strcmp((const char *)*link + off, (const char *)nw + off) <= 0)
+        link = &(*link)->next;
+    nw->next = *link;
+    *link = nw;
+}
+
+/**
+ * unlinkNode
+ * ------------------
+ * What: Removes a node from the list without freeing it.
+ * Args:
+ *   Node *target – node to detach
+ * Returns: void
+ */
+static void unlinkNode(Node *target) {
+    Node **link = &head;
+    while (*link && *link != target)
+        link = &(*link)->next;
+    if (*link)
+        *link = target->next;
+}
+
 /**
  * addcontact
  * ------------------
@@ -184,77 +306,244 @@ void loginPage()
  * Args: none
  * Returns: void
  * Logic: Reads count n, loops n times reading and validating name/phone/email,
- *        prepends each new Node to head, increments count, then shows the last n added.
+ *        prepends each new Node to head, increments count, then shows the ones added.
+ *        If the list is sorted, the new nodes are then moved to their places.
+ *        Input ending mid-contact drops that contact and keeps the others.
  */
 void addcontact() {
     clearBuffer();
     int n; char buf[50];
     printf("\t\t\t\tAdd Contacts (enter 0 to cancel) \n");
     printf("\t\t\t\tEnter number of contacts to add: ");
-    scanf("%d", &n); clearInputBuffer();
-    if (n <= 0) { loginPage(); return; }
+    if (!readChoice(&n) || n <= 0) return;
 
-    for (int i = 0; i < n; i++) {
+    int added = 0;
+    for (; added < n; added++) {
         Node *nw = malloc(sizeof *nw);
+        if (!nw) break;
+        bool ok;
         do {
             printf("Name: ");
-            fgets(buf, sizeof buf, stdin);
-            buf[strcspn(buf, "\n")] = '\0';
-        } while (!isvalidname(buf));
-        strcpy(nw->name, buf);
-
-        do {
-            printf("Phone: ");
-            fgets(buf, sizeof buf, stdin);
-            buf[strcspn(buf, "\n")] = '\0';
-        } while (!isvalidnumber(buf) || checkphone(buf));
-        strcpy(nw->phone, buf);
-
-        do {
-            printf("Email: ");
-            fgets(buf, sizeof buf, stdin);
-            buf[strcspn(buf, "\n")] = '\0';
-        } while (!isvalidemail(buf) || checkemail(buf));
+        } while ((ok = readLine(buf, sizeof buf)) && !isvalidname(buf));
+        if (ok) {
+            strcpy(nw->name, buf);
+            do {
+                printf("Phone: ");
+            } while ((ok = readLine(buf, sizeof buf)) && (!isvalidnumber(buf) || checkphone(buf)));
+        }
+        if (ok) {
+            strcpy(nw->phone, buf);
+            do {
+                printf("Email: ");
+            } while ((ok = readLine(buf, sizeof buf)) && (!isvalidemail(buf) || checkemail(buf)));
+        }
+        if (!ok) { // Input ended mid-contact
+            free(nw);
+            break;
+        }
         strcpy(nw->email, buf);
 
         nw->next = head;
         head = nw;
         count++;
     }
+    if (added == 0) return;
 
     clearBuffer();
     printf("\t\t|-------------------------------------------------------------------------| \n");
     printf("\t\t| %-20s | %-15s | %-30s | \n", "Name", "Phone Number", "Email");
     printf("\t\t|-------------------------------------------------------------------------| \n");
     Node *p = head;
-    for (int i = 0; i < n && p; i++, p = p->next)
+    for (int i = 0; i < added && p; i++, p = p->next)
         printf("\t\t| %-20s | %-15s | %-30s  \n", p->name, p->phone, p->email);
 
+    if (sortedBy) { // Move the new nodes from the front to their sorted places
+        Node *fresh = head, *last = head;
+        for (int i = 1; i < added; i++)
+            last = last->next;
+        head = last->next;
+        last->next = NULL;
+        while (fresh) {
+            Node *nx = fresh->next;
+            insertSorted(fresh);
+            fresh = nx;
+        }
+    }
+
     my_pause();
-    loginPage();
+}
+
+#define PAGE_ROWS    25
+#define OUT_BUF_SIZE (1 << 16)
+#define ROW_MAX      192 // Longest rendered row: three 49-char fields plus the frame
+
+static char outBuf[OUT_BUF_SIZE];
+static size_t outLen = 0;
+
+/**
+ * flushOut
+ * ------------------
+ * What: Writes the pending rendered rows to stdout in one fwrite().
+ * Args: none
+ * Returns: void
+ */
+static void flushOut(void) {
+    fwrite(outBuf, 1, outLen, stdout);
+    outLen = 0;
+}
+
+/**
+ * padCell
+ * ------------------
+ * What: Copies a field and pads it with spaces, like "%-Ns" without printf.
+ * Args:
+ *   char *o        – where to write
+ *   const char *s  – the field
+ *   int width      – minimum width; longer fields are not cut
+ * Returns:
+ *   char * – one past the last byte written
+ */
+static char *padCell(char *o, const char *s, int width) {
+    for (; *s; width--)
+        *o++ = *s++;
+    while (width-- > 0)
+        *o++ = ' ';
+    return o;
+}
+
+/**
+ * renderRows
+ * ------------------
+ * What: Formats up to n nodes starting at p as table rows into outBuf.
+ * Args:
+ *   const Node *p – first node to render
+ *   int n         – how many rows at most
+ * Returns: void
+ * Logic: Builds "\t\t| name | phone | email  \n" with padCell(), the same
+ *        bytes the old per-row printf produced, flushing whenever less than
+ *        a row's worth of room is left.
+ */
+static void renderRows(const Node *p, int n) {
+    for (; p && n > 0; p = p->next, n--) {
+        if (OUT_BUF_SIZE - outLen < ROW_MAX)
+            flushOut();
+        char *o = outBuf + outLen;
+        memcpy(o, "\t\t| ", 4);
+        o = padCell(o + 4, p->name, 20);
+        memcpy(o, " | ", 3);
+        o = padCell(o + 3, p->phone, 15);
+        memcpy(o, " | ", 3);
+        o = padCell(o + 3, p->email, 30);
+        memcpy(o, "  \n", 3);
+        outLen = o + 3 - outBuf;
+    }
+}
+
+/**
+ * findLetter
+ * ------------------
+ * What: Finds the first contact whose name starts with a given letter.
+ * Args:
+ *   char letter – the letter, either case
+ * Returns:
+ *   int – its position in the list, or -1 if there is none
+ */
+static int findLetter(char letter) {
+    letter = toupper((unsigned char)letter);
+    int i = 0;
+    for (const Node *p = head; p; p = p->next, i++)
+        if (toupper((unsigned char)p->name[0]) == letter)
+            return i;
+    return -1;
 }
 
 /**
  * displaycontacts
  * ------------------
- * What: Displays all contacts in a table.
+ * What: Displays the contacts one page at a time.
  * Args: none
  * Returns: void
- * Logic: Prints header with total count, then iterates the linked list printing each Node.
+ * Logic: Loops: renders only the visible page through renderRows() and reads
+ *        a pager command:
+ *          Enter – next page (back to the menu after the last one)
+ *          <     – previous page
+ *          N     – page N (0 goes back to the menu)
+ *          A-Z   – page holding the first name starting with that letter
+ *          *     – every contact at once, written in 64 KiB chunks
+ *        A one-page list therefore behaves like the old display-then-pause.
+ *        The first node of each page reached so far is kept in anchors[], so
+ *        moving back or revisiting a page costs no walk from head.
  */
 void displaycontacts() {
-    clearBuffer();
-    printf("\t\t\t\t\t----------------------------- \n");
-    printf("\t\t\t\t\t    >>> Contacts List <<< \n");
-    printf("\t\t\t\t\t----------------------------- \n");
-    printf("\t\t\t\t\t    Total Contacts = %d\n", count);
-    printf("\t\t|-------------------------------------------------------------------------| \n");
-    printf("\t\t| %-20s | %-15s | %-30s | \n", "Name", "Phone Number", "Email");
-    printf("\t\t|-------------------------------------------------------------------------| \n\n");
-    for (Node *p = head; p; p = p->next)
-        printf("\t\t| %-20s | %-15s | %-30s  \n", p->name, p->phone, p->email);
-    my_pause();
-    loginPage();
+    int pages = count > 0 ? (count + PAGE_ROWS - 1) / PAGE_ROWS : 1;
+    int page = 0;
+    const char *note = "";
+    char line[32];
+    const Node **anchors = malloc(pages * sizeof *anchors);
+    int known = 1; // anchors[0, known) hold the first node of those pages
+    if (!anchors) {
+        printf("Memory allocation failed!\n");
+        return;
+    }
+    anchors[0] = head;
+
+    for (;;) {
+        clearBuffer();
+        printf("\t\t\t\t\t----------------------------- \n");
+        printf("\t\t\t\t\t    >>> Contacts List <<< \n");
+        printf("\t\t\t\t\t----------------------------- \n");
+        printf("\t\t\t\t\t    Total Contacts = %d\n", count);
+        printf("\t\t|-------------------------------------------------------------------------| \n");
+        printf("\t\t| %-20s | %-15s | %-30s | \n", "Name", "Phone Number", "Email");
+        printf("\t\t|-------------------------------------------------------------------------| \n\n");
+        while (known <= page) {
+            const Node *p = anchors[known - 1];
+            for (int skip = PAGE_ROWS; p && skip > 0; skip--)
+                p = p->next;
+            anchors[known++] = p;
+        }
+        renderRows(anchors[page], PAGE_ROWS);
+        flushOut();
+        printf("\n\t\t\t\t\t    Page %d of %d %s\n", page + 1, pages, note);
+        printf("\t\t[Enter] next  [<] previous  [N] page N  [A-Z] jump to letter  [*] all  [0] back: ");
+        note = "";
+
+        if (!fgets(line, sizeof line, stdin))
+            break;
+        if (!strchr(line, '\n'))
+            clearInputBuffer();
+
+        if (line[0] == '\n') {
+            if (++page == pages)
+                break;
+        } else if (line[0] == '<') {
+            if (page > 0)
+                page--;
+        } else if (line[0] == '*') {
+            printf("\n\n");
+            renderRows(head, count);
+            flushOut();
+            my_pause();
+            break;
+        } else if (isdigit((unsigned char)line[0])) {
+            int n = atoi(line);
+            if (n == 0)
+                break;
+            if (n <= pages)
+                page = n - 1;
+            else
+                note = "(no such page)";
+        } else if (isalpha((unsigned char)line[0])) {
+            int i = findLetter(line[0]);
+            if (i >= 0)
+                page = i / PAGE_ROWS;
+            else
+                note = "(no name with that letter)";
+        } else {
+            note = "(invalid command)";
+        }
+    }
+    free(anchors);
 }
 
 /**
@@ -267,27 +556,28 @@ void displaycontacts() {
  */
 void searchcontact()
 {
-    clearBuffer();
-    printf("\t\t|---------------------------------------------------------------| \n");
-    printf("\t\t\t\t     >>> Search Contacts <<< \n");
-    printf("\t\t|---------------------------------------------------------------| \n");
-    printf("\n\t\t\t   (Enter 0 to go back to the main menu)\n");
-    printf("\n\t\t\t1. Search by Name");
-    printf("\n\t\t\t2. Search by Phone Number");
-    printf("\n\t\t\t3. Search by Email");
-    printf("\n\n\t\tEnter the search parameter - ");
     int ch;
-    scanf("%d", &ch);
-    clearInputBuffer();
-    if (!ch)                        { loginPage(); return; }
-    if (ch == 1)                    searchByName();
-    else if (ch == 2)               searchByNumber();
-    else if (ch == 3)               searchByEmail();
-    else {
+    for (;;)
+    {
+        clearBuffer();
+        printf("\t\t|---------------------------------------------------------------| \n");
+        printf("\t\t\t\t     >>> Search Contacts <<< \n");
+        printf("\t\t|---------------------------------------------------------------| \n");
+        printf("\n\t\t\t   (Enter 0 to go back to the main menu)\n");
+        printf("\n\t\t\t1. Search by Name");
+        printf("\n\t\t\t2. Search by Phone Number");
+        printf("\n\t\t\t3. Search by Email");
+        printf("\n\n\t\tEnter the search parameter - ");
+        if (!readChoice(&ch) || !ch)
+            return;
+        if (ch >= 1 && ch <= 3)
+            break;
         printf("Invalid\n");
         my_pause();
-        searchcontact();
     }
+    if (ch == 1)      searchByName();
+    else if (ch == 2) searchByNumber();
+    else              searchByEmail();
 }
 
 /**
@@ -306,9 +596,7 @@ void searchByName()
     printf("\t\t\t\t     >>> Search By Name <<< \n");
     printf("\t\t|---------------------------------------------------------------| \n\n");
     char buf[50];
-    fgets(buf, sizeof buf, stdin);
-    buf[strcspn(buf, "\n")] = '\0';
-    if (!strcmp(buf, "0")) { loginPage(); return; }
+    if (!readLine(buf, sizeof buf) || !strcmp(buf, "0")) return;
 
     printf("\t\t|---------------------------------------------------------------| \n");
     printf("\t\t| \tName\t| \tPhone Number\t  |  \t Email\t\t| \n");
@@ -317,7 +605,6 @@ void searchByName()
         if (strstr(p->name, buf))
             printf("\t\t| %-20s | %-15s | %-30s |\n", p->name, p->phone, p->email);
     my_pause();
-    loginPage();
 }
 
 /**
@@ -336,9 +623,7 @@ void searchByNumber()
     printf("\t\t\t\t     >>> Search By Phone Number <<< \n");
     printf("\t\t|---------------------------------------------------------------| \n\n");
     char buf[50];
-    fgets(buf, sizeof buf, stdin);
-    buf[strcspn(buf, "\n")] = '\0';
-    if (!strcmp(buf, "0")) { loginPage(); return; }
+    if (!readLine(buf, sizeof buf) || !strcmp(buf, "0")) return;
 
     printf("\t\t|---------------------------------------------------------------| \n");
     printf("\t\t| \tName\t| \tPhone Number\t  |  \t Email\t\t| \n");
@@ -347,7 +632,6 @@ void searchByNumber()
         if (strstr(p->phone, buf))
             printf("\t\t| %-20s | %-15s | %-30s |\n", p->name, p->phone, p->email);
     my_pause();
-    loginPage();
 }
 
 /**
@@ -366,9 +650,7 @@ void searchByEmail()
     printf("\t\t\t\t     >>> Search By Email <<< \n");
     printf("\t\t|---------------------------------------------------------------| \n\n");
     char buf[50];
-    fgets(buf, sizeof buf, stdin);
-    buf[strcspn(buf, "\n")] = '\0';
-    if (!strcmp(buf, "0")) { loginPage(); return; }
+    if (!readLine(buf, sizeof buf) || !strcmp(buf, "0")) return;
 
     printf("\t\t|---------------------------------------------------------------| \n");
     printf("\t\t| \tName\t| \tPhone Number\t  |  \t Email\t\t| \n");
@@ -377,7 +659,6 @@ void searchByEmail()
         if (strstr(p->email, buf))
             printf("\t\t| %-20s | %-15s | %-30s |\n", p->name, p->phone, p->email);
     my_pause();
-    loginPage();
 }
 
 /**
@@ -391,33 +672,30 @@ void searchByEmail()
  */
 void deletecontact()
 {
-    clearBuffer();
-    printf("\t\t|---------------------------------------------------------------|\n");
-    printf("\t\t\t     >>> Delete a Contact <<<\n");
-    printf("\t\t|---------------------------------------------------------------|\n\n");
-    printf("\t\t   (Enter 0 to go back to the main menu)\n\n");
-    printf("\t\t1. Delete by Name\n");
-    printf("\t\t2. Delete by Phone Number\n");
-    printf("\t\t3. Delete by Email\n\n");
-    printf("\t\tChoose option: ");
-
     int opt;
-    scanf("%d", &opt);
-    clearInputBuffer();
-    if (opt == 0) { loginPage(); return; }
-    if (opt < 1 || opt > 3) {
+    for (;;)
+    {
+        clearBuffer();
+        printf("\t\t|---------------------------------------------------------------|\n");
+        printf("\t\t\t     >>> Delete a Contact <<<\n");
+        printf("\t\t|---------------------------------------------------------------|\n\n");
+        printf("\t\t   (Enter 0 to go back to the main menu)\n\n");
+        printf("\t\t1. Delete by Name\n");
+        printf("\t\t2. Delete by Phone Number\n");
+        printf("\t\t3. Delete by Email\n\n");
+        printf("\t\tChoose option: ");
+        if (!readChoice(&opt) || opt == 0)
+            return;
+        if (opt >= 1 && opt <= 3)
+            break;
         printf("Invalid choice.\n");
         my_pause();
-        deletecontact();
-        return;
     }
 
     char query[50];
     const char *field = (opt == 1 ? "Name" : opt == 2 ? "Phone Number" : "Email");
     printf("\nEnter %s (exact match): ", field);
-    fgets(query, sizeof query, stdin);
-    query[strcspn(query, "\n")] = '\0';
-    if (!strcmp(query, "0")) { loginPage(); return; }
+    if (!readLine(query, sizeof query) || !strcmp(query, "0")) return;
 
     Node *matches[100];
     int mcount = 0;
@@ -433,7 +711,6 @@ void deletecontact()
     if (mcount == 0) {
         printf("\nNo contacts found for %s \"%s\".\n", field, query);
         my_pause();
-        loginPage();
         return;
     }
 
@@ -448,12 +725,10 @@ void deletecontact()
                    matches[i]->email);
         }
         printf("\nEnter the number of the contact to delete: ");
-        scanf("%d", &choice);
-        clearInputBuffer();
+        if (!readChoice(&choice)) return;
         if (choice < 1 || choice > mcount) {
             printf("Invalid selection.\n");
             my_pause();
-            loginPage();
             return;
         }
         choice--;
@@ -472,7 +747,6 @@ void deletecontact()
 
     printf("\nContact deleted successfully!\n");
     my_pause();
-    loginPage();
 }
 
 /**
@@ -490,7 +764,7 @@ void Deleteall()
     printf("\t\t\t\t   >>> DELETE ALL CONTACTS!! <<< \n");
     printf("\t\t|---------------------------------------------------------------| \n\n");
     printf("\t\tAre you sure you want to delete all contacts? (Y/N) - ");
-    char c;
+    char c = 'n';
     scanf(" %c", &c);
     clearInputBuffer();
     if (c == 'Y' || c == 'y') {
@@ -507,7 +781,6 @@ void Deleteall()
         printf("\nOperation Cancelled!\n");
     }
     my_pause();
-    loginPage();
 }
 
 /**
@@ -518,36 +791,34 @@ void Deleteall()
  * Returns: void
  * Logic: Similar to deletecontact(), but after selecting the node,
  *        prompts which field to update, validates input, and applies change.
+ *        If the list is sorted, the node is re-linked at its new place.
  */
 void editcontact()
 {
-    clearBuffer();
-    printf("\t\t|---------------------------------------------------------------|\n");
-    printf("\t\t\t     >>> Edit a Contact <<<\n");
-    printf("\t\t|---------------------------------------------------------------|\n\n");
-    printf("\t\t   (Enter 0 to go back to the main menu)\n\n");
-    printf("\t\t1. Search by Name\n");
-    printf("\t\t2. Search by Phone Number\n");
-    printf("\t\t3. Search by Email\n\n");
-    printf("\t\tChoose option: ");
-
     int opt;
-    scanf("%d", &opt);
-    clearInputBuffer();
-    if (opt == 0) { loginPage(); return; }
-    if (opt < 1 || opt > 3) {
+    for (;;)
+    {
+        clearBuffer();
+        printf("\t\t|---------------------------------------------------------------|\n");
+        printf("\t\t\t     >>> Edit a Contact <<<\n");
+        printf("\t\t|---------------------------------------------------------------|\n\n");
+        printf("\t\t   (Enter 0 to go back to the main menu)\n\n");
+        printf("\t\t1. Search by Name\n");
+        printf("\t\t2. Search by Phone Number\n");
+        printf("\t\t3. Search by Email\n\n");
+        printf("\t\tChoose option: ");
+        if (!readChoice(&opt) || opt == 0)
+            return;
+        if (opt >= 1 && opt <= 3)
+            break;
         printf("Invalid choice.\n");
         my_pause();
-        editcontact();
-        return;
     }
 
     char query[50];
     const char *field = (opt == 1 ? "Name" : opt == 2 ? "Phone Number" : "Email");
     printf("\nEnter %s (exact match): ", field);
-    fgets(query, sizeof query, stdin);
-    query[strcspn(query, "\n")] = '\0';
-    if (!strcmp(query, "0")) { loginPage(); return; }
+    if (!readLine(query, sizeof query) || !strcmp(query, "0")) return;
 
     Node *matches[100];
     int mcount = 0;
@@ -563,7 +834,6 @@ void editcontact()
     if (mcount == 0) {
         printf("\nNo contacts found for %s \"%s\".\n", field, query);
         my_pause();
-        loginPage();
         return;
     }
 
@@ -578,12 +848,10 @@ void editcontact()
                    matches[i]->email);
         }
         printf("\nEnter the number of the contact to edit: ");
-        scanf("%d", &choice);
-        clearInputBuffer();
+        if (!readChoice(&choice)) return;
         if (choice < 1 || choice > mcount) {
             printf("Invalid selection.\n");
             my_pause();
-            loginPage();
             return;
         }
         choice--;
@@ -597,17 +865,14 @@ void editcontact()
     printf(" 1. Name\n 2. Phone Number\n 3. Email\n\n");
     printf("Enter choice: ");
     int field_opt;
-    scanf("%d", &field_opt);
-    clearInputBuffer();
+    if (!readChoice(&field_opt)) return;
 
     char nv[50];
     printf("Enter new value (or 0 to cancel): ");
-    fgets(nv, sizeof nv, stdin);
-    nv[strcspn(nv, "\n")] = '\0';
+    if (!readLine(nv, sizeof nv)) return;
     if (!strcmp(nv, "0")) {
         printf("Edit cancelled.\n");
         my_pause();
-        loginPage();
         return;
     }
 
@@ -626,7 +891,7 @@ void editcontact()
             }
             break;
         case 3:
-            if (isvalidemail(nv) && !checkemail(nv)) {
+            if (isvalidemail(nv) && (engine_fold_equal(nv, target->email) || !checkemail(nv))) { // Own email in a new case is fine
                 strcpy(target->email, nv);
                 valid = true;
             }
@@ -635,6 +900,10 @@ void editcontact()
             printf("Invalid edit choice.\n");
     }
 
+    if (valid && sortedBy) {
+        unlinkNode(target);
+        insertSorted(target);
+    }
     if (valid) {
         printf("\nContact updated to:\n");
         printf("| %-20s | %-15s | %-30s |\n",
@@ -644,108 +913,23 @@ void editcontact()
     }
 
     my_pause();
-    loginPage();
 }
 
 /**
- * cmpName
- * ------------------
- * What: Comparison callback for merge-sort by name.
- * Args:
- *   Node *a, *b – two nodes to compare
- * Returns:
- *   int truth value (a ≤ b)
- * Logic: strcmp(a->name, b->name) ≤ 0.
- */
-static int cmpName(Node *a, Node *b)  { return strcmp(a->name,  b->name)  <= 0; }
-
-/**
- * cmpPhone
- * ------------------
- * What: Comparison callback for merge-sort by phone.
- * Args:
- *   Node *a, *b
- * Returns: int truth value (a ≤ b)
- * Logic: strcmp(a->phone, b->phone) ≤ 0.
- */
-static int cmpPhone(Node *a, Node *b) { return strcmp(a->phone, b->phone) <= 0; }
-
-/**
- * cmpEmail
- * ------------------
- * What: Comparison callback for merge-sort by email.
- * Args:
- *   Node *a, *b
- * Returns: int truth value (a ≤ b)
- * Logic: strcmp(a->email, b->email) ≤ 0.
- */
-static int cmpEmail(Node *a, Node *b) { return strcmp(a->email, b->email) <= 0; }
-
-/**
- * frontBackSplit
+ * sortList
  * ------------------
- * What: Splits a linked list into two halves.
+ * What: Orders the list by one field (ascending) unless it already is.
  * Args:
- *   Node *source – head of original list
- *   Node **frontRef, **backRef – out parameters for two sublists
+ *   int field – 1 name, 2 phone, 3 email
  * Returns: void
- * Logic: Uses fast/slow pointer to find midpoint, breaks link.
- */
-static void frontBackSplit(Node *source, Node **frontRef, Node **backRef) {
-    Node *slow = source, *fast = source->next;
-    while (fast) {
-        fast = fast->next;
-        if (fast) {
-            slow = slow->next;
-            fast = fast->next;
-        }
-    }
-    *frontRef = source;
-    *backRef  = slow->next;
-    slow->next = NULL;
-}
-
-/**
- * sortedMerge
- * ------------------
- * What: Merges two sorted lists using cmp callback.
- * Args:
- *   Node *a, *b – heads of two sorted lists
- *   int (*cmp)(Node*,Node*) – comparison function
- * Returns:
- *   Node* – head of merged sorted list
- * Logic: Recursively picks the smaller head based on cmp.
- */
-static Node *sortedMerge(Node *a, Node *b, int (*cmp)(Node*,Node*)) {
-    if (!a) return b;
-    if (!b) return a;
-    if (cmp(a,b)) {
-        a->next = sortedMerge(a->next, b, cmp);
-        return a;
-    } else {
-        b->next = sortedMerge(a, b->next, cmp);
-        return b;
-    }
-}
-
-/**
- * mergeSort
- * ------------------
- * What: Recursively sorts a linked list via merge sort.
- * Args:
- *   Node *h – head of list to sort
- *   int (*cmp)(Node*,Node*) – comparison function
- * Returns:
- *   Node* – head of sorted list
- * Logic: Base case single/empty; split list; sort halves; merge.
+ * Logic: engine_sort_list(): an LSD radix sort on packed phones, MSD
+ *        radix on cached prefixes for names and emails. Both are stable.
  */
-static Node *mergeSort(Node *h, int (*cmp)(Node*,Node*)) {
-    if (!h || !h->next) return h;
-    Node *a, *b;
-    frontBackSplit(h, &a, &b);
-    a = mergeSort(a, cmp);
-    b = mergeSort(b, cmp);
-    return sortedMerge(a, b, cmp);
+static void sortList(int field) {
+    if (sortedBy != field && count > 1) {
+        head = engine_sort_list(head, count, offsetof(Node, next), fieldOffset(field), 1);
+    }
+    sortedBy = field;
 }
 
 /**
@@ -754,10 +938,10 @@ static Node *mergeSort(Node *h, int (*cmp)(Node*,Node*)) {
  * What: Sorts full list by name (ascending).
  * Args: none
  * Returns: void
- * Logic: Calls mergeSort with cmpName, then displaycontacts().
+ * Logic: sortList(1), then displaycontacts().
  */
 void sortByName() {
-    head = mergeSort(head, cmpName);
+    sortList(1);
     displaycontacts();
 }
 
@@ -767,10 +951,10 @@ void sortByName() {
  * What: Sorts full list by phone number (ascending).
  * Args: none
  * Returns: void
- * Logic: Calls mergeSort with cmpPhone, then displaycontacts().
+ * Logic: sortList(2), then displaycontacts().
  */
 void sortByNumber() {
-    head = mergeSort(head, cmpPhone);
+    sortList(2);
     displaycontacts();
 }
 
@@ -780,10 +964,10 @@ void sortByNumber() {
  * What: Sorts full list by email (ascending).
  * Args: none
  * Returns: void
- * Logic: Calls mergeSort with cmpEmail, then displaycontacts().
+ * Logic: sortList(3), then displaycontacts().
  */
 void sortByEmail() {
-    head = mergeSort(head, cmpEmail);
+    sortList(3);
     displaycontacts();
 }
 
@@ -793,64 +977,83 @@ void sortByEmail() {
  * What: Presents a submenu to choose sort field and then sorts.
  * Args: none
  * Returns: void
- * Logic: Reads choice, calls corresponding sortByX().
+ * Logic: Reads choice until it is valid, calls corresponding sortByX().
  */
 void displaySortedContacts()
 {
-    clearBuffer();
-    printf("\t\t|---------------------------------------------------------------|\n");
-    printf("\t\t\t     >>> Display sorted Contacts <<<\n");
-    printf("\t\t|---------------------------------------------------------------|\n\n");
-    printf("\t\t   (Enter 0 to go back to the main menu)\n\n");
-    printf("\t\t1. Sort by Name\n");
-    printf("\t\t2. Sort by Phone Number\n");
-    printf("\t\t3. Sort by Email\n\n");
-    printf("\t\tChoose option: ");
     int ch;
-    scanf("%d", &ch);
-    clearInputBuffer();
-    if (ch == 1)      sortByName();
-    else if (ch == 2) sortByNumber();
-    else if (ch == 3) sortByEmail();
-    else {
+    for (;;)
+    {
+        clearBuffer();
+        printf("\t\t|---------------------------------------------------------------|\n");
+        printf("\t\t\t     >>> Display sorted Contacts <<<\n");
+        printf("\t\t|---------------------------------------------------------------|\n\n");
+        printf("\t\t   (Enter 0 to go back to the main menu)\n\n");
+        printf("\t\t1. Sort by Name\n");
+        printf("\t\t2. Sort by Phone Number\n");
+        printf("\t\t3. Sort by Email\n\n");
+        printf("\t\tChoose option: ");
+        if (!readChoice(&ch) || !ch)
+            return;
+        if (ch >= 1 && ch <= 3)
+            break;
         printf("Invalid choice!\n");
         my_pause();
-        displaySortedContacts();
     }
+    if (ch == 1)      sortByName();
+    else if (ch == 2) sortByNumber();
+    else              sortByEmail();
 }
 
 /**
- * save
+ * writeContacts
  * ------------------
- * What: Saves all contacts back to "contacts.csv".
- * Args: none
- * Returns: void
- * Logic: Opens CSV for write, iterates list printing each record, closes file,
- *        then asks user whether to exit or return to menu.
+ * What: Writes the list to a CSV file.
+ * Args:
+ *   const char *path – file to overwrite
+ * Returns:
+ *   int – 1 on success, 0 on an I/O error (already reported with perror)
  */
-void save()
+int writeContacts(const char *path)
 {
-    pF = fopen("contacts.csv", "w");
+    pF = fopen(path, "w");
     if (!pF)
     {
         perror("Error");
-        loginPage();
-        return;
+        return 0;
     }
     for (Node *p = head; p; p = p->next)
         fprintf(pF, "%s,%s,%s\n", p->name, p->phone, p->email);
-    fclose(pF);
+    if (ferror(pF) | fclose(pF))
+    {
+        perror("Error");
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * save
+ * ------------------
+ * What: Saves all contacts back to "contacts.csv".
+ * Args: none
+ * Returns: void
+ * Logic: writeContacts("contacts.csv"), then asks user whether to exit or
+ *        return to menu.
+ */
+void save()
+{
+    if (!writeContacts("contacts.csv"))
+        return;
 
     clearBuffer();
     printf("\nContacts saved successfully!\n");
     printf("Enter 0 to go back or y to EXIT - ");
-    char c;
+    char c = '0';
     scanf(" %c", &c);
     clearInputBuffer();
     if (c == 'y' || c == 'Y')
         endScreen();
-    else
-        loginPage();
 }
 
 /**
@@ -859,13 +1062,14 @@ void save()
  * What: Prompts to save before quitting, then exits.
  * Args: none
  * Returns: void
- * Logic: Asks Y/N; if yes calls save(), else calls endScreen().
+ * Logic: Asks Y/N; if yes calls save(), whose own prompt exits or returns
+ *        to the menu, else calls endScreen().
  */
 void Exit()
 {
     clearBuffer();
     printf("Save changes? (Y/N): ");
-    char c;
+    char c = 'n';
     scanf(" %c", &c);
     clearInputBuffer();
     if (c == 'Y' || c == 'y')
@@ -883,26 +1087,11 @@ void Exit()
  *   const char name[] – input string
  * Returns:
  *   int – 1 if valid, 0 otherwise
- * Logic: Iterates each char; if non-letter/non-space found, returns 0.
+ * Logic: engine_valid_name(), shared with every other front end.
  */
 int isvalidname(const char name[])
 {
-    int x = 0;
-    for (int i = 0; name[i] != '\0'; i++)
-    {
-        if ((name[i] >= 'a' && name[i] <= 'z') ||
-            (name[i] >= 'A' && name[i] <= 'Z') ||
-            (name[i] == ' '))
-        {
-            x = 1;
-        }
-        else
-        {
-            x = 0;
-            break;
-        }
-    }
-    return x;
+    return engine_valid_name(name);
 }
 
 /**
@@ -913,56 +1102,27 @@ int isvalidname(const char name[])
  *   const char number[] – input string
  * Returns:
  *   int – 2 if valid, 0 otherwise
- * Logic: Checks strlen == 10, then each char is digit.
+ * Logic: engine_valid_phone().
  */
 int isvalidnumber(const char number[])
 {
-    int length = strlen(number);
-    if (length != 10)
-        return 0;
-    for (int i = 0; i < length; i++)
-        if (number[i] < '0' || number[i] > '9')
-            return 0;
-    return 2;
+    return engine_valid_phone(number) ? 2 : 0;
 }
 
 /**
  * isvalidemail
  * ------------------
- * What: Validates basic email format ending in ".com".
+ * What: Validates an email address ending in ".com".
  * Args:
  *   const char email[] – input string
  * Returns:
- *   int – >=1 for partial, 2 for full (has @ and ends in .com), 0 if invalid
- * Logic: Counts '@' and '.', ensures one of each, checks ".com" suffix.
+ *   int – 2 if valid, 0 otherwise
+ * Logic: engine_valid_email() with ENGINE_EMAIL_DOTCOM: one '@' not first,
+ *        a dotted domain after it, no spaces, and a ".com" ending.
  */
 int isvalidemail(const char email[])
 {
-    int x = 0, spl = 0;
-    for (int i = 0; email[i] != '\0'; i++)
-    {
-        if (email[i] == '@' &&
-            email[i+1] != '\0' &&
-            email[i+1] != '.' &&
-            i != 0 &&
-            email[i-1] != '.')
-        {
-            x = 1;
-        }
-        if (email[i] == '@' || email[i] == '.')
-            spl++;
-        if (email[i] == '.' &&
-            email[i+1] == 'c' &&
-            email[i+2] == 'o' &&
-            email[i+3] == 'm' &&
-            email[i+4] == '\0')
-        {
-            x = 2;
-        }
-    }
-    if (spl != 2)
-        x = 1;
-    return x;
+    return engine_valid_email(email, ENGINE_EMAIL_DOTCOM) ? 2 : 0;
 }
 
 /**
@@ -1004,17 +1164,38 @@ int checkphone(const char *s)
 /**
  * checkemail
  * ------------------
- * What: Checks if an email already exists.
+ * What: Checks if an email already exists, ignoring case.
  * Args:
  *   const char *s – email to search
  * Returns:
  *   int – 1 if found, 0 otherwise
- * Logic: Iterates list and strcmp() to each node’s email.
+ * Logic: Iterates list and engine_fold_equal() to each node’s email.
  */
 int checkemail(const char *s)
 {
     for (Node *p = head; p; p = p->next)
-        if (!strcmp(p->email, s))
+        if (engine_fold_equal(p->email, s))
             return 1;
     return 0;
 }
+
+/**
+ * runCommand
+ * ------------------
+ * What: Runs one headless subcommand instead of the menus.
+ * Args:
+ *   int argc, char *argv[] – the program arguments:
+ *     donna [-f FILE] [--tsv] import CSV | search FIELD TEXT |
+ *           sort FIELD | export | dedupe [FIELD]
+ * Returns:
+ *   int – exit status: 0 ok, 1 I/O or memory error, 2 usage error
+ * Logic: engine_command() on the engine's list backend, the same layout
+ *        as the Node list: loads FILE (default "contacts.csv"), runs the
+ *        command with no prompts or screen clears, and streams records to
+ *        stdout as CSV (TSV with --tsv). search, sort and export only read;
+ *        import and dedupe write FILE back and print the rows they reject
+ *        or remove. Counts go to stderr so stdout stays pure data.
+ */
+int runCommand(int argc, char *argv[]) {
+    return engine_command(&engine_list_backend, argc, argv);
+}
@@ -7,6 +7,8 @@
 #include <unistd.h>
 #include <ctype.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
 // Node for singly linked list of contacts
 typedef struct Node {
     char name[50];
@@ -25,6 +27,9 @@ void infoscreen();
 void endScreen();
 void save();
 void Exit();
+int appendContacts(const char *path);
+int writeContacts(const char *path);
+int runCommand(int argc, char *argv[]);
 
 // CRUD operations
 void addcontact();